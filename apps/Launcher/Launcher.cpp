@@ -41,7 +41,10 @@
 #include "Launcher.h"
 
 #include "tide/core/scene/ContentFactory.h"
+#include "tide/core/thumbnail/ThumbnailIndexer.h"
 #include "tide/core/thumbnail/ThumbnailProvider.h"
+#include "tide/core/thumbnail/ThumbnailStore.h"
+#include "tide/core/thumbnail/thumbnail.h"
 
 #include "tide/master/MasterConfiguration.h"
 #include "tide/master/localstreamer/CommandLineOptions.h"
@@ -55,6 +58,7 @@ namespace
 const std::string deflectHost("localhost");
 const QString deflectQmlFile("qrc:/qml/qml/main.qml");
 const QString thumbnailProviderId("thumbnail");
+const QSize thumbnailSize(512, 512);
 }
 
 Launcher::Launcher(int& argc, char* argv[])
@@ -85,11 +89,26 @@ Launcher::Launcher(int& argc, char* argv[])
     item->setProperty("rootFilesFolder", config.getContentDir());
     item->setProperty("rootSessionsFolder", config.getSessionsDir());
 
+    if (config.getThumbnailStoreSize() > 0)
+    {
+        const auto maxSize =
+            qint64(config.getThumbnailStoreSize()) * 1024 * 1024;
+        thumbnail::setStore(std::make_shared<ThumbnailStore>(
+            config.getThumbnailStoreDir(), maxSize));
+
+        // Prepare the thumbnails of the file browser in the background
+        _thumbnailIndexer.reset(
+            new ThumbnailIndexer(config.getContentDir(), thumbnailSize));
+        _thumbnailIndexer->start();
+    }
+
     QQmlEngine* engine = _qmlStreamer->getQmlEngine();
 #if TIDE_ASYNC_THUMBNAIL_PROVIDER
-    engine->addImageProvider(thumbnailProviderId, new AsyncThumbnailProvider);
+    engine->addImageProvider(thumbnailProviderId,
+                             new AsyncThumbnailProvider(thumbnailSize));
 #else
-    engine->addImageProvider(thumbnailProviderId, new ThumbnailProvider);
+    engine->addImageProvider(thumbnailProviderId,
+                             new ThumbnailProvider(thumbnailSize));
 #endif
     engine->rootContext()->setContextProperty("fileInfo", &_fileInfoHelper);
 
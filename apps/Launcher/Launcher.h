@@ -49,6 +49,8 @@
 
 #include <QGuiApplication>
 
+class ThumbnailIndexer;
+
 /**
  * Separate application which streams the Qml launcher using deflect::Qt API.
  */
@@ -63,6 +65,7 @@ public:
 private:
     std::unique_ptr<deflect::qt::QmlStreamer> _qmlStreamer;
     FileInfoHelper _fileInfoHelper;
+    std::unique_ptr<ThumbnailIndexer> _thumbnailIndexer;
 
     bool event(QEvent* event) final;
 };
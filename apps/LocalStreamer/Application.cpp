@@ -42,6 +42,7 @@
 #include "localstreamer/CommandLineOptions.h"
 #include "localstreamer/PixelStreamer.h"
 #include "localstreamer/PixelStreamerFactory.h"
+#include "localstreamer/StreamSender.h"
 
 #include <QNetworkProxy>
 #include <QTimer>
@@ -49,7 +50,7 @@
 #include <iostream>
 
 #define TIDE_STREAM_HOST_ADDRESS "localhost"
-//#define COMPRESS_IMAGES
+#define MAX_FRAMES_IN_FLIGHT 3
 
 Application::Application(int& argc_, char** argv_)
     : QApplication(argc_, argv_)
@@ -67,6 +68,7 @@ Application::Application(int& argc_, char** argv_)
 
 Application::~Application()
 {
+    _streamSender.reset();
     delete _deflectStream;
     delete _pixelStreamer;
 }
@@ -93,6 +95,9 @@ bool Application::initialize(const CommandLineOptions& options)
         return false;
     }
     _deflectStream->registerForEvents();
+    // Raw pixels are faster to send to the local host than to compress
+    _streamSender.reset(
+        new StreamSender(*_deflectStream, MAX_FRAMES_IN_FLIGHT, false));
 
     // Make sure to quit the application if the connection is closed.
     _deflectStream->setDisconnectedCallback(QApplication::quit);
@@ -105,27 +110,37 @@ bool Application::initialize(const CommandLineOptions& options)
     return true;
 }
 
-void Application::sendImage(QImage image)
+void Application::sendImage(QImage image, const QRegion region)
 {
-#ifdef COMPRESS_IMAGES
-    // QImage Format_RGB32 (0xffRRGGBB) corresponds in fact to
-    // GL_BGRA == deflect::BGRA
-    deflect::ImageWrapper deflectImage((const void*)image.bits(), image.width(),
-                                       image.height(), deflect::BGRA);
-    deflectImage.compressionPolicy = deflect::COMPRESSION_ON;
-#else
     // This conversion is suboptimal, but the only solution until we send the
-    // PixelFormat with the PixelStreamSegment
-    image = image.rgbSwapped();
-    deflect::ImageWrapper deflectImage((const void*)image.bits(), image.width(),
-                                       image.height(), deflect::RGBA);
-    deflectImage.compressionPolicy = deflect::COMPRESSION_OFF;
-#endif
-    const bool success = _deflectStream->sendAndFinish(deflectImage).get();
-    if (!success)
+    // PixelFormat with the PixelStreamSegment. Only the region which changed
+    // is converted, the rest of the frame is kept from the previous one.
+    // The frames still in the send queue share their data with _rgbaImage,
+    // which gets detached (copied) before being modified.
+    if (_rgbaImage.size() != image.size())
+        _rgbaImage = image.convertToFormat(QImage::Format_RGBA8888);
+    else
     {
+        for (const auto& rect : region.rects())
+            _swapRgb(image, rect);
+    }
+
+    if (!_streamSender->send(_rgbaImage))
         QApplication::quit();
-        return;
+}
+
+void Application::_swapRgb(const QImage& image, const QRect& rect)
+{
+    for (int y = rect.top(); y <= rect.bottom(); ++y)
+    {
+        auto src = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+        auto dst = reinterpret_cast<QRgb*>(_rgbaImage.scanLine(y));
+        for (int x = rect.left(); x <= rect.right(); ++x)
+        {
+            const QRgb pixel = src[x];
+            dst[x] = (pixel & 0xff00ff00) | ((pixel & 0x00ff0000) >> 16) |
+                     ((pixel & 0x000000ff) << 16);
+        }
     }
 }
 
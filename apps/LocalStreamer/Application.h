@@ -42,11 +42,15 @@
 
 #include <QApplication>
 #include <QImage>
+#include <QRegion>
 
 #include <deflect/Stream.h>
 
+#include <memory>
+
 class PixelStreamer;
 class CommandLineOptions;
+class StreamSender;
 
 /**
  * Generic application for using PixelStreamers with the deflect::Stream
@@ -77,13 +81,17 @@ public:
     bool initialize(const CommandLineOptions& options);
 
 private slots:
-    void sendImage(QImage image);
+    void sendImage(QImage image, QRegion region);
     void sendData(QByteArray data);
     void processPendingEvents();
 
 private:
     PixelStreamer* _pixelStreamer;
     deflect::Stream* _deflectStream;
+    std::unique_ptr<StreamSender> _streamSender;
+    QImage _rgbaImage;
+
+    void _swapRgb(const QImage& image, const QRect& rect);
 };
 
 #endif
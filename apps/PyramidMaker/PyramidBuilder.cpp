@@ -0,0 +1,193 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "PyramidBuilder.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace
+{
+const QRgb black = 0xff000000;
+
+// Average a block of 2x2 RGB32 pixels, two channels at a time
+inline QRgb _average(const QRgb a, const QRgb b, const QRgb c, const QRgb d)
+{
+    const quint32 mask = 0x00ff00ff;
+    const quint32 rb = (a & mask) + (b & mask) + (c & mask) + (d & mask);
+    const quint32 ag = ((a >> 8) & mask) + ((b >> 8) & mask) +
+                       ((c >> 8) & mask) + ((d >> 8) & mask);
+    return ((rb >> 2) & mask) | (((ag >> 2) & mask) << 8);
+}
+
+/**
+ * Downsample the first rows of a band by a factor of 2.
+ * Odd sizes are rounded up, the last row / column being averaged with itself.
+ */
+QImage _downsample(const QImage& band, const int width, const int rows)
+{
+    QImage half{(width + 1) / 2, (rows + 1) / 2, QImage::Format_RGB32};
+    for (int y = 0; y < half.height(); ++y)
+    {
+        const auto row0 = reinterpret_cast<const QRgb*>(band.scanLine(2 * y));
+        const auto row1 = reinterpret_cast<const QRgb*>(
+            band.scanLine(std::min(2 * y + 1, rows - 1)));
+        auto out = reinterpret_cast<QRgb*>(half.scanLine(y));
+        for (int x = 0; x < half.width(); ++x)
+        {
+            const int x0 = 2 * x;
+            const int x1 = std::min(x0 + 1, width - 1);
+            out[x] = _average(row0[x0], row0[x1], row1[x0], row1[x1]);
+        }
+    }
+    return half;
+}
+}
+
+PyramidBuilder::PyramidBuilder(TiffPyramidWriter& writer, const int quality)
+    : _writer(writer)
+    , _quality{quality}
+    , _tileSize{writer.getTileSize()}
+{
+    for (uint lod = 0; lod <= _writer.getTopPyramidLevel(); ++lod)
+    {
+        Level level;
+        level.lod = lod;
+        level.size = _writer.getLevelSize(lod);
+        level.tilesCount = _writer.getTilesCount(lod);
+        level.band = QImage{level.tilesCount.width() * _tileSize, _tileSize,
+                            QImage::Format_RGB32};
+        level.band.fill(black);
+        _levels.push_back(std::move(level));
+    }
+    _writer.startLevel(0);
+}
+
+void PyramidBuilder::addRows(const QImage& rows)
+{
+    _addRows(_levels[0], rows.convertToFormat(QImage::Format_RGB32));
+}
+
+void PyramidBuilder::finish()
+{
+    for (auto& level : _levels)
+    {
+        if (level.bandRows > 0)
+            _flushBand(level);
+    }
+
+    for (auto& level : _levels)
+    {
+        if (level.lod == 0)
+            continue;
+
+        _writer.startLevel(level.lod);
+        for (const auto& tile : level.tiles)
+        {
+            const int i = tile.first % level.tilesCount.width();
+            const int j = tile.first / level.tilesCount.width();
+            _writer.writeTile(i, j, tile.second);
+        }
+        level.tiles.clear();
+    }
+}
+
+void PyramidBuilder::_addRows(Level& level, const QImage& rows)
+{
+    const int width = std::min(rows.width(), level.size.width());
+    const int height =
+        std::min(rows.height(), level.size.height() - level.receivedRows);
+
+    for (int y = 0; y < height; ++y)
+    {
+        std::memcpy(level.band.scanLine(level.bandRows), rows.scanLine(y),
+                    width * sizeof(QRgb));
+        ++level.receivedRows;
+        if (++level.bandRows == _tileSize)
+            _flushBand(level);
+    }
+}
+
+void PyramidBuilder::_flushBand(Level& level)
+{
+    // Pad the last row of tiles
+    for (int y = level.bandRows; y < _tileSize; ++y)
+        std::fill_n(reinterpret_cast<QRgb*>(level.band.scanLine(y)),
+                    level.band.width(), black);
+
+    QVector<QImage> tiles;
+    for (int i = 0; i < level.tilesCount.width(); ++i)
+    {
+        const QRect tile{i * _tileSize, 0, _tileSize, _tileSize};
+        tiles.push_back(level.band.copy(tile));
+    }
+
+    const auto quality = _quality;
+    std::function<QByteArray(const QImage&)> encode =
+        [quality](const QImage& tile) {
+            return TiffPyramidWriter::encodeTile(tile, quality);
+        };
+    auto future = QtConcurrent::mapped(tiles, encode);
+
+    // Build the level above while the tiles are being compressed
+    if (level.lod < _levels.back().lod)
+    {
+        const auto half =
+            _downsample(level.band, level.size.width(), level.bandRows);
+        _addRows(_levels[level.lod + 1], half);
+    }
+
+    future.waitForFinished();
+    for (int i = 0; i < tiles.size(); ++i)
+    {
+        if (level.lod == 0)
+            _writer.writeTile(i, level.tilesRow, future.resultAt(i));
+        else
+        {
+            const int index = level.tilesRow * level.tilesCount.width() + i;
+            level.tiles[index] = future.resultAt(i);
+        }
+    }
+    level.bandRows = 0;
+    ++level.tilesRow;
+}
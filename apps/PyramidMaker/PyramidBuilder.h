@@ -0,0 +1,97 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef PYRAMIDBUILDER_H
+#define PYRAMIDBUILDER_H
+
+#include "data/TiffPyramidWriter.h"
+
+#include <QImage>
+#include <map>
+#include <vector>
+
+/**
+ * Build a TIFF image pyramid from an image streamed in horizontal strips.
+ *
+ * Each level of the pyramid accumulates one row of tiles at a time. When a
+ * row is complete, its tiles are compressed in parallel while the row is
+ * downsampled into the level above. The memory usage is thus bounded by one
+ * row of tiles per level, plus the compressed tiles of the upper levels which
+ * are written to the file after the full resolution level.
+ */
+class PyramidBuilder
+{
+public:
+    /**
+     * Create a pyramid builder.
+     * @param writer the file to write the pyramid to
+     * @param quality the JPEG quality of the tiles [1-100]
+     */
+    PyramidBuilder(TiffPyramidWriter& writer, int quality);
+
+    /** Add the next rows of the full resolution image (top to bottom). */
+    void addRows(const QImage& rows);
+
+    /** Flush the remaining rows and write the upper levels to the file. */
+    void finish();
+
+private:
+    struct Level
+    {
+        uint lod;
+        QSize size;
+        QSize tilesCount;
+        QImage band;
+        int bandRows = 0;
+        int receivedRows = 0;
+        int tilesRow = 0;
+        std::map<int, QByteArray> tiles;
+    };
+
+    TiffPyramidWriter& _writer;
+    const int _quality;
+    const int _tileSize;
+    std::vector<Level> _levels;
+
+    void _addRows(Level& level, const QImage& rows);
+    void _flushBand(Level& level);
+};
+
+#endif
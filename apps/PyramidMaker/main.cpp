@@ -0,0 +1,276 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "CommandLineParser.h"
+#include "log.h"
+
+#include "PyramidBuilder.h"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QThreadPool>
+
+#include <tiffio.h>
+
+#include <chrono>
+#include <iostream>
+
+// Example way to run this program:
+// ./tidePyramidMaker /path/to/large_image.tif /path/to/pyramid.tiff
+//
+// TIFF sources are decoded in strips, so that images much larger than the
+// available memory can be converted. Other image formats are decoded at once.
+
+namespace
+{
+const int stripHeight = 512;
+
+namespace po = boost::program_options;
+
+class PyramidMakerOptions : public CommandLineParser
+{
+public:
+    PyramidMakerOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("source", po::value<std::string>()->required(),
+             "the source image to convert")
+            ("target", po::value<std::string>()->required(),
+             "the target .tiff image pyramid file to create")
+            ("tilesize", po::value<int>()->default_value( 512 ),
+             "size of the tiles [pixels]")
+            ("quality", po::value<int>()->default_value( 90 ),
+             "JPEG quality of the tiles [1-100]")
+            ("threads", po::value<int>()->default_value( 0 ),
+             "number of encoding threads (default: all cores)")
+        ;
+        // clang-format on
+    }
+
+    void parse(const int argc, char** argv) final
+    {
+        po::positional_options_description positional;
+        positional.add("source", 1).add("target", 1);
+        try
+        {
+            po::store(po::command_line_parser(argc, argv)
+                          .options(desc)
+                          .positional(positional)
+                          .run(),
+                      vm);
+            po::notify(vm);
+        }
+        catch (const po::required_option&)
+        {
+            // ignore missing required argument when --help is given
+            if (!vm.count("help"))
+                throw;
+        }
+    }
+
+    void showSyntax(const std::string& appName) const final
+    {
+        std::cout << "Usage: " << appName << " source target [OPTIONS...]\n\n";
+        std::cout << desc;
+    }
+
+    QString source() const
+    {
+        return QString::fromStdString(vm["source"].as<std::string>());
+    }
+    QString target() const
+    {
+        return QString::fromStdString(vm["target"].as<std::string>());
+    }
+    int tileSize() const { return vm["tilesize"].as<int>(); }
+    int quality() const { return vm["quality"].as<int>(); }
+    int threads() const { return vm["threads"].as<int>(); }
+};
+
+struct TIFFDeleter
+{
+    void operator()(TIFF* file) { TIFFClose(file); }
+};
+typedef std::unique_ptr<TIFF, TIFFDeleter> TIFFPtr;
+
+struct TIFFRGBAImageDeleter
+{
+    void operator()(TIFFRGBAImage* image) { TIFFRGBAImageEnd(image); }
+};
+
+/** Image source which provides the image in strips from top to bottom. */
+class StripReader
+{
+public:
+    virtual ~StripReader() = default;
+    virtual QSize getSize() const = 0;
+    virtual QImage read(int y, int rows) = 0;
+};
+
+class TiffStripReader : public StripReader
+{
+public:
+    TiffStripReader(const QString& uri)
+        : _tif{TIFFOpen(uri.toLocal8Bit().constData(), "r")}
+    {
+        char error[1024];
+        if (!_tif || !TIFFRGBAImageOK(_tif.get(), error))
+            throw std::runtime_error("unsupported tiff image");
+
+        if (!TIFFRGBAImageBegin(&_image, _tif.get(), 0, error))
+            throw std::runtime_error(error);
+        _imageGuard.reset(&_image);
+        _image.req_orientation = ORIENTATION_TOPLEFT;
+    }
+
+    QSize getSize() const final
+    {
+        return QSize(_image.width, _image.height);
+    }
+
+    QImage read(const int y, const int rows) final
+    {
+        // TIFFRGBAImage packs pixels as ABGR, i.e. RGBA bytes in memory
+        QImage strip{int(_image.width), rows, QImage::Format_RGBA8888};
+        _image.row_offset = y;
+        _image.col_offset = 0;
+        auto raster = reinterpret_cast<uint32*>(strip.bits());
+        if (!TIFFRGBAImageGet(&_image, raster, _image.width, rows))
+            throw std::runtime_error("could not decode tiff image");
+        return strip;
+    }
+
+private:
+    TIFFPtr _tif;
+    TIFFRGBAImage _image;
+    std::unique_ptr<TIFFRGBAImage, TIFFRGBAImageDeleter> _imageGuard;
+};
+
+class QImageStripReader : public StripReader
+{
+public:
+    QImageStripReader(const QString& uri)
+    {
+        QImageReader reader{uri};
+        if (!reader.read(&_image))
+            throw std::runtime_error(reader.errorString().toStdString());
+    }
+
+    QSize getSize() const final { return _image.size(); }
+    QImage read(const int y, const int rows) final
+    {
+        return _image.copy(0, y, _image.width(), rows);
+    }
+
+private:
+    QImage _image;
+};
+
+std::unique_ptr<StripReader> _createReader(const QString& uri)
+{
+    const auto suffix = QFileInfo{uri}.suffix().toLower();
+    if (suffix == "tif" || suffix == "tiff")
+        return std::unique_ptr<StripReader>{new TiffStripReader{uri}};
+    return std::unique_ptr<StripReader>{new QImageStripReader{uri}};
+}
+
+float _elapsed(const std::chrono::high_resolution_clock::time_point& start)
+{
+    const auto now = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<float>{now - start}.count();
+}
+}
+
+/**
+ * Convert an image to a TIFF image pyramid for Tide.
+ */
+int main(int argc, char* argv[])
+{
+    COMMAND_LINE_PARSER_CHECK(PyramidMakerOptions, "tidePyramidMaker");
+
+    QCoreApplication app(argc, argv);
+
+    if (commandLine.tileSize() <= 0 || commandLine.tileSize() % 16)
+    {
+        put_flog(LOG_FATAL, "tile size must be a multiple of 16");
+        return EXIT_FAILURE;
+    }
+    if (commandLine.threads() > 0)
+        QThreadPool::globalInstance()->setMaxThreadCount(commandLine.threads());
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    QSize size;
+    try
+    {
+        auto reader = _createReader(commandLine.source());
+        size = reader->getSize();
+
+        TiffPyramidWriter writer{commandLine.target(), size,
+                                 commandLine.tileSize()};
+        PyramidBuilder builder{writer, commandLine.quality()};
+
+        std::cout << "Converting " << size.width() << "x" << size.height()
+                  << " image, " << writer.getTopPyramidLevel() + 1
+                  << " levels" << std::endl;
+
+        for (int y = 0; y < size.height(); y += stripHeight)
+        {
+            const int rows = std::min(stripHeight, size.height() - y);
+            builder.addRows(reader->read(y, rows));
+            std::cout << "\r" << 100 * (y + rows) / size.height() << "%"
+                      << std::flush;
+        }
+        builder.finish();
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cout << std::endl;
+        put_flog(LOG_FATAL, "failed to create pyramid: %s", e.what());
+        return EXIT_FAILURE;
+    }
+
+    const auto time = _elapsed(start);
+    const auto megapixels = float(size.width()) * size.height() / 1e6;
+    std::cout << "\nDone in " << time << " s (" << megapixels / time
+              << " MP/s)" << std::endl;
+    return EXIT_SUCCESS;
+}
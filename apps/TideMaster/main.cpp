@@ -42,6 +42,7 @@
 #include "log.h"
 
 #include "CommandLineParameters.h"
+#include "FrameTracer.h"
 #include "MasterApplication.h"
 #include "network/MPIChannel.h"
 
@@ -60,6 +61,12 @@ int main(int argc, char* argv[])
     // Load virtualkeyboard input context plugin
     qputenv("QT_IM_MODULE", QByteArray("virtualkeyboard"));
 
+    MPIChannel::setWaitPolicy(commandLine.getMPIWaitPolicy());
+
+    const auto traceFile = commandLine.getTraceFilename();
+    if (!traceFile.isEmpty())
+        FrameTracer::instance().enableChromeTrace(traceFile + ".master.json");
+
     {
         MPIChannelPtr worldChannel(new MPIChannel(argc, argv));
         if (worldChannel->getSize() < 2)
@@ -103,6 +110,7 @@ int main(int argc, char* argv[])
         put_flog(LOG_DEBUG, "waiting for threads to finish...");
         QThreadPool::globalInstance()->waitForDone();
     }
+    FrameTracer::instance().writeChromeTrace();
     put_flog(LOG_DEBUG, "done.");
     return EXIT_SUCCESS;
 }
@@ -40,6 +40,7 @@
 /*********************************************************************/
 
 #include "CommandLineParameters.h"
+#include "FrameTracer.h"
 #include "WallApplication.h"
 #include "WallConfiguration.h"
 #include "log.h"
@@ -57,6 +58,8 @@ int main(int argc, char* argv[])
     // Load virtualkeyboard input context plugin
     qputenv("QT_IM_MODULE", QByteArray("virtualkeyboard"));
 
+    MPIChannel::setWaitPolicy(commandLine.getMPIWaitPolicy());
+
     {
         MPIChannelPtr worldChannel(new MPIChannel(argc, argv));
         if (worldChannel->getSize() < 2)
@@ -71,6 +74,13 @@ int main(int argc, char* argv[])
         logger_id = QString("wall%1").arg(rank).toStdString();
         qInstallMessageHandler(qtMessageLogger);
 
+        const auto traceFile = commandLine.getTraceFilename();
+        if (!traceFile.isEmpty())
+        {
+            FrameTracer::instance().enableChromeTrace(
+                QString("%1.%2.json").arg(traceFile, logger_id.c_str()));
+        }
+
         MPIChannelPtr localChannel(new MPIChannel(*worldChannel, 1, rank));
         MPIChannelPtr mainChannel(new MPIChannel(*worldChannel, 1, rank));
 
@@ -98,6 +108,7 @@ int main(int argc, char* argv[])
         put_flog(LOG_DEBUG, "waiting for threads to finish...");
         QThreadPool::globalInstance()->waitForDone();
     }
+    FrameTracer::instance().writeChromeTrace();
     put_flog(LOG_DEBUG, "done.");
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,99 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE CommandLineParameters
+#include <boost/test/unit_test.hpp>
+
+#include "CommandLineParameters.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+void parse(CommandLineParameters& parameters, std::vector<std::string> args)
+{
+    args.insert(args.begin(), "/test/program");
+    std::vector<char*> argv;
+    for (auto& arg : args)
+        argv.push_back(&arg[0]);
+    parameters.parse(argv.size(), argv.data());
+}
+}
+
+BOOST_AUTO_TEST_CASE(testDefaultMPIWaitPolicyOnlySleeps)
+{
+    CommandLineParameters parameters;
+    parse(parameters, {"--config", "wall.xml"});
+
+    const auto policy = parameters.getMPIWaitPolicy();
+    BOOST_CHECK_EQUAL(policy.spinTime, 0u);
+    BOOST_CHECK_EQUAL(policy.yieldTime, 0u);
+    BOOST_CHECK_EQUAL(policy.maxSleepTime, 100u);
+    BOOST_CHECK(!policy.adaptive);
+}
+
+BOOST_AUTO_TEST_CASE(testMPIWaitPolicyFromCommandLine)
+{
+    CommandLineParameters parameters;
+    parse(parameters, {"--config", "wall.xml", "--mpispin", "50", "--mpiyield",
+                       "200", "--mpiadaptive"});
+
+    BOOST_CHECK_EQUAL(parameters.getConfigFilename().toStdString(), "wall.xml");
+    const auto policy = parameters.getMPIWaitPolicy();
+    BOOST_CHECK_EQUAL(policy.spinTime, 50u);
+    BOOST_CHECK_EQUAL(policy.yieldTime, 200u);
+    BOOST_CHECK(policy.adaptive);
+}
+
+BOOST_AUTO_TEST_CASE(testTracingIsDisabledByDefault)
+{
+    CommandLineParameters parameters;
+    parse(parameters, {"--config", "wall.xml"});
+    BOOST_CHECK(parameters.getTraceFilename().isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(testTraceFilenameFromCommandLine)
+{
+    CommandLineParameters parameters;
+    parse(parameters, {"--config", "wall.xml", "--tracefile", "/tmp/trace"});
+    BOOST_CHECK_EQUAL(parameters.getTraceFilename().toStdString(),
+                      "/tmp/trace");
+}
@@ -60,7 +60,12 @@
 #define CONFIG_EXPECTED_SERIAL_PORT "/dev/ttyS0"
 #define CONFIG_EXPECTED_PLANAR_TIMEOUT 45
 #define CONFIG_EXPECTED_DEFAULT_PLANAR_TIMEOUT 60
+#define CONFIG_EXPECTED_MAX_UPDATE_RATE 30
+#define CONFIG_EXPECTED_DEFAULT_MAX_UPDATE_RATE 60
 #define CONFIG_EXPECTED_SESSIONS_DIR "/nfs4/bbp.epfl.ch/visualization/DisplayWall/sessions"
+#define CONFIG_EXPECTED_THUMBNAIL_STORE_DIR "/var/cache/tide/thumbnails"
+#define CONFIG_EXPECTED_THUMBNAIL_STORE_SIZE 128
+#define CONFIG_EXPECTED_DEFAULT_THUMBNAIL_STORE_SIZE 512
 #define CONFIG_EXPECTED_LAUNCHER_DISPLAY ":0"
 #define CONFIG_EXPECTED_DEMO_SERVICE_URL "https://visualization-dev.humanbrainproject.eu/viz/rendering-resource-manager/v1"
 #define CONFIG_EXPECTED_DEMO_SERVICE_IMAGE_DIR "/nfs4/bbp.epfl.ch/visualization/resources/software/displaywall/demo_previews"
@@ -102,6 +107,9 @@ BOOST_AUTO_TEST_CASE(test_configuration_default_values)
 
     BOOST_CHECK_THROW(config.getScreenRect({0, 0}), std::invalid_argument);
 
+    BOOST_CHECK_EQUAL(config.getWallProcessCount(), 0);
+    BOOST_CHECK(config.getWallProcessScreens(1).empty());
+
     BOOST_CHECK_EQUAL(config.getFullscreen(), false);
     BOOST_CHECK_EQUAL((int)config.getSwapSync(), (int)SwapSync::software);
 }
@@ -142,6 +150,14 @@ BOOST_AUTO_TEST_CASE(test_configuration_all_values)
     BOOST_CHECK_EQUAL(VectorialContent::getMaxScale(), 8.0);
 
     BOOST_CHECK_EQUAL((int)config.getSwapSync(), (int)SwapSync::hardware);
+
+    BOOST_REQUIRE_EQUAL(config.getWallProcessCount(), 6);
+    BOOST_CHECK(config.getWallProcessScreens(0).empty());
+    BOOST_CHECK(config.getWallProcessScreens(7).empty());
+
+    const auto screens = config.getWallProcessScreens(5);
+    BOOST_REQUIRE_EQUAL(screens.size(), 1);
+    BOOST_CHECK_EQUAL(screens[0], QRect(3854, 1092, 3840, 1080));
 }
 
 BOOST_AUTO_TEST_CASE(test_wall_configuration)
@@ -152,6 +168,10 @@ BOOST_AUTO_TEST_CASE(test_wall_configuration)
 
     BOOST_CHECK_EQUAL(config.getHost(), "bbplxviz03i");
     BOOST_CHECK_EQUAL(config.getProcessCountForHost(), 3);
+    BOOST_CHECK_EQUAL(config.getTileCacheSize(), 2048);
+    BOOST_CHECK_EQUAL(config.getPboRingSize(), 256);
+    BOOST_CHECK_EQUAL(config.getDiskTileCacheDir(), "/var/cache/tide/tiles");
+    BOOST_CHECK_EQUAL(config.getDiskTileCacheSize(), 4096);
 
     const auto& screens = config.getScreens();
     BOOST_REQUIRE_EQUAL(screens.size(), 1);
@@ -183,6 +203,10 @@ BOOST_AUTO_TEST_CASE(test_stereo_configuration)
     BOOST_REQUIRE_EQUAL(configLeft.getProcessIndex(), processIndexLeft);
     BOOST_CHECK_EQUAL(configLeft.getHost(), "localhost");
     BOOST_CHECK_EQUAL(configLeft.getProcessCountForHost(), 4);
+    BOOST_CHECK_EQUAL(configLeft.getTileCacheSize(), 1024);
+    BOOST_CHECK_EQUAL(configLeft.getPboRingSize(), 0);
+    BOOST_CHECK(!configLeft.getDiskTileCacheDir().isEmpty());
+    BOOST_CHECK_EQUAL(configLeft.getDiskTileCacheSize(), 8192);
 
     BOOST_REQUIRE_EQUAL(configLeft.getScreens().size(), 1);
     const auto& screenLeft = configLeft.getScreens().at(0);
@@ -212,6 +236,8 @@ BOOST_AUTO_TEST_CASE(test_master_configuration)
     MasterConfiguration config(CONFIG_TEST_FILENAME);
 
     BOOST_CHECK_EQUAL(config.getHeadless(), true);
+    BOOST_CHECK_EQUAL(config.getMaxUpdateRate(),
+                      CONFIG_EXPECTED_MAX_UPDATE_RATE);
 
     BOOST_CHECK_EQUAL(config.getPlanarSerialPort(),
                       CONFIG_EXPECTED_SERIAL_PORT);
@@ -221,6 +247,10 @@ BOOST_AUTO_TEST_CASE(test_master_configuration)
 
     BOOST_CHECK_EQUAL(config.getContentDir(), CONFIG_EXPECTED_CONTENT_DIR);
     BOOST_CHECK_EQUAL(config.getSessionsDir(), CONFIG_EXPECTED_SESSIONS_DIR);
+    BOOST_CHECK_EQUAL(config.getThumbnailStoreDir(),
+                      CONFIG_EXPECTED_THUMBNAIL_STORE_DIR);
+    BOOST_CHECK_EQUAL(config.getThumbnailStoreSize(),
+                      CONFIG_EXPECTED_THUMBNAIL_STORE_SIZE);
 
     BOOST_CHECK_EQUAL(config.getLauncherDisplay(),
                       CONFIG_EXPECTED_LAUNCHER_DISPLAY);
@@ -248,8 +278,13 @@ BOOST_AUTO_TEST_CASE(test_master_configuration_default_values)
     MasterConfiguration config(CONFIG_TEST_FILENAME_II);
 
     BOOST_CHECK_EQUAL(config.getHeadless(), false);
+    BOOST_CHECK_EQUAL(config.getMaxUpdateRate(),
+                      CONFIG_EXPECTED_DEFAULT_MAX_UPDATE_RATE);
     BOOST_CHECK_EQUAL(config.getContentDir(), QDir::homePath());
     BOOST_CHECK_EQUAL(config.getSessionsDir(), QDir::homePath());
+    BOOST_CHECK(!config.getThumbnailStoreDir().isEmpty());
+    BOOST_CHECK_EQUAL(config.getThumbnailStoreSize(),
+                      CONFIG_EXPECTED_DEFAULT_THUMBNAIL_STORE_SIZE);
     BOOST_CHECK_EQUAL(config.getWebServicePort(),
                       CONFIG_EXPECTED_DEFAULT_WEBSERVICE_PORT);
     BOOST_CHECK_EQUAL(config.getWebBrowserDefaultURL(),
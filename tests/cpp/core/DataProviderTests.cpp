@@ -0,0 +1,172 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE DataProviderTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "MinimalGlobalQtApp.h"
+
+#include "ContentSynchronizer.h"
+#include "DataProvider.h"
+#include "FrameSync.h"
+#include "scene/ContentFactory.h"
+#include "scene/ContentWindow.h"
+#include "scene/DisplayGroup.h"
+
+#include <deflect/Frame.h>
+
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+namespace
+{
+const QString STREAM_URI("testStream");
+using Values = std::vector<int64_t>;
+
+// Simulate the collective operation of two wall processes
+void synchronize(DataProvider& process1, DataProvider& process2)
+{
+    FrameSync frameSync1;
+    FrameSync frameSync2;
+    process1.synchronizeTilesSwap(frameSync1);
+    process2.synchronizeTilesSwap(frameSync2);
+    BOOST_REQUIRE_EQUAL(frameSync1.size(), frameSync2.size());
+
+    frameSync1.resolve([&frameSync2](const Values& values1) {
+        Values result(values1.size());
+        frameSync2.resolve([&values1, &result](const Values& values2) {
+            for (size_t i = 0; i < values1.size(); ++i)
+                result[i] = std::min(values1[i], values2[i]);
+            return result;
+        });
+        return result;
+    });
+}
+
+deflect::FramePtr makeFrame()
+{
+    auto frame = std::make_shared<deflect::Frame>();
+    frame->uri = STREAM_URI;
+    return frame;
+}
+}
+
+struct Fixture
+{
+    DisplayGroupPtr group{new DisplayGroup(QSize(2000, 1000))};
+    ContentWindowPtr window{boost::make_shared<ContentWindow>(
+        ContentFactory::getPixelStreamContent(STREAM_URI))};
+
+    // The stream window is only visible on the screens of the first process
+    DataProvider showingProcess;
+    DataProvider hidingProcess;
+    std::unique_ptr<ContentSynchronizer> synchronizer;
+
+    std::vector<QString> frameRequests;
+
+    Fixture()
+    {
+        group->addContentWindow(window);
+
+        // Only the first wall process forwards the requests to the master
+        QObject::connect(&hidingProcess, &DataProvider::requestFrame,
+                         [this](const QString uri) {
+                             frameRequests.push_back(uri);
+                         });
+
+        showingProcess.updateDataSources(*group);
+        hidingProcess.updateDataSources(*group);
+        synchronizer = showingProcess.createSynchronizer(*window,
+                                                         deflect::View::mono);
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(testHiddenStreamIsSynchronizedByAllProcesses, Fixture)
+{
+    FrameSync showing;
+    FrameSync hiding;
+    showingProcess.synchronizeTilesSwap(showing);
+    hidingProcess.synchronizeTilesSwap(hiding);
+
+    BOOST_CHECK_EQUAL(showing.size(), 2u);
+    BOOST_CHECK_EQUAL(hiding.size(), showing.size());
+
+    // Updates of the group and of the window visibility change nothing
+    synchronizer.reset();
+    showingProcess.updateDataSources(*group);
+    FrameSync showingAfterHide;
+    showingProcess.synchronizeTilesSwap(showingAfterHide);
+    BOOST_CHECK_EQUAL(showingAfterHide.size(), 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(testHiddenStreamRequestsFrames, Fixture)
+{
+    BOOST_REQUIRE_EQUAL(frameRequests.size(), 1u);
+    BOOST_CHECK_EQUAL(frameRequests[0].toStdString(),
+                      STREAM_URI.toStdString());
+
+    const auto frame = makeFrame();
+    showingProcess.setNewFrame(frame);
+    hidingProcess.setNewFrame(frame);
+    synchronize(showingProcess, hidingProcess);
+
+    BOOST_REQUIRE_EQUAL(frameRequests.size(), 2u);
+    BOOST_CHECK_EQUAL(frameRequests[1].toStdString(),
+                      STREAM_URI.toStdString());
+}
+
+BOOST_FIXTURE_TEST_CASE(testClosedStreamIsRemovedFromAllProcesses, Fixture)
+{
+    group->removeContentWindow(window);
+    showingProcess.updateDataSources(*group);
+    hidingProcess.updateDataSources(*group);
+
+    FrameSync showing;
+    FrameSync hiding;
+    showingProcess.synchronizeTilesSwap(showing);
+    hidingProcess.synchronizeTilesSwap(hiding);
+    BOOST_CHECK_EQUAL(showing.size(), 0u);
+    BOOST_CHECK_EQUAL(hiding.size(), 0u);
+
+    // Frames still in flight for the closed stream are ignored
+    hidingProcess.setNewFrame(makeFrame());
+    synchronize(showingProcess, hidingProcess);
+    BOOST_CHECK_EQUAL(frameRequests.size(), 1u);
+}
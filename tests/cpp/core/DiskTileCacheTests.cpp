@@ -0,0 +1,184 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE DiskTileCacheTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "DiskTileCache.h"
+#include "fileCache.h"
+
+#include "MinimalGlobalQtApp.h"
+#include "imageFiles.h"
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+#include <QDateTime>
+#include <QDir>
+#include <QTemporaryDir>
+
+#include <utime.h>
+
+namespace
+{
+const QSize tileSize{64, 64};
+const qint64 unlimited = 1 << 30;
+
+void setLastUsed(const QString& path, const int secondsAgo)
+{
+    const auto time = QDateTime::currentDateTime().addSecs(-secondsAgo);
+    const utimbuf times{time.toTime_t(), time.toTime_t()};
+    BOOST_REQUIRE_EQUAL(::utime(path.toLocal8Bit().constData(), &times), 0);
+}
+
+struct Fixture : ImageFilesFixture
+{
+    QTemporaryDir cacheDir;
+    const QImage tile = makeImage(tileSize, 7);
+
+    DiskTileCache::Settings getSettings(const qint64 maxSize = unlimited)
+    {
+        return DiskTileCache::Settings{cacheDir.path(), maxSize};
+    }
+
+    QString getFolder(const QString& filename) const
+    {
+        return cacheDir.path() + '/' + fileCache::getKey(filename);
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testStoredTileIsReturned, Fixture)
+{
+    const auto file = createFile("image.png");
+
+    DiskTileCache cache{file, getSettings()};
+    BOOST_CHECK(cache.load(0).isNull());
+
+    BOOST_REQUIRE(cache.save(0, tile));
+    BOOST_CHECK(cache.load(0) == tile);
+    BOOST_CHECK(cache.load(1).isNull());
+}
+
+BOOST_FIXTURE_TEST_CASE(testModifiedImageIsNotServedOldTiles, Fixture)
+{
+    const auto file = createFile("image.png");
+    {
+        DiskTileCache cache{file, getSettings()};
+        BOOST_REQUIRE(cache.save(0, tile));
+    }
+
+    createFile("image.png", QSize(256, 128));
+    DiskTileCache cache{file, getSettings()};
+    BOOST_CHECK(cache.load(0).isNull());
+}
+
+BOOST_FIXTURE_TEST_CASE(testTilesPersistAcrossSessions, Fixture)
+{
+    const auto file = createFile("image.png");
+    {
+        DiskTileCache cache{file, getSettings()};
+        BOOST_REQUIRE(cache.save(0, tile));
+    }
+
+    DiskTileCache cache{file, getSettings()};
+    BOOST_CHECK(cache.load(0) == tile);
+}
+
+BOOST_FIXTURE_TEST_CASE(testLeastRecentlyUsedImagesAreEvicted, Fixture)
+{
+    const auto file1 = createFile("image1.png");
+    const auto file2 = createFile("image2.png");
+    const auto file3 = createFile("image3.png");
+
+    qint64 tilesSize = 0;
+    {
+        DiskTileCache cache1{file1, getSettings()};
+        BOOST_REQUIRE(cache1.save(0, tile));
+        tilesSize = QFileInfo{getFolder(file1) + "/0.png"}.size();
+
+        DiskTileCache cache2{file2, getSettings()};
+        BOOST_REQUIRE(cache2.save(0, tile));
+    }
+    BOOST_REQUIRE_GT(tilesSize, 0);
+    setLastUsed(getFolder(file1), 120);
+    setLastUsed(getFolder(file2), 60);
+
+    // Opening the first image again makes the second one the oldest
+    const auto settings = getSettings(tilesSize * 3 / 2);
+    DiskTileCache cache1{file1, settings};
+    DiskTileCache cache3{file3, settings};
+    BOOST_CHECK(QDir{getFolder(file2)}.exists());
+
+    // The eviction happens when storing the first tile of a new image
+    BOOST_REQUIRE(cache3.save(0, tile));
+    BOOST_CHECK(cache1.load(0) == tile);
+    BOOST_CHECK(!QDir{getFolder(file2)}.exists());
+    BOOST_CHECK(QDir{getFolder(file3)}.exists());
+}
+
+BOOST_FIXTURE_TEST_CASE(testLockIsReleasedOnDestruction, Fixture)
+{
+    const auto file = createFile("image.png");
+
+    DiskTileCache cache{file, getSettings()};
+    auto lock = cache.lock();
+    BOOST_REQUIRE(lock);
+    BOOST_CHECK(lock->isLocked());
+
+    lock.reset();
+    BOOST_CHECK(cache.lock());
+}
+
+BOOST_FIXTURE_TEST_CASE(testUnusableCacheDoesNotStoreTiles, Fixture)
+{
+    const auto file = createFile("image.png");
+
+    // The folder of the cache can't be created inside a regular file
+    const auto settings = DiskTileCache::Settings{file, unlimited};
+    DiskTileCache cache{file, settings};
+    BOOST_CHECK(!cache.save(0, tile));
+    BOOST_CHECK(cache.load(0).isNull());
+    BOOST_CHECK(!cache.lock());
+
+    DiskTileCache missingFile{files.path() + "/missing.png", getSettings()};
+    BOOST_CHECK(!missingFile.save(0, tile));
+    const auto filter = QDir::AllEntries | QDir::NoDotAndDotDot;
+    BOOST_CHECK(QDir{cacheDir.path()}.entryList(filter).empty());
+}
@@ -0,0 +1,204 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE DisplayGroupPatchTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "scene/ContentWindow.h"
+#include "scene/DisplayGroup.h"
+#include "scene/DisplayGroupPatch.h"
+#include "serialization/utils.h"
+
+#include "DummyContent.h"
+
+namespace
+{
+const QSize wallSize(1000, 1000);
+
+ContentWindowPtr makeDummyWindow()
+{
+    ContentPtr content(new DummyContent);
+    content->setDimensions(QSize(512, 512));
+    return boost::make_shared<ContentWindow>(content);
+}
+
+struct Fixture
+{
+    Fixture()
+    {
+        group->addContentWindow(window0);
+        group->addContentWindow(window1);
+        group->addContentWindow(window2);
+    }
+
+    // Like the master, start with a snapshot
+    DisplayGroupPatch makePatch(const bool snapshot = false)
+    {
+        const auto first = sequence == 0;
+        return DisplayGroupPatch{*group, ++sequence, sentVersions,
+                                 snapshot || first};
+    }
+
+    DisplayGroupPtr group = boost::make_shared<DisplayGroup>(wallSize);
+    ContentWindowPtr window0 = makeDummyWindow();
+    ContentWindowPtr window1 = makeDummyWindow();
+    ContentWindowPtr window2 = makeDummyWindow();
+    DisplayGroupPatch::WindowVersions sentVersions;
+    uint64_t sequence = 0;
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testFirstPatchIsSnapshot, Fixture)
+{
+    const auto patch = makePatch();
+    BOOST_CHECK_EQUAL(patch.getSequence(), 1u);
+    BOOST_CHECK(patch.isSnapshot());
+    BOOST_CHECK_EQUAL(patch.getContentWindows().size(), 3u);
+    BOOST_CHECK_EQUAL(sentVersions.size(), 3u);
+}
+
+BOOST_FIXTURE_TEST_CASE(testPatchOnlyContainsModifiedWindows, Fixture)
+{
+    makePatch();
+    BOOST_CHECK(makePatch().getContentWindows().empty());
+
+    window1->setCoordinates(QRectF(10, 10, 200, 200));
+    const auto patch = makePatch();
+    BOOST_REQUIRE_EQUAL(patch.getContentWindows().size(), 1u);
+    BOOST_CHECK_EQUAL(patch.getContentWindows()[0], window1);
+
+    BOOST_CHECK_EQUAL(makePatch(true).getContentWindows().size(), 3u);
+}
+
+BOOST_FIXTURE_TEST_CASE(testSerializedSnapshot, Fixture)
+{
+    window1->setCoordinates(QRectF(10, 10, 200, 200));
+    group->addFocusedWindow(window2);
+
+    const auto patch = serialization::binaryCopy(makePatch(true));
+    BOOST_CHECK(patch.isSnapshot());
+
+    const auto copy = patch.apply(nullptr);
+    BOOST_REQUIRE(copy);
+    BOOST_CHECK_EQUAL(copy->getCoordinates(), group->getCoordinates());
+    BOOST_REQUIRE_EQUAL(copy->getContentWindows().size(), 3u);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const auto& original = group->getContentWindows()[i];
+        const auto& replica = copy->getContentWindows()[i];
+        BOOST_CHECK_NE(original, replica);
+        BOOST_CHECK(original->getID() == replica->getID());
+        BOOST_CHECK_EQUAL(original->getVersion(), replica->getVersion());
+        BOOST_CHECK_EQUAL(original->getCoordinates(),
+                          replica->getCoordinates());
+    }
+    BOOST_REQUIRE_EQUAL(copy->getFocusedWindows().size(), 1u);
+    BOOST_CHECK(*copy->getFocusedWindows().begin() ==
+                copy->getContentWindow(window2->getID()));
+}
+
+BOOST_FIXTURE_TEST_CASE(testApplySharesUnchangedWindows, Fixture)
+{
+    const auto first = serialization::binaryCopy(makePatch()).apply(nullptr);
+    BOOST_REQUIRE(first);
+
+    window0->setCoordinates(QRectF(10, 10, 200, 200));
+    group->moveToFront(window0);
+    const auto next = serialization::binaryCopy(makePatch()).apply(first.get());
+    BOOST_REQUIRE(next);
+
+    const auto& windows = next->getContentWindows();
+    BOOST_REQUIRE_EQUAL(windows.size(), 3u);
+    BOOST_CHECK_EQUAL(windows[0], first->getContentWindows()[1]);
+    BOOST_CHECK_EQUAL(windows[1], first->getContentWindows()[2]);
+    BOOST_CHECK_NE(windows[2], first->getContentWindows()[0]);
+    BOOST_CHECK(windows[2]->getID() == window0->getID());
+    BOOST_CHECK_EQUAL(windows[2]->getCoordinates(), window0->getCoordinates());
+
+    // the previous group is left untouched
+    BOOST_CHECK(first->getContentWindows()[0]->getID() == window0->getID());
+    BOOST_CHECK_NE(first->getContentWindows()[0]->getCoordinates(),
+                   window0->getCoordinates());
+}
+
+BOOST_FIXTURE_TEST_CASE(testRemovedWindowIsDropped, Fixture)
+{
+    const auto first = makePatch().apply(nullptr);
+    BOOST_REQUIRE(first);
+
+    group->removeContentWindow(window1);
+    const auto next = makePatch().apply(first.get());
+    BOOST_REQUIRE(next);
+    BOOST_REQUIRE_EQUAL(next->getContentWindows().size(), 2u);
+    BOOST_CHECK(!next->getContentWindow(window1->getID()));
+    BOOST_CHECK_EQUAL(sentVersions.size(), 2u);
+
+    // a window added back must be sent again
+    group->addContentWindow(window1);
+    const auto patch = makePatch();
+    BOOST_REQUIRE_EQUAL(patch.getContentWindows().size(), 1u);
+    BOOST_CHECK_EQUAL(patch.getContentWindows()[0], window1);
+}
+
+BOOST_FIXTURE_TEST_CASE(testFullscreenWindowIsResolved, Fixture)
+{
+    const auto first = makePatch().apply(nullptr);
+    BOOST_REQUIRE(first);
+    BOOST_CHECK(!first->hasFullscreenWindows());
+
+    group->setFullscreenWindow(window2);
+    const auto next = makePatch().apply(first.get());
+    BOOST_REQUIRE(next);
+    BOOST_REQUIRE(next->getFullscreenWindow());
+    BOOST_CHECK(next->getFullscreenWindow()->getID() == window2->getID());
+}
+
+BOOST_FIXTURE_TEST_CASE(testPatchWithoutPreviousGroupIsRejected, Fixture)
+{
+    makePatch();
+    window0->setCoordinates(QRectF(10, 10, 200, 200));
+    const auto patch = makePatch();
+
+    BOOST_CHECK(!patch.apply(nullptr));
+
+    const auto empty = boost::make_shared<DisplayGroup>(wallSize);
+    BOOST_CHECK(!patch.apply(empty.get()));
+}
@@ -0,0 +1,135 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE DisplayGroupPublisherTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "network/DisplayGroupPublisher.h"
+#include "scene/DisplayGroup.h"
+
+#include "MinimalGlobalQtApp.h"
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+#include <QElapsedTimer>
+
+namespace
+{
+const QSizeF wallSize(1000, 1000);
+
+void processEventsFor(const int ms)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < ms)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, ms);
+}
+}
+
+BOOST_AUTO_TEST_CASE(testFirstUpdateIsPublishedImmediately)
+{
+    DisplayGroupPtr displayGroup(new DisplayGroup(wallSize));
+    DisplayGroupPublisher publisher(60);
+
+    size_t published = 0;
+    QObject::connect(&publisher, &DisplayGroupPublisher::publish,
+                     [&](DisplayGroupPtr group) {
+                         BOOST_CHECK_EQUAL(group, displayGroup);
+                         ++published;
+                     });
+
+    publisher.update(displayGroup);
+    BOOST_CHECK_EQUAL(published, 1u);
+    BOOST_CHECK_EQUAL(publisher.getSentCount(), 1u);
+    BOOST_CHECK_EQUAL(publisher.getSuppressedCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testBurstOfUpdatesIsCoalesced)
+{
+    DisplayGroupPtr displayGroup(new DisplayGroup(wallSize));
+    DisplayGroupPublisher publisher(60);
+
+    size_t published = 0;
+    QObject::connect(&publisher, &DisplayGroupPublisher::publish,
+                     [&](DisplayGroupPtr) { ++published; });
+
+    for (int i = 0; i < 100; ++i)
+        publisher.update(displayGroup);
+    BOOST_CHECK_EQUAL(published, 1u);
+
+    // The latest state is always published at the end of the period
+    processEventsFor(100);
+    BOOST_CHECK_EQUAL(published, 2u);
+    BOOST_CHECK_EQUAL(publisher.getSentCount(), 2u);
+    BOOST_CHECK_EQUAL(publisher.getSuppressedCount(), 98u);
+}
+
+BOOST_AUTO_TEST_CASE(testFlushPublishesPendingUpdate)
+{
+    DisplayGroupPtr displayGroup(new DisplayGroup(wallSize));
+    DisplayGroupPublisher publisher(1);
+
+    size_t published = 0;
+    QObject::connect(&publisher, &DisplayGroupPublisher::publish,
+                     [&](DisplayGroupPtr) { ++published; });
+
+    publisher.update(displayGroup);
+    publisher.update(displayGroup);
+    BOOST_CHECK_EQUAL(published, 1u);
+
+    publisher.flush();
+    BOOST_CHECK_EQUAL(published, 2u);
+
+    // Nothing left to publish
+    publisher.flush();
+    processEventsFor(10);
+    BOOST_CHECK_EQUAL(published, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(testUnlimitedRatePublishesEveryUpdate)
+{
+    DisplayGroupPtr displayGroup(new DisplayGroup(wallSize));
+    DisplayGroupPublisher publisher(0);
+
+    for (int i = 0; i < 10; ++i)
+        publisher.update(displayGroup);
+    BOOST_CHECK_EQUAL(publisher.getSentCount(), 10u);
+    BOOST_CHECK_EQUAL(publisher.getSuppressedCount(), 0u);
+}
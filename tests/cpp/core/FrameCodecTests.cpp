@@ -0,0 +1,165 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE FrameCodecTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "network/frameCodec.h"
+
+#include <cstring>
+
+namespace
+{
+deflect::Frame makeFrame()
+{
+    deflect::Frame frame;
+    frame.uri = "SomeUri";
+    frame.segments.resize(3);
+
+    frame.segments[0].parameters.x = 64;
+    frame.segments[0].parameters.width = 32;
+    frame.segments[0].parameters.height = 16;
+    frame.segments[0].parameters.dataType = deflect::DataType::rgba;
+    frame.segments[0].imageData = QByteArray(32 * 16 * 4, 'a');
+
+    // empty segment, as sent by the PixelStreamRouter for hidden areas
+    frame.segments[1].parameters.y = 16;
+
+    frame.segments[2].parameters.y = 32;
+    frame.segments[2].view = deflect::View::right_eye;
+    frame.segments[2].imageData = QByteArray("jpeg data");
+    return frame;
+}
+
+// Transfer the payload like MPI does, directly from buffer to buffer
+void transfer(const MPIBuffers& source, const MPIBuffers& target)
+{
+    BOOST_REQUIRE_EQUAL(source.size(), target.size());
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        BOOST_REQUIRE_EQUAL(source[i].size, target[i].size);
+        if (source[i].size > 0)
+            std::memcpy(target[i].data, source[i].data, source[i].size);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(testFrameRoundTrip)
+{
+    const auto frame = makeFrame();
+
+    const auto description = frameCodec::encode(frame);
+    auto copy = frameCodec::decode(description.data(), description.size());
+    BOOST_REQUIRE(copy);
+    transfer(frameCodec::getPayload(frame),
+             frameCodec::getPayloadTarget(*copy));
+
+    BOOST_CHECK_EQUAL(copy->uri.toStdString(), frame.uri.toStdString());
+    BOOST_REQUIRE_EQUAL(copy->segments.size(), frame.segments.size());
+    for (size_t i = 0; i < frame.segments.size(); ++i)
+    {
+        const auto& expected = frame.segments[i];
+        const auto& segment = copy->segments[i];
+        BOOST_CHECK_EQUAL(segment.parameters.x, expected.parameters.x);
+        BOOST_CHECK_EQUAL(segment.parameters.y, expected.parameters.y);
+        BOOST_CHECK_EQUAL(segment.parameters.width, expected.parameters.width);
+        BOOST_CHECK_EQUAL(segment.parameters.height,
+                          expected.parameters.height);
+        BOOST_CHECK_EQUAL((int)segment.parameters.dataType,
+                          (int)expected.parameters.dataType);
+        BOOST_CHECK_EQUAL((int)segment.view, (int)expected.view);
+        BOOST_CHECK(segment.imageData == expected.imageData);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testPayloadIsNotCopiedBySender)
+{
+    const auto frame = makeFrame();
+    const auto payload = frameCodec::getPayload(frame);
+
+    BOOST_REQUIRE_EQUAL(payload.size(), 3u);
+    BOOST_CHECK(payload[0].data == frame.segments[0].imageData.constData());
+    BOOST_CHECK_EQUAL(payload[1].size, 0u);
+    BOOST_CHECK(payload[2].data == frame.segments[2].imageData.constData());
+
+    // the description does not contain the image data
+    const auto description = frameCodec::encode(frame);
+    BOOST_CHECK_LT(description.size(), 200u);
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidDescriptionThrows)
+{
+    const auto description = frameCodec::encode(makeFrame());
+
+    BOOST_CHECK_THROW(frameCodec::decode(description.data(),
+                                         description.size() - 1),
+                      std::runtime_error);
+    BOOST_CHECK_THROW(frameCodec::decode(description.data(), 3),
+                      std::runtime_error);
+
+    auto corrupted = description;
+    corrupted[0] = ~corrupted[0];
+    BOOST_CHECK_THROW(frameCodec::decode(corrupted.data(), corrupted.size()),
+                      std::runtime_error);
+    BOOST_CHECK_EQUAL(frameCodec::getPayloadSize(corrupted.data(),
+                                                 corrupted.size()),
+                      0u);
+}
+
+BOOST_AUTO_TEST_CASE(testPayloadSizeOfUndecodableDescription)
+{
+    const auto frame = makeFrame();
+    const uint64_t expectedSize = frame.segments[0].imageData.size() +
+                                  frame.segments[2].imageData.size();
+
+    const auto description = frameCodec::encode(frame);
+    BOOST_CHECK_EQUAL(frameCodec::getPayloadSize(description.data(),
+                                                 description.size()),
+                      expectedSize);
+
+    // the payload can be discarded even if the segments are truncated
+    const auto truncatedSize = description.size() - 1;
+    BOOST_CHECK_THROW(frameCodec::decode(description.data(), truncatedSize),
+                      std::runtime_error);
+    BOOST_CHECK_EQUAL(frameCodec::getPayloadSize(description.data(),
+                                                 truncatedSize),
+                      expectedSize);
+}
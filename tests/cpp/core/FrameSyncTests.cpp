@@ -0,0 +1,144 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE FrameSyncTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "FrameSync.h"
+
+namespace
+{
+using Values = std::vector<int64_t>;
+
+// Simulate a collective with another process holding the given values
+FrameSync::GlobalMinFunction minWith(const Values& otherValues)
+{
+    return [otherValues](const Values& values) {
+        BOOST_REQUIRE_EQUAL(values.size(), otherValues.size());
+        Values result(values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+            result[i] = std::min(values[i], otherValues[i]);
+        return result;
+    };
+}
+
+Values valuesOf(FrameSync& frameSync)
+{
+    Values values;
+    frameSync.resolve([&values](const Values& local) {
+        values = local;
+        return local;
+    });
+    return values;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testResolveWithoutEntriesDoesNotCallCollective)
+{
+    FrameSync frameSync;
+    bool called = false;
+    frameSync.resolve([&called](const Values& values) {
+        called = true;
+        return values;
+    });
+    BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(testAllEntriesResolvedInOneCollective)
+{
+    FrameSync frameSync;
+    std::vector<bool> results;
+    const auto store = [&results](const bool ok) { results.push_back(ok); };
+
+    frameSync.addReady(true, store);
+    frameSync.addVersion(3, store);
+    frameSync.addReady(false, store);
+    frameSync.addVersion(7, store);
+    BOOST_CHECK_EQUAL(frameSync.size(), 4);
+
+    FrameSync otherProcess;
+    otherProcess.addReady(true, nullptr);
+    otherProcess.addVersion(3, nullptr);
+    otherProcess.addReady(true, nullptr);
+    otherProcess.addVersion(8, nullptr);
+
+    size_t collectives = 0;
+    const auto globalMin = minWith(valuesOf(otherProcess));
+    frameSync.resolve([&](const Values& values) {
+        ++collectives;
+        return globalMin(values);
+    });
+
+    BOOST_CHECK_EQUAL(collectives, 1);
+    BOOST_CHECK_EQUAL(frameSync.size(), 0);
+    const auto expected = std::vector<bool>{true, true, false, false};
+    BOOST_CHECK_EQUAL_COLLECTIONS(results.begin(), results.end(),
+                                  expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(testVersionMismatchDetectedInBothDirections)
+{
+    for (const auto otherVersion : {uint64_t{4}, uint64_t{6}})
+    {
+        FrameSync otherProcess;
+        otherProcess.addVersion(otherVersion, nullptr);
+
+        FrameSync frameSync;
+        bool same = true;
+        frameSync.addVersion(5, [&same](const bool ok) { same = ok; });
+        frameSync.resolve(minWith(valuesOf(otherProcess)));
+        BOOST_CHECK(!same);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCallbacksCalledInOrderOfRegistration)
+{
+    FrameSync frameSync;
+    std::vector<int> order;
+    frameSync.addReady(true, [&order](bool) { order.push_back(1); });
+    frameSync.addVersion(1, [&order](bool) { order.push_back(2); });
+    frameSync.addReady(true, [&order](bool) { order.push_back(3); });
+    frameSync.resolve([](const Values& values) { return values; });
+
+    const auto expected = std::vector<int>{1, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(),
+                                  expected.end());
+}
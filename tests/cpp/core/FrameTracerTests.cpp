@@ -0,0 +1,265 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE FrameTracerTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "FrameTracer.h"
+#include "serialization/utils.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+namespace
+{
+using us = std::chrono::microseconds;
+
+LatencyHistogram makeHistogram()
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 90; ++i)
+        histogram.add(us(100));
+    for (int i = 0; i < 10; ++i)
+        histogram.add(us(10000));
+    return histogram;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testEmptyHistogram)
+{
+    const LatencyHistogram histogram;
+    BOOST_CHECK_EQUAL(histogram.getCount(), 0u);
+    BOOST_CHECK_EQUAL(histogram.getMeanMs(), 0.0);
+    BOOST_CHECK_EQUAL(histogram.getMaxMs(), 0.0);
+    BOOST_CHECK_EQUAL(histogram.getPercentileMs(50.0), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(testHistogramBuckets)
+{
+    LatencyHistogram histogram;
+    histogram.add(us(0));
+    histogram.add(us(1));
+    histogram.add(us(2));
+    histogram.add(us(1023));
+    histogram.add(us(1024));
+    histogram.add(std::chrono::hours(1));
+
+    const auto& buckets = histogram.getBuckets();
+    BOOST_CHECK_EQUAL(buckets[0], 2u);
+    BOOST_CHECK_EQUAL(buckets[1], 1u);
+    BOOST_CHECK_EQUAL(buckets[9], 1u);
+    BOOST_CHECK_EQUAL(buckets[10], 1u);
+    BOOST_CHECK_EQUAL(buckets[LatencyHistogram::bucketCount - 1], 1u);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketLimitUs(0), 2u);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketLimitUs(9), 1024u);
+}
+
+BOOST_AUTO_TEST_CASE(testHistogramPercentiles)
+{
+    const auto histogram = makeHistogram();
+
+    BOOST_CHECK_EQUAL(histogram.getCount(), 100u);
+    BOOST_CHECK_CLOSE(histogram.getMeanMs(), 1.09, 0.001);
+    BOOST_CHECK_CLOSE(histogram.getMaxMs(), 10.0, 0.001);
+
+    // the estimates lie within the [64, 128[ and [8192, 16384[ us buckets
+    const auto p50 = histogram.getPercentileMs(50.0);
+    BOOST_CHECK_GE(p50, 0.064);
+    BOOST_CHECK_LT(p50, 0.128);
+    const auto p95 = histogram.getPercentileMs(95.0);
+    BOOST_CHECK_GE(p95, 8.192);
+    BOOST_CHECK_LE(p95, 10.0);
+    BOOST_CHECK_EQUAL(histogram.getPercentileMs(100.0), 10.0);
+    BOOST_CHECK_LE(p50, histogram.getPercentileMs(90.0));
+}
+
+BOOST_AUTO_TEST_CASE(testMergeHistograms)
+{
+    auto histogram = makeHistogram();
+    LatencyHistogram other;
+    other.add(us(20000));
+    histogram.merge(other);
+
+    BOOST_CHECK_EQUAL(histogram.getCount(), 101u);
+    BOOST_CHECK_CLOSE(histogram.getMaxMs(), 20.0, 0.001);
+    BOOST_CHECK_EQUAL(histogram.getBuckets()[14], 1u);
+}
+
+BOOST_AUTO_TEST_CASE(testScopeRecordsStage)
+{
+    FrameTracer tracer;
+    BOOST_CHECK(tracer.getStatistics().isEmpty());
+    {
+        const FrameTracer::Scope trace(TraceStage::decode, tracer);
+    }
+    const auto stats = tracer.getStatistics();
+    BOOST_CHECK(!stats.isEmpty());
+    BOOST_CHECK_EQUAL(stats[TraceStage::decode].getCount(), 1u);
+    BOOST_CHECK_EQUAL(stats[TraceStage::upload].getCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(testAsyncStage)
+{
+    FrameTracer tracer;
+    const auto start = FrameTracer::clock::now();
+    tracer.beginAsync(TraceStage::streamReceive, 1);
+    tracer.beginAsync(TraceStage::streamReceive, 2);
+    tracer.endAsync(TraceStage::streamReceive, 1);
+    tracer.endAsync(TraceStage::streamReceive, 1); // already completed
+    tracer.endAsync(TraceStage::mpiSend, 2);       // different stage
+    tracer.endAsync(TraceStage::streamReceive, 3); // never started
+
+    auto stats = tracer.getStatistics();
+    BOOST_CHECK_EQUAL(stats[TraceStage::streamReceive].getCount(), 1u);
+    BOOST_CHECK_EQUAL(stats[TraceStage::mpiSend].getCount(), 0u);
+
+    tracer.endAsync(TraceStage::streamReceive, 2);
+    stats = tracer.getStatistics();
+    BOOST_CHECK_EQUAL(stats[TraceStage::streamReceive].getCount(), 2u);
+
+    const auto elapsed = FrameTracer::clock::now() - start;
+    const auto elapsedMs =
+        std::chrono::duration<double, std::milli>(elapsed).count();
+    BOOST_CHECK_LE(stats[TraceStage::streamReceive].getMaxMs(), elapsedMs);
+}
+
+BOOST_AUTO_TEST_CASE(testStatisticsCoverRecentIntervals)
+{
+    FrameTracer tracer{std::chrono::milliseconds(100)};
+    const auto now = FrameTracer::clock::now();
+    tracer.setTileLoads(3, 1);
+
+    tracer.record(TraceStage::render, now, now + us(1000));
+    tracer.record(TraceStage::decode, now + us(150000), now + us(151000));
+    auto stats = tracer.getStatistics();
+    BOOST_CHECK_EQUAL(stats[TraceStage::render].getCount(), 1u);
+    BOOST_CHECK_EQUAL(stats[TraceStage::decode].getCount(), 1u);
+
+    // samples older than the previous interval expire
+    tracer.record(TraceStage::sync, now + us(300000), now + us(301000));
+    stats = tracer.getStatistics();
+    BOOST_CHECK_EQUAL(stats[TraceStage::render].getCount(), 0u);
+    BOOST_CHECK_EQUAL(stats[TraceStage::decode].getCount(), 1u);
+    BOOST_CHECK_EQUAL(stats[TraceStage::sync].getCount(), 1u);
+
+    // all of them after two intervals without samples
+    tracer.record(TraceStage::swapBuffers, now + us(600000),
+                  now + us(601000));
+    stats = tracer.getStatistics();
+    BOOST_CHECK_EQUAL(stats[TraceStage::decode].getCount(), 0u);
+    BOOST_CHECK_EQUAL(stats[TraceStage::sync].getCount(), 0u);
+    BOOST_CHECK_EQUAL(stats[TraceStage::swapBuffers].getCount(), 1u);
+
+    // the occupancy of the tile loader does not expire
+    BOOST_CHECK_EQUAL(stats.getQueuedTileLoads(), 3u);
+    BOOST_CHECK_EQUAL(stats.getRunningTileLoads(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(testStatisticsSerialization)
+{
+    FrameTraceStatistics stats;
+    stats[TraceStage::render].add(us(5000));
+    stats[TraceStage::swapBarrier].add(us(300));
+    stats[TraceStage::swapBarrier].add(us(700));
+    stats.setTileLoads(12, 4);
+
+    const auto data = serialization::toBinary(stats);
+    const auto copy = serialization::get<FrameTraceStatistics>(data);
+
+    BOOST_CHECK_EQUAL(copy[TraceStage::render].getCount(), 1u);
+    BOOST_CHECK_CLOSE(copy[TraceStage::render].getMaxMs(), 5.0, 0.001);
+    BOOST_CHECK_EQUAL(copy[TraceStage::swapBarrier].getCount(), 2u);
+    BOOST_CHECK_CLOSE(copy[TraceStage::swapBarrier].getMeanMs(), 0.5, 0.001);
+    BOOST_CHECK(copy[TraceStage::swapBarrier].getBuckets() ==
+                stats[TraceStage::swapBarrier].getBuckets());
+    BOOST_CHECK_EQUAL(copy.getQueuedTileLoads(), 12u);
+    BOOST_CHECK_EQUAL(copy.getRunningTileLoads(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(testChromeTraceIsOnlyWrittenWhenEnabled)
+{
+    FrameTracer tracer;
+    tracer.record(TraceStage::sync, FrameTracer::clock::now());
+    BOOST_CHECK(!tracer.writeChromeTrace());
+}
+
+BOOST_AUTO_TEST_CASE(testWriteChromeTrace)
+{
+    QTemporaryDir dir;
+    const auto filename = dir.path() + "/trace.json";
+
+    FrameTracer tracer;
+    tracer.enableChromeTrace(filename, 2);
+    const auto now = FrameTracer::clock::now();
+    tracer.record(TraceStage::decode, now, now + us(1500));
+    tracer.record(TraceStage::upload, now + us(1500), now + us(1750));
+    tracer.record(TraceStage::render, now, now + us(100)); // over the limit
+    BOOST_REQUIRE(tracer.writeChromeTrace());
+
+    // statistics include the events that were not kept in the trace
+    BOOST_CHECK_EQUAL(tracer.getStatistics()[TraceStage::render].getCount(),
+                      1u);
+
+    QFile file(filename);
+    BOOST_REQUIRE(file.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    const auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+    BOOST_REQUIRE_EQUAL(error.error, QJsonParseError::NoError);
+
+    const auto traceEvents = doc.object()["traceEvents"].toArray();
+    std::vector<QJsonObject> events;
+    for (const auto& value : traceEvents)
+    {
+        const auto event = value.toObject();
+        if (event["ph"].toString() == "X")
+            events.push_back(event);
+    }
+    BOOST_REQUIRE_EQUAL(events.size(), 2u);
+    BOOST_CHECK_EQUAL(events[0]["name"].toString().toStdString(), "decode");
+    BOOST_CHECK_EQUAL(events[0]["dur"].toInt(), 1500);
+    BOOST_CHECK_EQUAL(events[1]["name"].toString().toStdString(), "upload");
+    BOOST_CHECK_EQUAL(events[1]["dur"].toInt(), 250);
+    BOOST_CHECK_EQUAL(events[1]["ts"].toDouble() - events[0]["ts"].toDouble(),
+                      1500.0);
+}
@@ -0,0 +1,176 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE ImageSourceTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "DiskTileCache.h"
+#include "ImageSource.h"
+#include "data/Image.h"
+
+#include "MinimalGlobalQtApp.h"
+#include "imageFiles.h"
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+#include <QDir>
+#include <QTemporaryDir>
+
+namespace
+{
+const QSize imageSize{2500, 1500};
+const uint expectedMaxLod = 2;
+const qint64 unlimited = 1 << 30;
+
+Indices getAllTiles(const ImageSource& source)
+{
+    Indices tiles;
+    for (uint lod = 0; lod <= source.getMaxLod(); ++lod)
+    {
+        const auto area = QRectF(QPointF(), source.getTilesArea(lod));
+        for (auto tileId : source.computeVisibleSet(area, lod))
+            tiles.insert(tileId);
+    }
+    return tiles;
+}
+
+QImage toQImage(const Image& image)
+{
+    return QImage(image.getData(), image.getWidth(), image.getHeight(),
+                  QImage::Format_RGB32)
+        .copy();
+}
+
+struct Fixture
+{
+    QTemporaryDir files;
+    QTemporaryDir cacheDir;
+    const DiskTileCache::Settings previousSettings =
+        DiskTileCache::getSettings();
+    const QImage image = makeImage(imageSize);
+    const QString filename = files.path() + "/image.png";
+
+    Fixture()
+    {
+        BOOST_REQUIRE(image.save(filename));
+        setCacheSize(unlimited);
+    }
+
+    ~Fixture() { DiskTileCache::setSettings(previousSettings); }
+
+    void setCacheSize(const qint64 maxSize)
+    {
+        DiskTileCache::setSettings({cacheDir.path(), maxSize});
+    }
+
+    void checkTiles(const ImageSource& source, const Indices& tiles)
+    {
+        for (auto tileId : tiles)
+        {
+            const auto tile = source.getTileImage(tileId, deflect::View::mono);
+            BOOST_REQUIRE(tile);
+            BOOST_CHECK_EQUAL(tile->getWidth(),
+                              source.getTileRect(tileId).width());
+            BOOST_CHECK_EQUAL(tile->getHeight(),
+                              source.getTileRect(tileId).height());
+        }
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testImageIsDividedInTiles, Fixture)
+{
+    ImageSource source{filename};
+    BOOST_REQUIRE_EQUAL(source.getMaxLod(), expectedMaxLod);
+    BOOST_CHECK_EQUAL(source.getTilesArea(0), imageSize);
+
+    const auto tiles = getAllTiles(source);
+    BOOST_CHECK_EQUAL(tiles.size(), 9u);
+    checkTiles(source, tiles);
+
+    const auto topLeft = source.computeVisibleSet(QRectF(0, 0, 1, 1), 0);
+    BOOST_REQUIRE_EQUAL(topLeft.size(), 1u);
+    const auto tileId = *topLeft.begin();
+    const auto rect = source.getTileRect(tileId);
+    const auto tile = source.getTileImage(tileId, deflect::View::mono);
+    BOOST_CHECK(toQImage(*tile) == image.copy(rect));
+}
+
+BOOST_FIXTURE_TEST_CASE(testGeneratedTilesAreStoredOnDisk, Fixture)
+{
+    Indices tiles;
+    {
+        ImageSource source{filename};
+        tiles = getAllTiles(source);
+        source.getTileImage(*tiles.begin(), deflect::View::mono);
+    }
+
+    DiskTileCache cache{filename, DiskTileCache::getSettings()};
+    for (auto tileId : tiles)
+        BOOST_CHECK(!cache.load(tileId).isNull());
+}
+
+BOOST_FIXTURE_TEST_CASE(testTilesAreDecodedIfTheyCantBeStored, Fixture)
+{
+    // The folder of the cache can't be created inside a regular file
+    DiskTileCache::setSettings({filename, unlimited});
+
+    ImageSource source{filename};
+    checkTiles(source, getAllTiles(source));
+}
+
+BOOST_FIXTURE_TEST_CASE(testTilesAreDecodedIfDiskCacheIsDisabled, Fixture)
+{
+    setCacheSize(0);
+
+    ImageSource source{filename};
+    const auto tiles = getAllTiles(source);
+    checkTiles(source, tiles);
+
+    const auto topLeft = source.computeVisibleSet(QRectF(0, 0, 1, 1), 0);
+    BOOST_REQUIRE_EQUAL(topLeft.size(), 1u);
+    const auto tileId = *topLeft.begin();
+    const auto rect = source.getTileRect(tileId);
+    const auto tile = source.getTileImage(tileId, deflect::View::mono);
+    BOOST_CHECK(toQImage(*tile) == image.copy(rect));
+
+    const auto filter = QDir::AllEntries | QDir::NoDotAndDotDot;
+    BOOST_CHECK(QDir{cacheDir.path()}.entryList(filter).empty());
+}
@@ -55,15 +55,38 @@ namespace
 const QSize wallSize(1000, 1000);
 const QString regexJson{
     R"(\{
+    "display_group": \{
+        "sent_count": 0,
+        "suppressed_count": 0
+    \},
     "event": \{
         "count": 2,
         "last_event": "contentWindowAdded",
         "last_event_date": "\d{4}-\d{2}-\d{2}[A-Z]\d{2}:\d{2}:\d{2}.\d{6}"
     \},
+    "latency": \{
+        "aggregate": \{
+        \},
+        "nodes": \{
+        \}
+    \},
     "screens": {
         "last_change": "",
         "state": "UNDEF"
     },
+    "streams": {
+        "average_bytes_saved": 0,
+        "frame_count": 0,
+        "last_frame_bytes_saved": 0
+    },
+    "tile_loads": \{
+        "aggregate": \{
+            "queued": 0,
+            "running": 0
+        \},
+        "nodes": \{
+        \}
+    \},
     "window": \{
         "accumulated_count": 2,
         "count": 2,
@@ -73,15 +96,38 @@ const QString regexJson{
 )"};
 const std::string defaultJson{
     R"({
+    "display_group": {
+        "sent_count": 0,
+        "suppressed_count": 0
+    },
     "event": {
         "count": 0,
         "last_event": "",
         "last_event_date": ""
     },
+    "latency": {
+        "aggregate": {
+        },
+        "nodes": {
+        }
+    },
     "screens": {
         "last_change": "",
         "state": "UNDEF"
     },
+    "streams": {
+        "average_bytes_saved": 0,
+        "frame_count": 0,
+        "last_frame_bytes_saved": 0
+    },
+    "tile_loads": {
+        "aggregate": {
+            "queued": 0,
+            "running": 0
+        },
+        "nodes": {
+        }
+    },
     "window": {
         "accumulated_count": 0,
         "count": 0,
@@ -205,6 +251,34 @@ BOOST_AUTO_TEST_CASE(hideLauncher)
     BOOST_CHECK(logger.get()->getWindowCount() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(testPixelStreamCounters)
+{
+    LoggingUtility logger;
+    BOOST_CHECK_EQUAL(logger.getStreamFrameCount(), 0);
+    BOOST_CHECK_EQUAL(logger.getAverageStreamFrameBytesSaved(), 0);
+
+    logger.pixelStreamSent(1000, 5000);
+    logger.pixelStreamSent(2000, 1000);
+    BOOST_CHECK_EQUAL(logger.getStreamFrameCount(), 2);
+    BOOST_CHECK_EQUAL(logger.getLastStreamFrameBytesSaved(), 1000);
+    BOOST_CHECK_EQUAL(logger.getAverageStreamFrameBytesSaved(), 3000);
+}
+
+BOOST_AUTO_TEST_CASE(testDisplayGroupCounters)
+{
+    LoggingUtility logger;
+    for (int i = 0; i < 5; ++i)
+        logger.displayGroupModified();
+    logger.displayGroupSent();
+    logger.displayGroupSent();
+    BOOST_CHECK_EQUAL(logger.getDisplayGroupSentCount(), 2);
+    BOOST_CHECK_EQUAL(logger.getDisplayGroupSuppressedCount(), 3);
+
+    const auto displayGroup = to_json_object(logger)["display_group"];
+    BOOST_CHECK_EQUAL(displayGroup.toObject()["sent_count"].toInt(), 2);
+    BOOST_CHECK_EQUAL(displayGroup.toObject()["suppressed_count"].toInt(), 3);
+}
+
 BOOST_AUTO_TEST_CASE(testJsonOutput)
 {
     ContentPtr content(new DummyContent);
@@ -227,3 +301,48 @@ BOOST_AUTO_TEST_CASE(testJsonOutput)
     const QString matchedJson = regex.match(json).captured();
     BOOST_CHECK_EQUAL(to_json(*logger), matchedJson.toStdString());
 }
+
+BOOST_AUTO_TEST_CASE(testTraceStatisticsJsonOutput)
+{
+    FrameTraceStatistics wall1;
+    wall1[TraceStage::decode].add(std::chrono::microseconds(1000));
+    wall1[TraceStage::decode].add(std::chrono::microseconds(3000));
+    wall1.setTileLoads(4, 2);
+    FrameTraceStatistics wall2;
+    wall2[TraceStage::decode].add(std::chrono::microseconds(2000));
+    wall2[TraceStage::render].add(std::chrono::microseconds(500));
+    wall2.setTileLoads(1, 1);
+
+    LoggingUtility logger;
+    logger.traceStatisticsReceived(wall1, "wall1");
+    logger.traceStatisticsReceived(wall2, "wall2");
+    BOOST_CHECK_EQUAL(logger.getTraceStatistics().size(), 2u);
+
+    const auto latency = to_json_object(logger)["latency"].toObject();
+    const auto nodes = latency["nodes"].toObject();
+    BOOST_CHECK_EQUAL(nodes.size(), 2);
+
+    const auto decode1 = nodes["wall1"].toObject()["decode"].toObject();
+    BOOST_CHECK_EQUAL(decode1["count"].toInt(), 2);
+    BOOST_CHECK_CLOSE(decode1["mean_ms"].toDouble(), 2.0, 0.001);
+    BOOST_CHECK_CLOSE(decode1["max_ms"].toDouble(), 3.0, 0.001);
+    BOOST_CHECK(!nodes["wall1"].toObject().contains("render"));
+
+    const auto aggregate = latency["aggregate"].toObject();
+    BOOST_CHECK_EQUAL(aggregate["decode"].toObject()["count"].toInt(), 3);
+    BOOST_CHECK_EQUAL(aggregate["render"].toObject()["count"].toInt(), 1);
+
+    const auto tileLoads = to_json_object(logger)["tile_loads"].toObject();
+    const auto tileLoads1 = tileLoads["nodes"].toObject()["wall1"].toObject();
+    BOOST_CHECK_EQUAL(tileLoads1["queued"].toInt(), 4);
+    BOOST_CHECK_EQUAL(tileLoads1["running"].toInt(), 2);
+    const auto tileLoadsTotal = tileLoads["aggregate"].toObject();
+    BOOST_CHECK_EQUAL(tileLoadsTotal["queued"].toInt(), 5);
+    BOOST_CHECK_EQUAL(tileLoadsTotal["running"].toInt(), 3);
+
+    // newer statistics of a node replace the previous ones
+    logger.traceStatisticsReceived(wall2, "wall1");
+    const auto updated = to_json_object(logger)["latency"].toObject();
+    const auto decode = updated["aggregate"].toObject()["decode"].toObject();
+    BOOST_CHECK_EQUAL(decode["count"].toInt(), 2);
+}
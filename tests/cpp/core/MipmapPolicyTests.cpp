@@ -0,0 +1,76 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE MipmapPolicyTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "textureUtils.h"
+
+BOOST_AUTO_TEST_CASE(default_policy_depends_on_texture_type)
+{
+    BOOST_CHECK(textureUtils::getMipmapPolicy(TextureType::Static) ==
+                MipmapPolicy::always);
+    BOOST_CHECK(textureUtils::getMipmapPolicy(TextureType::Dynamic) ==
+                MipmapPolicy::lazy);
+}
+
+BOOST_AUTO_TEST_CASE(never_and_always_policies_ignore_scale)
+{
+    for (auto scale : {0.1, 0.5, 1.0, 2.0})
+    {
+        BOOST_CHECK(!textureUtils::needMipmaps(MipmapPolicy::never, scale));
+        BOOST_CHECK(textureUtils::needMipmaps(MipmapPolicy::always, scale));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lazy_policy_needs_mipmaps_only_when_scaled_down)
+{
+    BOOST_CHECK(!textureUtils::needMipmaps(MipmapPolicy::lazy, 2.0));
+    BOOST_CHECK(!textureUtils::needMipmaps(MipmapPolicy::lazy, 1.0));
+    BOOST_CHECK(!textureUtils::needMipmaps(MipmapPolicy::lazy, 0.5));
+    BOOST_CHECK(textureUtils::needMipmaps(MipmapPolicy::lazy, 0.49));
+    BOOST_CHECK(textureUtils::needMipmaps(MipmapPolicy::lazy, 0.1));
+}
+
+BOOST_AUTO_TEST_CASE(mipmap_time_is_unknown_before_calibration)
+{
+    BOOST_CHECK_EQUAL(textureUtils::estimateMipmapTime(1920 * 1080), -1);
+}
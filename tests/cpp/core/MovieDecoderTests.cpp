@@ -0,0 +1,185 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE MovieDecoderTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "MovieDecoder.h"
+
+#include "data/FFMPEGFrame.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+const double frameDuration = 0.1;
+const int framesCount = 3;
+const double duration = framesCount * frameDuration;
+const double lastFramePosition = duration - frameDuration;
+
+// Decode the frames of a movie of framesCount frames, then its end
+FFMPEGFramePtr decodeFrame(const double position, double& decodedPosition)
+{
+    const auto index = std::lround(position / frameDuration);
+    if (index >= framesCount)
+        return FFMPEGFramePtr();
+
+    decodedPosition = index * frameDuration;
+    return std::make_shared<FFMPEGFrame>();
+}
+
+void checkFrame(const MovieDecoder::Frame& frame, const double position,
+                const bool loopedBack = false)
+{
+    BOOST_REQUIRE(frame.decoded);
+    BOOST_CHECK_CLOSE(frame.position + 1.0, position + 1.0, 0.001);
+    BOOST_CHECK_EQUAL(frame.loopedBack, loopedBack);
+}
+
+void checkEnd(const MovieDecoder::Frame& frame)
+{
+    BOOST_CHECK(!frame.decoded);
+    BOOST_CHECK_CLOSE(frame.position, lastFramePosition, 0.001);
+    BOOST_CHECK(!frame.loopedBack);
+}
+
+void playUntilLastFrame(MovieDecoder& decoder)
+{
+    for (int i = 0; i < framesCount; ++i)
+        checkFrame(decoder.getFrame(i * frameDuration), i * frameDuration);
+}
+}
+
+BOOST_AUTO_TEST_CASE(testLoopingMovieStartsAgainAtTheEnd)
+{
+    MovieDecoder decoder(decodeFrame, frameDuration, duration, 1);
+
+    playUntilLastFrame(decoder);
+    checkFrame(decoder.getFrame(duration), 0.0, true);
+    checkFrame(decoder.getFrame(frameDuration), frameDuration);
+}
+
+BOOST_AUTO_TEST_CASE(testMovieStopsAtTheEndWhenNotLooping)
+{
+    MovieDecoder decoder(decodeFrame, frameDuration, duration, 2);
+    decoder.setLoop(false);
+
+    playUntilLastFrame(decoder);
+    checkEnd(decoder.getFrame(duration));
+    checkEnd(decoder.getFrame(duration));
+}
+
+BOOST_AUTO_TEST_CASE(testEnableLoopAtTheEndOfMovie)
+{
+    MovieDecoder decoder(decodeFrame, frameDuration, duration, 1);
+    decoder.setLoop(false);
+
+    playUntilLastFrame(decoder);
+    checkEnd(decoder.getFrame(duration));
+
+    decoder.setLoop(true);
+    checkFrame(decoder.getFrame(duration), 0.0, true);
+}
+
+BOOST_AUTO_TEST_CASE(testDisableLoopAtTheEndOfMovie)
+{
+    MovieDecoder decoder(decodeFrame, frameDuration, duration, 1);
+
+    playUntilLastFrame(decoder);
+    checkFrame(decoder.getFrame(duration), 0.0, true);
+
+    // The end of the movie was consumed, decoding must continue from the start
+    decoder.setLoop(false);
+    checkFrame(decoder.getFrame(frameDuration), frameDuration);
+    checkFrame(decoder.getFrame(lastFramePosition), lastFramePosition);
+    checkEnd(decoder.getFrame(duration));
+
+    decoder.setLoop(true);
+    checkFrame(decoder.getFrame(duration), 0.0, true);
+}
+
+BOOST_AUTO_TEST_CASE(testMovieWithoutFramesDoesNotBlock)
+{
+    const auto decodeNothing = [](double, double&) { return FFMPEGFramePtr(); };
+    MovieDecoder decoder(decodeNothing, frameDuration, duration, 1);
+
+    BOOST_CHECK(!decoder.getFrame(0.0).decoded);
+
+    decoder.setLoop(false);
+    BOOST_CHECK(!decoder.getFrame(0.0).decoded);
+}
+
+BOOST_AUTO_TEST_CASE(testSeekReturnsPreviousFrameUntilDecoded)
+{
+    const double seekPosition = 5.0;
+    std::atomic<bool> seekDecodeAllowed{false};
+    const auto decodeSlowSeek = [&](const double position,
+                                    double& decodedPosition) {
+        while (position >= seekPosition && !seekDecodeAllowed)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        decodedPosition = position;
+        return std::make_shared<FFMPEGFrame>();
+    };
+    MovieDecoder decoder(decodeSlowSeek, frameDuration, 10.0, 1);
+
+    const auto first = decoder.getFrame(0.0);
+    BOOST_REQUIRE(first.decoded);
+
+    // The caller is not blocked while the new position is being decoded
+    const auto previous = decoder.getFrame(seekPosition);
+    BOOST_CHECK(previous.decoded == first.decoded);
+    BOOST_CHECK_CLOSE(previous.position, seekPosition, 0.001);
+    BOOST_CHECK(!previous.loopedBack);
+
+    seekDecodeAllowed = true;
+    auto next = decoder.getFrame(seekPosition);
+    for (int i = 0; i < 500 && next.decoded == first.decoded; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        next = decoder.getFrame(seekPosition);
+    }
+    BOOST_REQUIRE(next.decoded);
+    BOOST_CHECK(next.decoded != first.decoded);
+    BOOST_CHECK_CLOSE(next.position, seekPosition, 0.001);
+}
@@ -46,6 +46,7 @@
 #include <deflect/Frame.h>
 #include <deflect/SegmentDecoder.h>
 
+#include <algorithm>
 #include <cmath> //std::ceil
 
 namespace
@@ -250,3 +251,40 @@ BOOST_AUTO_TEST_CASE(testAssembleStreamImageYUVandRGBA)
         checkData(*image3, subsamp);
     }
 }
+
+BOOST_AUTO_TEST_CASE(testMissingSegmentsAreBlackInYUV)
+{
+#ifndef DEFLECT_USE_LEGACY_LIBJPEGTURBO
+    const int subsamp = 2;
+    const auto frame = createTestFrame({640, 900}, subsamp);
+
+    // Only the first segment was sent to this process by the master
+    for (size_t i = 1; i < frame->segments.size(); ++i)
+        frame->segments[i].imageData.clear();
+
+    PixelStreamAssembler assembler{frame};
+    deflect::SegmentDecoder decoder;
+
+    const auto image0 = assembler.getTileImage(0, decoder);
+    BOOST_REQUIRE_EQUAL((int)image0->getFormat(),
+                        (int)getTextureFormat(subsamp));
+    const auto dataY = image0->getData(0);
+    const auto dataU = image0->getData(1);
+    BOOST_CHECK_EQUAL(dataY[SEGMENT_SIZE], 0);
+    BOOST_CHECK_EQUAL(dataU[SEGMENT_SIZE / 2], 128);
+    BOOST_CHECK_EQUAL(image0->getData(2)[image0->getDataSize(2) - 1], 128);
+
+    const auto image3 = assembler.getTileImage(3, decoder);
+    BOOST_REQUIRE_EQUAL((int)image3->getFormat(),
+                        (int)getTextureFormat(subsamp));
+    const auto sizeY = image3->getDataSize(0);
+    const auto sizeUV = image3->getDataSize(1);
+    BOOST_CHECK_EQUAL(sizeUV, sizeY / 4);
+    BOOST_CHECK(std::all_of(image3->getData(0), image3->getData(0) + sizeY,
+                            [](uint8_t y) { return y == 0; }));
+    BOOST_CHECK(std::all_of(image3->getData(1), image3->getData(1) + sizeUV,
+                            [](uint8_t u) { return u == 128; }));
+    BOOST_CHECK(std::all_of(image3->getData(2), image3->getData(2) + sizeUV,
+                            [](uint8_t v) { return v == 128; }));
+#endif
+}
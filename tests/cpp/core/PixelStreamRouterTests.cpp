@@ -0,0 +1,207 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE PixelStreamRouterTests
+#include <boost/test/unit_test.hpp>
+
+#include "MinimalGlobalQtApp.h"
+
+#include "Configuration.h"
+#include "network/PixelStreamRouter.h"
+#include "scene/ContentFactory.h"
+#include "scene/ContentWindow.h"
+#include "scene/DisplayGroup.h"
+
+#include <deflect/Frame.h>
+
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+namespace
+{
+const QString CONFIG_TEST_FILENAME("./configuration.xml");
+const QString STREAM_URI("testStream");
+const int SEGMENT_SIZE = 512;
+
+// 2x2 segments of 512x512
+deflect::Frame createFrame()
+{
+    deflect::Frame frame;
+    frame.uri = STREAM_URI;
+    for (int y = 0; y < 2; ++y)
+    {
+        for (int x = 0; x < 2; ++x)
+        {
+            deflect::Segment segment;
+            segment.parameters.x = x * SEGMENT_SIZE;
+            segment.parameters.y = y * SEGMENT_SIZE;
+            segment.parameters.width = SEGMENT_SIZE;
+            segment.parameters.height = SEGMENT_SIZE;
+            segment.imageData = QByteArray(16, 'x');
+            frame.segments.push_back(segment);
+        }
+    }
+    return frame;
+}
+
+size_t countSegmentsWithData(const deflect::Frame& frame)
+{
+    return std::count_if(frame.segments.begin(), frame.segments.end(),
+                         [](const deflect::Segment& segment) {
+                             return !segment.imageData.isEmpty();
+                         });
+}
+
+struct Fixture
+{
+    Configuration config{CONFIG_TEST_FILENAME};
+    DisplayGroupPtr group{new DisplayGroup(config.getTotalSize())};
+    ContentWindowPtr window{boost::make_shared<ContentWindow>(
+        ContentFactory::getPixelStreamContent(STREAM_URI))};
+    PixelStreamRouter router{config};
+
+    Fixture()
+    {
+        window->setCoordinates(QRectF(100, 100, 1024, 1024));
+        group->addContentWindow(window);
+    }
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testUnknownStreamIsBroadcast, Fixture)
+{
+    BOOST_CHECK(router.split(createFrame()).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(testFrameIsSplitForVisibleProcesses, Fixture)
+{
+    router.updateGeometry(*group);
+
+    const auto frames = router.split(createFrame());
+    BOOST_REQUIRE_EQUAL(frames.size(), config.getWallProcessCount());
+
+    for (const auto& frame : frames)
+    {
+        BOOST_CHECK_EQUAL(frame->uri, STREAM_URI);
+        BOOST_CHECK_EQUAL(frame->segments.size(), 4);
+    }
+
+    // The window overlaps the first and (just) the second screen vertically
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[0]), 4);
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[1]), 2);
+    BOOST_CHECK(frames[1]->segments[0].imageData.isEmpty());
+    BOOST_CHECK(frames[1]->segments[1].imageData.isEmpty());
+    for (size_t i = 2; i < frames.size(); ++i)
+        BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[i]), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(testPreviousGeometryIsKeptForOneFrame, Fixture)
+{
+    router.updateGeometry(*group);
+    router.split(createFrame());
+
+    window->setCoordinates(QRectF(4000, 2300, 512, 512));
+    router.updateGeometry(*group);
+
+    auto frames = router.split(createFrame());
+    BOOST_REQUIRE_EQUAL(frames.size(), config.getWallProcessCount());
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[0]), 4);
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[5]), 4);
+
+    frames = router.split(createFrame());
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[0]), 0);
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[5]), 4);
+}
+
+BOOST_FIXTURE_TEST_CASE(testOnlyTheLastPreviousGeometryIsKept, Fixture)
+{
+    router.updateGeometry(*group);
+    router.split(createFrame());
+
+    window->setCoordinates(QRectF(100, 2300, 512, 512));
+    router.updateGeometry(*group);
+    window->setCoordinates(QRectF(4000, 2300, 512, 512));
+    router.updateGeometry(*group);
+    router.updateGeometry(*group);
+
+    const auto frames = router.split(createFrame());
+    BOOST_REQUIRE_EQUAL(frames.size(), config.getWallProcessCount());
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[0]), 0);
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[2]), 4);
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[5]), 4);
+}
+
+BOOST_FIXTURE_TEST_CASE(testGeometryOfClosedStreamIsForgotten, Fixture)
+{
+    router.updateGeometry(*group);
+
+    group->removeContentWindow(window);
+    router.updateGeometry(*group);
+
+    window->setCoordinates(QRectF(4000, 2300, 512, 512));
+    group->addContentWindow(window);
+    router.updateGeometry(*group);
+
+    const auto frames = router.split(createFrame());
+    BOOST_REQUIRE_EQUAL(frames.size(), config.getWallProcessCount());
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[0]), 0);
+    BOOST_CHECK_EQUAL(countSegmentsWithData(*frames[5]), 4);
+}
+
+BOOST_FIXTURE_TEST_CASE(testHiddenWindowIsNotSent, Fixture)
+{
+    window->setState(ContentWindow::HIDDEN);
+    router.updateGeometry(*group);
+
+    const auto frames = router.split(createFrame());
+    BOOST_REQUIRE_EQUAL(frames.size(), config.getWallProcessCount());
+    for (const auto& frame : frames)
+        BOOST_CHECK_EQUAL(countSegmentsWithData(*frame), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(testLargeWindowIsBroadcast, Fixture)
+{
+    window->setCoordinates(QRectF(QPointF(), config.getTotalSize()));
+    router.updateGeometry(*group);
+    BOOST_CHECK(router.split(createFrame()).empty());
+
+    router.setBroadcastThreshold(1.5);
+    BOOST_CHECK_EQUAL(router.split(createFrame()).size(),
+                      config.getWallProcessCount());
+}
@@ -132,3 +132,33 @@ BOOST_AUTO_TEST_CASE(testUpdateAndSyncAlwaysWithCallback)
     BOOST_CHECK_EQUAL(*result, *ptr);
     BOOST_CHECK_EQUAL(result.get(), ptr.get());
 }
+
+BOOST_AUTO_TEST_CASE(testSyncWithFrameSync)
+{
+    IntPtr ptr(new int);
+    *ptr = 5;
+
+    SwapSyncObject<IntPtr> syncObject;
+    syncObject.update(ptr);
+    BOOST_CHECK_EQUAL(syncObject.getVersion(), 1);
+
+    const auto sameOnAllProcesses = [](const std::vector<int64_t>& values) {
+        return values;
+    };
+
+    FrameSync frameSync;
+    syncObject.sync(frameSync);
+    BOOST_CHECK_EQUAL(syncObject.get(), IntPtr());
+    frameSync.resolve(sameOnAllProcesses);
+    BOOST_CHECK_EQUAL(syncObject.get(), ptr);
+
+    const auto otherProcessAhead = [](const std::vector<int64_t>& values) {
+        return std::vector<int64_t>{values[0], values[1] - 1};
+    };
+
+    IntPtr otherPtr(new int);
+    syncObject.update(otherPtr);
+    syncObject.sync(frameSync);
+    frameSync.resolve(otherProcessAhead);
+    BOOST_CHECK_EQUAL(syncObject.get(), ptr);
+}
@@ -55,10 +55,13 @@ public:
     virtual void setCoord(const QRectF& rect) { coord = rect; }
     virtual void uploadTexture(const Image& im) { image = &im; }
     virtual void swap() { swapped = true; }
+    virtual void setMipmaps(bool enabled) { mipmaps = enabled; }
+    virtual size_t takeSkippedMipmapTexels() { return 0; }
     TextureFormat format;
     QRectF coord;
     const Image* image = nullptr;
     bool swapped = false;
+    bool mipmaps = true;
 };
 
 class MockTextureNodeFactory : public TextureNodeFactory
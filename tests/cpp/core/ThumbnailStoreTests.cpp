@@ -0,0 +1,171 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE ThumbnailStoreTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "thumbnail/ThumbnailStore.h"
+#include "thumbnail/thumbnail.h"
+
+#include "MinimalGlobalQtApp.h"
+#include "imageFiles.h"
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+#include <QFile>
+#include <QTemporaryDir>
+
+namespace
+{
+const QSize thumbnailSize{64, 64};
+const qint64 unlimited = 1 << 30;
+
+struct Fixture : ImageFilesFixture
+{
+    QTemporaryDir storeDir;
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testStoredThumbnailIsReturned, Fixture)
+{
+    const auto file = createFile("image.png");
+    const auto thumbnail = makeImage(thumbnailSize, 7);
+
+    ThumbnailStore store{storeDir.path(), unlimited};
+    BOOST_CHECK(!store.contains(file, thumbnailSize));
+    BOOST_CHECK(store.load(file, thumbnailSize).isNull());
+
+    BOOST_REQUIRE(store.save(file, thumbnailSize, thumbnail));
+    BOOST_CHECK(store.contains(file, thumbnailSize));
+    BOOST_CHECK(store.load(file, thumbnailSize) == thumbnail);
+    BOOST_CHECK_GT(store.getSize(), 0);
+
+    BOOST_CHECK(!store.contains(file, QSize(32, 32)));
+}
+
+BOOST_FIXTURE_TEST_CASE(testModifiedFileIsNotServedOldThumbnail, Fixture)
+{
+    const auto file = createFile("image.png");
+
+    ThumbnailStore store{storeDir.path(), unlimited};
+    BOOST_REQUIRE(store.save(file, thumbnailSize, makeImage(thumbnailSize, 7)));
+
+    createFile("image.png", QSize(256, 128));
+    BOOST_CHECK(!store.contains(file, thumbnailSize));
+    BOOST_CHECK(store.load(file, thumbnailSize).isNull());
+}
+
+BOOST_FIXTURE_TEST_CASE(testThumbnailsPersistAcrossSessions, Fixture)
+{
+    const auto file = createFile("image.png");
+    const auto thumbnail = makeImage(thumbnailSize, 7);
+
+    qint64 size = 0;
+    {
+        ThumbnailStore store{storeDir.path(), unlimited};
+        BOOST_REQUIRE(store.save(file, thumbnailSize, thumbnail));
+        size = store.getSize();
+    }
+
+    ThumbnailStore store{storeDir.path(), unlimited};
+    BOOST_CHECK_EQUAL(store.getSize(), size);
+    BOOST_CHECK(store.load(file, thumbnailSize) == thumbnail);
+}
+
+BOOST_FIXTURE_TEST_CASE(testLeastRecentlyUsedThumbnailIsEvicted, Fixture)
+{
+    const auto file1 = createFile("image1.png");
+    const auto file2 = createFile("image2.png");
+    const auto file3 = createFile("image3.png");
+    const auto thumbnail = makeImage(thumbnailSize, 7);
+
+    qint64 entrySize = 0;
+    {
+        QTemporaryDir dir;
+        ThumbnailStore store{dir.path(), unlimited};
+        store.save(file1, thumbnailSize, thumbnail);
+        entrySize = store.getSize();
+    }
+
+    ThumbnailStore store{storeDir.path(), entrySize * 5 / 2};
+    BOOST_REQUIRE(store.save(file1, thumbnailSize, thumbnail));
+    BOOST_REQUIRE(store.save(file2, thumbnailSize, thumbnail));
+    BOOST_REQUIRE(!store.load(file1, thumbnailSize).isNull());
+
+    BOOST_REQUIRE(store.save(file3, thumbnailSize, thumbnail));
+    BOOST_CHECK_EQUAL(store.getSize(), 2 * entrySize);
+    BOOST_CHECK(store.contains(file1, thumbnailSize));
+    BOOST_CHECK(!store.contains(file2, thumbnailSize));
+    BOOST_CHECK(store.contains(file3, thumbnailSize));
+}
+
+BOOST_FIXTURE_TEST_CASE(testCreateUsesTheStore, Fixture)
+{
+    const auto file = createFile("image.png");
+    auto store = std::make_shared<ThumbnailStore>(storeDir.path(), unlimited);
+
+    thumbnail::setStore(store);
+    const auto image = thumbnail::create(file, thumbnailSize);
+    thumbnail::setStore(nullptr);
+
+    BOOST_CHECK(store->contains(file, thumbnailSize));
+    const auto stored = store->load(file, thumbnailSize);
+    BOOST_CHECK(stored.convertToFormat(QImage::Format_ARGB32) ==
+                image.convertToFormat(QImage::Format_ARGB32));
+}
+
+BOOST_FIXTURE_TEST_CASE(testPlaceholdersAreNotStored, Fixture)
+{
+    const auto file = files.path() + "/corrupted.png";
+    QFile corrupted{file};
+    BOOST_REQUIRE(corrupted.open(QIODevice::WriteOnly));
+    corrupted.write("not an image");
+    corrupted.close();
+
+    auto store = std::make_shared<ThumbnailStore>(storeDir.path(), unlimited);
+
+    thumbnail::setStore(store);
+    const auto image = thumbnail::create(file, thumbnailSize);
+    BOOST_CHECK(!thumbnail::isStored(file, thumbnailSize));
+    thumbnail::setStore(nullptr);
+
+    BOOST_CHECK(!image.isNull());
+    BOOST_CHECK_EQUAL(store->getSize(), 0);
+}
@@ -0,0 +1,134 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE TiffPyramidWriterTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "data/TiffPyramidReader.h"
+#include "data/TiffPyramidWriter.h"
+#include "types.h"
+
+#include "MinimalGlobalQtApp.h"
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+#include <QTemporaryDir>
+
+namespace
+{
+const QSize imageSize{700, 300};
+const int tileSize = 256;
+const int quality = 90;
+
+QColor getTileColor(const int i, const int j, const uint lod)
+{
+    return QColor(i * 100, j * 100, lod * 100);
+}
+
+bool isClose(const QColor& a, const QColor& b)
+{
+    // JPEG compression is lossy
+    const int tolerance = 8;
+    return std::abs(a.red() - b.red()) < tolerance &&
+           std::abs(a.green() - b.green()) < tolerance &&
+           std::abs(a.blue() - b.blue()) < tolerance;
+}
+
+void writePyramid(const QString& uri)
+{
+    TiffPyramidWriter writer{uri, imageSize, tileSize};
+    for (uint lod = 0; lod <= writer.getTopPyramidLevel(); ++lod)
+    {
+        writer.startLevel(lod);
+        const auto tilesCount = writer.getTilesCount(lod);
+        for (int j = 0; j < tilesCount.height(); ++j)
+        {
+            for (int i = 0; i < tilesCount.width(); ++i)
+            {
+                QImage tile{tileSize, tileSize, QImage::Format_RGB32};
+                tile.fill(getTileColor(i, j, lod));
+                const auto jpeg = TiffPyramidWriter::encodeTile(tile, quality);
+                writer.writeTile(i, j, jpeg);
+            }
+        }
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(testPyramidLevels)
+{
+    QTemporaryDir dir;
+    TiffPyramidWriter writer{dir.path() + "/pyramid.tif", imageSize, tileSize};
+
+    BOOST_CHECK_EQUAL(writer.getTileSize(), tileSize);
+    BOOST_CHECK_EQUAL(writer.getTopPyramidLevel(), 2u);
+    BOOST_CHECK_EQUAL(writer.getLevelSize(0), imageSize);
+    BOOST_CHECK_EQUAL(writer.getLevelSize(1), QSize(350, 150));
+    BOOST_CHECK_EQUAL(writer.getLevelSize(2), QSize(175, 75));
+    BOOST_CHECK_EQUAL(writer.getTilesCount(0), QSize(3, 2));
+    BOOST_CHECK_EQUAL(writer.getTilesCount(1), QSize(2, 1));
+    BOOST_CHECK_EQUAL(writer.getTilesCount(2), QSize(1, 1));
+
+    BOOST_CHECK_THROW(writer.startLevel(1), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(testWrittenPyramidCanBeRead)
+{
+    QTemporaryDir dir;
+    const auto uri = dir.path() + "/pyramid.tif";
+    writePyramid(uri);
+
+    TiffPyramidReader reader{uri};
+    BOOST_CHECK_EQUAL(reader.getImageSize(), imageSize);
+    BOOST_CHECK_EQUAL(reader.getTileSize(), QSize(tileSize, tileSize));
+    BOOST_CHECK_EQUAL(reader.getBytesPerPixel(), 3);
+    BOOST_CHECK_EQUAL(reader.findTopPyramidLevel(), 2u);
+    BOOST_CHECK_EQUAL(reader.readSize(1), QSize(350, 150));
+
+    for (uint lod = 0; lod <= 1; ++lod)
+    {
+        const auto tile = reader.readTile(1, 0, lod);
+        BOOST_REQUIRE_EQUAL(tile.size(), QSize(tileSize, tileSize));
+        BOOST_CHECK(isClose(tile.pixel(10, 10), getTileColor(1, 0, lod)));
+    }
+    const auto top = reader.readTopLevelImage();
+    BOOST_CHECK_EQUAL(top.size(), QSize(175, 75));
+    BOOST_CHECK(isClose(top.pixel(10, 10), getTileColor(0, 0, 2)));
+}
@@ -0,0 +1,176 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE TileCacheTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "TileCache.h"
+
+namespace
+{
+const QSize tileSize{64, 64};
+const size_t tileBytes = 64 * 64 * 4;
+const int source1 = 1;
+const int source2 = 2;
+const auto s1 = TileCache::SourceId{&source1};
+const auto s2 = TileCache::SourceId{&source2};
+
+QImage makeTile()
+{
+    QImage image{tileSize, QImage::Format_ARGB32};
+    image.fill(Qt::red);
+    return image;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testHitsAndMisses)
+{
+    TileCache cache{10 * tileBytes};
+
+    BOOST_CHECK(cache.get(s1, 0).isNull());
+    cache.insert(s1, 0, 0, makeTile());
+    BOOST_CHECK(!cache.get(s1, 0).isNull());
+    BOOST_CHECK(cache.get(s2, 0).isNull());
+    BOOST_CHECK(cache.contains(s1, 0));
+    BOOST_CHECK(!cache.contains(s1, 1));
+
+    BOOST_CHECK_EQUAL(cache.getHits(), 1);
+    BOOST_CHECK_EQUAL(cache.getMisses(), 2);
+    BOOST_CHECK_EQUAL(cache.getEvictions(), 0);
+    BOOST_CHECK_EQUAL(cache.getSize(), tileBytes);
+    BOOST_CHECK_EQUAL(cache.getTilesCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(testLeastRecentlyUsedTilesAreEvicted)
+{
+    TileCache cache{3 * tileBytes};
+    cache.insert(s1, 0, 0, makeTile());
+    cache.insert(s1, 1, 0, makeTile());
+    cache.insert(s1, 2, 0, makeTile());
+    cache.get(s1, 0);
+
+    cache.insert(s1, 3, 0, makeTile());
+    BOOST_CHECK_EQUAL(cache.getTilesCount(), 3);
+    BOOST_CHECK_EQUAL(cache.getEvictions(), 1);
+    BOOST_CHECK(cache.contains(s1, 0));
+    BOOST_CHECK(!cache.contains(s1, 1));
+    BOOST_CHECK(cache.contains(s1, 2));
+    BOOST_CHECK(cache.contains(s1, 3));
+    BOOST_CHECK_LE(cache.getSize(), cache.getMaxSize());
+}
+
+BOOST_AUTO_TEST_CASE(testVisibleTilesAreNotEvicted)
+{
+    TileCache cache{2 * tileBytes};
+    cache.insert(s1, 0, 0, makeTile());
+    cache.insert(s1, 1, 0, makeTile());
+    cache.setVisibleTiles(s1, {0, 1}, {0});
+
+    // The cache exceeds its size rather than evicting visible tiles
+    cache.insert(s1, 2, 0, makeTile());
+    BOOST_CHECK_EQUAL(cache.getTilesCount(), 3);
+    BOOST_CHECK_EQUAL(cache.getEvictions(), 0);
+
+    cache.setVisibleTiles(s1, {1}, {0});
+    cache.insert(s1, 3, 0, makeTile());
+    BOOST_CHECK(!cache.contains(s1, 0));
+    BOOST_CHECK(cache.contains(s1, 1));
+    BOOST_CHECK(!cache.contains(s1, 2));
+    BOOST_CHECK(cache.contains(s1, 3));
+    BOOST_CHECK_EQUAL(cache.getEvictions(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(testTilesAtDistantLodsAreEvictedFirst)
+{
+    TileCache cache{3 * tileBytes};
+    cache.insert(s1, 0, 0, makeTile()); // lod 0, least recently used
+    cache.insert(s1, 10, 3, makeTile());
+    cache.insert(s1, 5, 1, makeTile());
+    cache.setVisibleTiles(s1, {5}, {1});
+
+    cache.insert(s1, 6, 1, makeTile());
+    BOOST_CHECK(cache.contains(s1, 0));
+    BOOST_CHECK(!cache.contains(s1, 10));
+    BOOST_CHECK(cache.contains(s1, 5));
+    BOOST_CHECK(cache.contains(s1, 6));
+}
+
+BOOST_AUTO_TEST_CASE(testTilesOfHiddenSourcesAreEvictedFirst)
+{
+    TileCache cache{2 * tileBytes};
+    cache.insert(s1, 0, 0, makeTile());
+    cache.insert(s2, 0, 0, makeTile());
+    cache.setVisibleTiles(s2, {1}, {0});
+
+    cache.insert(s2, 1, 0, makeTile());
+    BOOST_CHECK(!cache.contains(s1, 0));
+    BOOST_CHECK(cache.contains(s2, 0));
+    BOOST_CHECK(cache.contains(s2, 1));
+}
+
+BOOST_AUTO_TEST_CASE(testRemoveSource)
+{
+    TileCache cache{10 * tileBytes};
+    cache.insert(s1, 0, 0, makeTile());
+    cache.insert(s1, 1, 0, makeTile());
+    cache.insert(s2, 0, 0, makeTile());
+
+    cache.remove(s1);
+    BOOST_CHECK(!cache.contains(s1, 0));
+    BOOST_CHECK(!cache.contains(s1, 1));
+    BOOST_CHECK(cache.contains(s2, 0));
+    BOOST_CHECK_EQUAL(cache.getSize(), tileBytes);
+}
+
+BOOST_AUTO_TEST_CASE(testReduceMaxSizeAndTooLargeImages)
+{
+    TileCache cache{4 * tileBytes};
+    for (uint i = 0; i < 4; ++i)
+        cache.insert(s1, i, 0, makeTile());
+
+    cache.setMaxSize(2 * tileBytes);
+    BOOST_CHECK_EQUAL(cache.getTilesCount(), 2);
+    BOOST_CHECK_EQUAL(cache.getEvictions(), 2);
+
+    cache.insert(s2, 0, 0, QImage{QSize{128, 128}, QImage::Format_ARGB32});
+    BOOST_CHECK(!cache.contains(s2, 0));
+    BOOST_CHECK_EQUAL(cache.getTilesCount(), 2);
+}
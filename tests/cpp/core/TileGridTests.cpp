@@ -0,0 +1,109 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE TileGridTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "TileGrid.h"
+
+namespace
+{
+// Segments of a 1000x700 stream, smaller at the right and bottom borders
+std::vector<QRect> makeSegments(const int size)
+{
+    std::vector<QRect> segments;
+    for (int y = 0; y < 700; y += size)
+        for (int x = 0; x < 1000; x += size)
+            segments.emplace_back(x, y, std::min(size, 1000 - x),
+                                  std::min(size, 700 - y));
+    return segments;
+}
+
+Indices bruteForce(const std::vector<QRect>& tiles, const QRectF& area)
+{
+    Indices visibleSet;
+    for (size_t i = 0; i < tiles.size(); ++i)
+        if (area.intersects(tiles[i]))
+            visibleSet.insert(i);
+    return visibleSet;
+}
+}
+
+BOOST_AUTO_TEST_CASE(testVisibleSetMatchesLinearSearch)
+{
+    const auto segments = makeSegments(64);
+    const TileGrid grid{segments};
+
+    const std::vector<QRectF> areas{
+        {0, 0, 1000, 700},   {0, 0, 64, 64},       {64, 64, 64, 64},
+        {63.5, 10, 1, 1},    {990, 690, 100, 100}, {-50, -50, 100, 300},
+        {250, 300, 333, 17}, {1000, 0, 10, 10},    {0, 0, 0, 0}};
+    for (const auto& area : areas)
+    {
+        const auto expected = bruteForce(segments, area);
+        const auto visibleSet = grid.computeVisibleSet(area);
+        BOOST_CHECK_EQUAL_COLLECTIONS(visibleSet.begin(), visibleSet.end(),
+                                      expected.begin(), expected.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testIrregularLayout)
+{
+    // A large segment next to small ones spans several cells
+    const std::vector<QRect> segments{{0, 0, 512, 512},
+                                      {512, 0, 64, 64},
+                                      {576, 0, 64, 64},
+                                      {512, 64, 128, 448},
+                                      {0, 512, 640, 10}};
+    const TileGrid grid{segments};
+
+    BOOST_CHECK(grid.computeVisibleSet({600, 10, 10, 10}) == Indices({2}));
+    BOOST_CHECK(grid.computeVisibleSet({500, 500, 20, 20}) ==
+                Indices({0, 3, 4}));
+    BOOST_CHECK(grid.computeVisibleSet({1000, 1000, 10, 10}).empty());
+    BOOST_CHECK_EQUAL(grid.getTiles().size(), segments.size());
+}
+
+BOOST_AUTO_TEST_CASE(testEmptyGrid)
+{
+    const TileGrid grid{std::vector<QRect>()};
+    BOOST_CHECK(grid.computeVisibleSet({0, 0, 100, 100}).empty());
+}
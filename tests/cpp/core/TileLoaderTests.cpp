@@ -0,0 +1,259 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE TileLoaderTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "DataSource.h"
+#include "TileLoader.h"
+
+#include <QMutex>
+#include <QSemaphore>
+#include <QThread>
+
+namespace
+{
+class DummySource : public DataSource
+{
+public:
+    explicit DummySource(const bool dynamic = false)
+        : _dynamic{dynamic}
+    {
+    }
+    bool isDynamic() const final { return _dynamic; }
+    ImagePtr getTileImage(uint, deflect::View) const final { return {}; }
+    QRect getTileRect(uint) const final { return QRect(); }
+    QSize getTilesArea(uint) const final { return QSize(); }
+    Indices computeVisibleSet(const QRectF&, uint) const final { return {}; }
+    uint getMaxLod() const final { return 0; }
+private:
+    bool _dynamic;
+};
+
+// The loader only looks at the lifetime of the tiles, which are QQuickItems
+TilePtr makeTileHandle()
+{
+    return TilePtr(std::make_shared<int>(0), static_cast<Tile*>(nullptr));
+}
+
+TileLoader::TileUpdateList makeTiles(TilePtr tile)
+{
+    return {{tile, deflect::View::mono}};
+}
+
+TileLoader::Priority makePriority(const bool visible, const uint lod)
+{
+    TileLoader::Priority priority;
+    priority.visible = visible;
+    priority.lod = lod;
+    return priority;
+}
+
+const uint blockingTileId = 999;
+}
+
+struct Fixture
+{
+    struct Load
+    {
+        const DataSource* source;
+        uint tileId;
+        size_t tilesCount;
+    };
+
+    TileLoader::LoadFunc load = [this](const DataSource& source,
+                                       const uint tileId,
+                                       const TileLoader::TileUpdateList& t) {
+        if (tileId >= blockingTileId)
+            gate.acquire();
+        const QMutexLocker lock(&mutex);
+        loads.push_back({&source, tileId, t.size()});
+    };
+
+    std::vector<Load> getLoads()
+    {
+        const QMutexLocker lock(&mutex);
+        return loads;
+    }
+
+    bool waitForLoad(const uint tileId)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            for (const auto& load : getLoads())
+                if (load.tileId == tileId)
+                    return true;
+            QThread::msleep(10);
+        }
+        return false;
+    }
+
+    // The loader cancels the queued requests when destroyed, so tests must
+    // wait for the loads they expect before that
+    bool waitForLoads(const size_t count)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            if (getLoads().size() >= count)
+                return true;
+            QThread::msleep(10);
+        }
+        return false;
+    }
+
+    std::shared_ptr<DataSource> source = std::make_shared<DummySource>();
+    TilePtr tile = makeTileHandle();
+    QSemaphore gate;
+    QMutex mutex;
+    std::vector<Load> loads;
+};
+
+BOOST_FIXTURE_TEST_CASE(testQueuedRequestsForSameTileAreMerged, Fixture)
+{
+    {
+        TileLoader loader{load, 1, 1};
+        loader.request(source, blockingTileId, makeTiles(tile), {});
+        loader.request(source, 1, makeTiles(tile), {});
+        loader.request(source, 1, makeTiles(makeTileHandle()), {});
+        loader.request(source, 2, makeTiles(tile), {});
+
+        const auto stats = loader.takeStatistics();
+        BOOST_CHECK_EQUAL(stats.merged, 1u);
+        BOOST_CHECK_EQUAL(stats.queued, 2u);
+        BOOST_CHECK_EQUAL(stats.running, 1u);
+        gate.release();
+        BOOST_CHECK(waitForLoads(3));
+    }
+    const auto loads = getLoads();
+    BOOST_REQUIRE_EQUAL(loads.size(), 3u);
+    BOOST_CHECK_EQUAL(loads[1].tileId, 1u);
+    BOOST_CHECK_EQUAL(loads[1].tilesCount, 2u);
+    BOOST_CHECK_EQUAL(loads[2].tileId, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(testRequestsStartByPriority, Fixture)
+{
+    auto dynamicSource = std::make_shared<DummySource>(true);
+    {
+        TileLoader loader{load, 1, 1};
+        loader.request(source, blockingTileId, makeTiles(tile), {});
+        loader.request(source, 1, makeTiles(tile), makePriority(false, 0));
+        loader.request(source, 2, makeTiles(tile), makePriority(true, 0));
+        loader.request(source, 3, makeTiles(tile), makePriority(true, 2));
+        auto dynamic = makePriority(false, 0);
+        dynamic.dynamic = true;
+        loader.request(dynamicSource, 4, makeTiles(tile), dynamic);
+        loader.request(source, 5, makeTiles(tile), makePriority(true, 2));
+        gate.release();
+        BOOST_CHECK(waitForLoads(6));
+    }
+    const auto loads = getLoads();
+    BOOST_REQUIRE_EQUAL(loads.size(), 6u);
+    BOOST_CHECK_EQUAL(loads[1].tileId, 4u);
+    BOOST_CHECK_EQUAL(loads[1].source, dynamicSource.get());
+    BOOST_CHECK_EQUAL(loads[2].tileId, 3u);
+    BOOST_CHECK_EQUAL(loads[3].tileId, 5u);
+    BOOST_CHECK_EQUAL(loads[4].tileId, 2u);
+    BOOST_CHECK_EQUAL(loads[5].tileId, 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(testRequestsForDestroyedTilesAreCancelled, Fixture)
+{
+    {
+        TileLoader loader{load, 1, 1};
+        loader.request(source, blockingTileId, makeTiles(tile), {});
+
+        auto leavingTile = makeTileHandle();
+        loader.request(source, 1, makeTiles(leavingTile), {});
+        loader.request(source, 2, makeTiles(tile), {});
+        leavingTile.reset();
+        loader.cancelExpired();
+
+        const auto stats = loader.takeStatistics();
+        BOOST_CHECK_EQUAL(stats.cancelled, 1u);
+        BOOST_CHECK_EQUAL(stats.queued, 1u);
+        gate.release();
+        BOOST_CHECK(waitForLoads(2));
+    }
+    const auto loads = getLoads();
+    BOOST_REQUIRE_EQUAL(loads.size(), 2u);
+    BOOST_CHECK_EQUAL(loads[1].tileId, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(testSourceAloneUsesAllThreads, Fixture)
+{
+    {
+        TileLoader loader{load, 2, 1};
+        loader.request(source, blockingTileId, makeTiles(tile), {});
+        loader.request(source, blockingTileId + 1, makeTiles(tile), {});
+
+        const auto stats = loader.takeStatistics();
+        BOOST_CHECK_EQUAL(stats.running, 2u);
+        BOOST_CHECK_EQUAL(stats.queued, 0u);
+        gate.release(2);
+        BOOST_CHECK(waitForLoads(2));
+    }
+    BOOST_CHECK_EQUAL(getLoads().size(), 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(testConcurrentLoadsPerSourceAreBounded, Fixture)
+{
+    auto otherSource = std::make_shared<DummySource>();
+    {
+        TileLoader loader{load, 2, 1};
+        loader.request(source, blockingTileId, makeTiles(tile), {});
+        loader.request(source, blockingTileId + 1, makeTiles(tile), {});
+        loader.request(source, 1, makeTiles(tile), {});
+        loader.request(otherSource, 2, makeTiles(tile), {});
+        BOOST_CHECK_EQUAL(loader.takeStatistics().queued, 2u);
+
+        // The other source gets the first free thread although it requested
+        // later, then the source gets it back once the other one is done
+        gate.release();
+        BOOST_CHECK(waitForLoads(3));
+        gate.release();
+        BOOST_CHECK(waitForLoads(4));
+    }
+    const auto loads = getLoads();
+    BOOST_REQUIRE_EQUAL(loads.size(), 4u);
+    BOOST_CHECK_EQUAL(loads[1].tileId, 2u);
+    BOOST_CHECK_EQUAL(loads[2].tileId, 1u);
+}
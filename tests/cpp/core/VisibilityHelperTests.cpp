@@ -59,7 +59,6 @@ struct Fixture
     Fixture()
         : group(new DisplayGroup(groupSize))
         , content(new DummyContent)
-        , helper(*group, viewRect)
     {
         content->setDimensions(size);
         window = boost::make_shared<ContentWindow>(content);
@@ -72,7 +71,20 @@ struct Fixture
     DisplayGroupPtr group;
     ContentPtr content;
     ContentWindowPtr window;
-    VisibilityHelper helper;
+
+    // The helper is a snapshot of the group, create a new one for each check
+    QRectF getVisibleArea(const ContentWindow& win) const
+    {
+        return VisibilityHelper{*group, viewRect}.getVisibleArea(win);
+    }
+    QRegion getVisibleRegion(const ContentWindow& win) const
+    {
+        return VisibilityHelper{*group, viewRect}.getVisibleRegion(win);
+    }
+    bool isInVisibleArea(const ContentWindow& win) const
+    {
+        return VisibilityHelper{*group, viewRect}.isInVisibleArea(win);
+    }
 };
 
 BOOST_FIXTURE_TEST_CASE(testSingleWindow, Fixture)
@@ -80,34 +92,34 @@ BOOST_FIXTURE_TEST_CASE(testSingleWindow, Fixture)
     const QRectF& coord = window->getCoordinates();
 
     // Fully inside
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), coord);
 
     // Fully outside
     window->setCoordinates(QRectF(QPointF(400, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), QRectF());
 
     // Half-inside horizontally
     window->setCoordinates(QRectF(QPointF(300, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 200)));
 
     window->setCoordinates(QRectF(QPointF(-100, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(100, 0), QSize(100, 200)));
 
     // Half-inside vertically, bottom cut
     window->setCoordinates(QRectF(QPointF(0, 500), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(200, 100)));
 
     // Half-inside vertically, top cut
     window->setCoordinates(QRectF(QPointF(0, -100), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 100), QSize(200, 100)));
 
     // Corner view cut
     window->setCoordinates(QRectF(QPointF(300, 500), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 100)));
 }
 
@@ -120,36 +132,56 @@ BOOST_FIXTURE_TEST_CASE(testSingleWindowCenteredViewRect, Fixture)
                       QRectF(QPointF(50, 50), centeredViewRect.size()));
 }
 
+BOOST_FIXTURE_TEST_CASE(testWindowInVisibleArea, Fixture)
+{
+    BOOST_CHECK(isInVisibleArea(*window));
+
+    // Far outside
+    window->setCoordinates(QRectF(QPointF(1000, 0), size));
+    BOOST_CHECK(!isInVisibleArea(*window));
+
+    // Outside, but close enough for the window decorations to be visible
+    window->setCoordinates(QRectF(QPointF(500, 0), size));
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), QRectF());
+    BOOST_CHECK(isInVisibleArea(*window));
+
+    // Focused inside from outside (transition)
+    window->setCoordinates(QRectF(QPointF(1000, 0), size));
+    window->setFocusedCoordinates(QRectF(QPointF(0, 0), size));
+    window->setMode(ContentWindow::WindowMode::FOCUSED);
+    BOOST_CHECK(isInVisibleArea(*window));
+}
+
 BOOST_FIXTURE_TEST_CASE(testOverlappingWindow, Fixture)
 {
     const QRectF& coord = window->getCoordinates();
-    BOOST_REQUIRE_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_REQUIRE_EQUAL(getVisibleArea(*window), coord);
 
     ContentWindowPtr otherWindow = boost::make_shared<ContentWindow>(content);
     group->addContentWindow(otherWindow);
 
     // Full overlap
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), QRectF());
 
     // Focused
     window->setFocusedCoordinates(coord);
     window->setMode(ContentWindow::WindowMode::FOCUSED);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), coord);
     window->setMode(ContentWindow::WindowMode::STANDARD);
 
     // Half-above horizonally
     otherWindow->setCoordinates(QRectF(QPointF(100, 0), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 200)));
 
     // Half-above vertically
     otherWindow->setCoordinates(QRectF(QPointF(0, 100), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(200, 100)));
 
     // Corner overlap (no cut)
     otherWindow->setCoordinates(QRectF(QPointF(100, 100), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(200, 200)));
 }
 
@@ -159,12 +191,12 @@ BOOST_FIXTURE_TEST_CASE(testUnderlyingWindow, Fixture)
 
     ContentWindowPtr otherWindow = boost::make_shared<ContentWindow>(content);
     group->addContentWindow(otherWindow);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*otherWindow), coord);
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(getVisibleArea(*otherWindow), coord);
 
     group->moveToFront(window);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*otherWindow), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), coord);
+    BOOST_CHECK_EQUAL(getVisibleArea(*otherWindow), QRectF());
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), coord);
 }
 
 BOOST_FIXTURE_TEST_CASE(testViewCutCombinedWithOverlappingWindow, Fixture)
@@ -174,17 +206,17 @@ BOOST_FIXTURE_TEST_CASE(testViewCutCombinedWithOverlappingWindow, Fixture)
 
     // Corner view cut
     window->setCoordinates(QRectF(QPointF(300, 500), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 100)));
 
     // Partial corner overlap (no cut)
     otherWindow->setCoordinates(QRectF(QPointF(150, 350), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window),
+    BOOST_CHECK_EQUAL(getVisibleArea(*window),
                       QRectF(QPointF(0, 0), QSize(100, 100)));
 
     // Full corner overlap
     otherWindow->setCoordinates(QRectF(QPointF(200, 400), size));
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), QRectF());
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), QRectF());
 }
 
 BOOST_FIXTURE_TEST_CASE(testFullscreenWindowOverlapEverything, Fixture)
@@ -193,21 +225,92 @@ BOOST_FIXTURE_TEST_CASE(testFullscreenWindowOverlapEverything, Fixture)
 
     ContentWindowPtr otherWindow = boost::make_shared<ContentWindow>(content);
     group->addContentWindow(otherWindow);
-    BOOST_REQUIRE_EQUAL(helper.getVisibleArea(*window), QRectF());
-    BOOST_REQUIRE_EQUAL(helper.getVisibleArea(*otherWindow), coord);
+    BOOST_REQUIRE_EQUAL(getVisibleArea(*window), QRectF());
+    BOOST_REQUIRE_EQUAL(getVisibleArea(*otherWindow), coord);
 
     // Even a "small" fullscreen window should overlap everything...
     window->setMode(ContentWindow::WindowMode::FULLSCREEN);
     group->setFullscreenWindow(window);
     const QRectF fullscreen(QPointF(), window->getCoordinates().size() / 2);
     window->setFullscreenCoordinates(fullscreen);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*otherWindow), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), fullscreen);
+    BOOST_CHECK_EQUAL(getVisibleArea(*otherWindow), QRectF());
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), fullscreen);
 
     // ...including focused windows
     ContentWindowPtr focusWindow = boost::make_shared<ContentWindow>(content);
     group->addContentWindow(focusWindow);
     group->addFocusedWindow(focusWindow);
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*focusWindow), QRectF());
-    BOOST_CHECK_EQUAL(helper.getVisibleArea(*window), fullscreen);
+    BOOST_CHECK_EQUAL(getVisibleArea(*focusWindow), QRectF());
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), fullscreen);
+}
+
+BOOST_FIXTURE_TEST_CASE(testVisibleRegionOfPartiallyCoveredWindow, Fixture)
+{
+    ContentWindowPtr otherWindow = boost::make_shared<ContentWindow>(content);
+    group->addContentWindow(otherWindow);
+
+    // Corner overlap: L-shaped region
+    otherWindow->setCoordinates(QRectF(QPointF(100, 100), size));
+    const QRegion lShape =
+        QRegion(0, 0, 200, 200).subtracted(QRegion(100, 100, 100, 100));
+    BOOST_CHECK(getVisibleRegion(*window) == lShape);
+    BOOST_CHECK(getVisibleRegion(*otherWindow) == QRegion(0, 0, 200, 200));
+
+    // Small window in the middle: region with a hole
+    otherWindow->setCoordinates(QRectF(QPointF(50, 50), QSizeF(100, 100)));
+    const QRegion hole =
+        QRegion(0, 0, 200, 200).subtracted(QRegion(50, 50, 100, 100));
+    BOOST_CHECK(getVisibleRegion(*window) == hole);
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), window->getCoordinates());
+
+    // Fully covered by the union of two windows, neither of which covers it
+    ContentWindowPtr thirdWindow = boost::make_shared<ContentWindow>(content);
+    group->addContentWindow(thirdWindow);
+    otherWindow->setCoordinates(QRectF(QPointF(0, 0), QSizeF(100, 200)));
+    thirdWindow->setCoordinates(QRectF(QPointF(100, 0), QSizeF(100, 200)));
+    BOOST_CHECK(getVisibleRegion(*window).isEmpty());
+    BOOST_CHECK_EQUAL(getVisibleArea(*window), QRectF());
+}
+
+BOOST_FIXTURE_TEST_CASE(testVisibleRegionWithHiddenWindowsAndPanels, Fixture)
+{
+    ContentWindowPtr panel = boost::make_shared<ContentWindow>(
+        content, ContentWindow::PANEL);
+    group->addContentWindow(panel);
+    ContentWindowPtr otherWindow = boost::make_shared<ContentWindow>(content);
+    group->addContentWindow(otherWindow);
+
+    // Panels are not cut by the standard windows above them...
+    panel->setCoordinates(QRectF(QPointF(100, 0), size));
+    BOOST_CHECK(getVisibleRegion(*panel) == QRegion(0, 0, 200, 200));
+
+    // ...but they cut the windows below them
+    otherWindow->setCoordinates(QRectF(QPointF(0, 300), size));
+    BOOST_CHECK(getVisibleRegion(*window) == QRegion(0, 0, 100, 200));
+
+    // Hidden windows do not occlude
+    panel->setState(ContentWindow::HIDDEN);
+    BOOST_CHECK(getVisibleRegion(*window) == QRegion(0, 0, 200, 200));
+}
+
+BOOST_FIXTURE_TEST_CASE(testVisibleRegionAcrossLargeWall, Fixture)
+{
+    const QRect wallRect(0, 0, 5000, 3000);
+    ContentWindowPtr farWindow = boost::make_shared<ContentWindow>(content);
+    group->addContentWindow(farWindow);
+    ContentWindowPtr largeWindow = boost::make_shared<ContentWindow>(content);
+    group->addContentWindow(largeWindow);
+
+    window->setCoordinates(QRectF(1000, 1000, 200, 200));
+    farWindow->setCoordinates(QRectF(4000, 2000, 200, 200));
+    largeWindow->setCoordinates(QRectF(900, 1100, 2000, 1000));
+
+    // The occluder spans several cells of the grid but only cuts its
+    // neighbour
+    const VisibilityHelper helper{*group, wallRect};
+    BOOST_CHECK(helper.getVisibleRegion(*window) == QRegion(0, 0, 200, 100));
+    BOOST_CHECK(helper.getVisibleRegion(*farWindow) ==
+                QRegion(0, 0, 200, 200));
+    BOOST_CHECK(helper.getVisibleRegion(*largeWindow) ==
+                QRegion(0, 0, 2000, 1000));
 }
@@ -44,6 +44,8 @@
 #include "localstreamer/WebkitPixelStreamer.h"
 
 #include <QDir>
+#include <QEventLoop>
+#include <QTimer>
 #include <QWebElementCollection>
 #include <QWebFrame>
 #include <QWebPage>
@@ -287,3 +289,50 @@ BOOST_AUTO_TEST_CASE(test_localstorage)
 
     delete streamer;
 }
+
+struct ImageUpdate
+{
+    QImage image;
+    QRegion region;
+};
+
+bool waitForImage(WebkitPixelStreamer& streamer, const int timeoutMs,
+                  ImageUpdate* update = nullptr)
+{
+    QEventLoop loop;
+    bool received = false;
+    const auto connection = QObject::connect(
+        &streamer, &PixelStreamer::imageUpdated,
+        [&](QImage image, QRegion region) {
+            received = true;
+            if (update)
+                *update = ImageUpdate{image, region};
+            loop.quit();
+        });
+    QTimer::singleShot(timeoutMs, &loop, SLOT(quit()));
+    loop.exec();
+    QObject::disconnect(connection);
+    return received;
+}
+
+BOOST_AUTO_TEST_CASE(test_only_changes_are_streamed)
+{
+    if (!hasGLXDisplay())
+        return;
+
+    WebkitPixelStreamer streamer(QSize(640, 480), EMPTY_PAGE_URL);
+
+    // the first image covers the whole page
+    ImageUpdate update;
+    BOOST_REQUIRE(waitForImage(streamer, 5000, &update));
+    BOOST_CHECK(update.image.size() == streamer.size());
+    BOOST_CHECK(update.region == QRegion(QRect(QPoint(), streamer.size())));
+
+    // an idle page is not streamed
+    BOOST_CHECK(!waitForImage(streamer, 2500));
+
+    // a change of the page is
+    streamer.getView()->page()->mainFrame()->setHtml(
+        "<body style='background:red'></body>");
+    BOOST_CHECK(waitForImage(streamer, 5000));
+}
@@ -0,0 +1,177 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#define BOOST_TEST_MODULE WindowChangeFeedTests
+
+#include <boost/test/unit_test.hpp>
+
+#include "rest/WindowChangeFeed.h"
+#include "rest/json.h"
+#include "rest/serialization.h"
+#include "scene/ContentWindow.h"
+#include "scene/DisplayGroup.h"
+
+#include "MinimalGlobalQtApp.h"
+BOOST_GLOBAL_FIXTURE(MinimalGlobalQtApp);
+
+#include "DummyContent.h"
+
+#include <zeroeq/http/request.h>
+#include <zeroeq/http/response.h>
+
+#include <QJsonArray>
+
+namespace
+{
+const QSize wallSize{1000, 1000};
+
+ContentWindowPtr makeDummyWindow()
+{
+    ContentPtr content(new DummyContent);
+    content->setDimensions(QSize(512, 512));
+    return boost::make_shared<ContentWindow>(content);
+}
+
+zeroeq::http::Request makeRequest(const std::string& query)
+{
+    zeroeq::http::Request request;
+    request.method = zeroeq::http::Method::GET;
+    request.query = query;
+    return request;
+}
+
+QStringList getUuids(const QJsonArray& array)
+{
+    QStringList uuids;
+    for (const auto& value : array)
+        uuids.append(value.isObject() ? value.toObject()["uuid"].toString()
+                                      : value.toString());
+    return uuids;
+}
+
+struct Fixture
+{
+    Fixture()
+    {
+        group->addContentWindow(window0);
+        group->addContentWindow(window1);
+    }
+
+    DisplayGroupPtr group = boost::make_shared<DisplayGroup>(wallSize);
+    ContentWindowPtr window0 = makeDummyWindow();
+    ContentWindowPtr window1 = makeDummyWindow();
+    WindowChangeFeed feed{*group};
+};
+}
+
+BOOST_FIXTURE_TEST_CASE(testUnchangedWindowsReturnNotModified, Fixture)
+{
+    auto response = feed.getWindows(makeRequest("")).get();
+    BOOST_CHECK_EQUAL(response.code, zeroeq::http::Code::OK);
+
+    const auto object = json::toObject(response.body);
+    const auto version = uint64_t(object["version"].toDouble());
+    BOOST_CHECK_EQUAL(version, feed.getVersion());
+    BOOST_CHECK_EQUAL(object["windows"].toArray().size(), 2);
+
+    const auto query = "version=" + std::to_string(version);
+    response = feed.getWindows(makeRequest(query)).get();
+    BOOST_CHECK_EQUAL(response.code, zeroeq::http::Code::NOT_MODIFIED);
+    BOOST_CHECK(response.body.empty());
+
+    window1->setCoordinates(QRectF(10, 10, 100, 100));
+    response = feed.getWindows(makeRequest(query)).get();
+    BOOST_CHECK_EQUAL(response.code, zeroeq::http::Code::OK);
+    BOOST_CHECK_GT(feed.getVersion(), version);
+}
+
+BOOST_FIXTURE_TEST_CASE(testChangesOnlyContainModifiedWindows, Fixture)
+{
+    const auto version = feed.getVersion();
+
+    window1->setCoordinates(QRectF(10, 10, 100, 100));
+    group->removeContentWindow(window0);
+
+    const auto query = "since=" + std::to_string(version);
+    const auto response = feed.getChanges(makeRequest(query)).get();
+    BOOST_CHECK_EQUAL(response.code, zeroeq::http::Code::OK);
+
+    const auto object = json::toObject(response.body);
+    BOOST_CHECK(!object["full"].toBool());
+    BOOST_CHECK_EQUAL(uint64_t(object["version"].toDouble()),
+                      feed.getVersion());
+    BOOST_CHECK(getUuids(object["windows"].toArray()) ==
+                QStringList{url_encode(window1->getID())});
+    BOOST_CHECK(getUuids(object["removed"].toArray()) ==
+                QStringList{url_encode(window0->getID())});
+}
+
+BOOST_FIXTURE_TEST_CASE(testUnknownVersionReturnsAllWindows, Fixture)
+{
+    const auto response = feed.getChanges(makeRequest("since=1000")).get();
+    const auto object = json::toObject(response.body);
+    BOOST_CHECK(object["full"].toBool());
+    BOOST_CHECK_EQUAL(object["windows"].toArray().size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(testLongPollIsAnsweredOnChange, Fixture)
+{
+    const auto query = "since=" + std::to_string(feed.getVersion());
+    auto future = feed.getChanges(makeRequest(query));
+    BOOST_CHECK(future.wait_for(std::chrono::seconds(0)) ==
+                std::future_status::timeout);
+
+    bool notified = false;
+    QObject::connect(&feed, &WindowChangeFeed::responsesReady,
+                     [&notified] { notified = true; });
+
+    feed.publish();
+    BOOST_CHECK(!notified);
+
+    window0->setCoordinates(QRectF(10, 10, 100, 100));
+    feed.publish();
+    BOOST_CHECK(notified);
+    BOOST_REQUIRE(future.wait_for(std::chrono::seconds(0)) ==
+                  std::future_status::ready);
+
+    const auto object = json::toObject(future.get().body);
+    BOOST_CHECK(getUuids(object["windows"].toArray()) ==
+                QStringList{url_encode(window0->getID())});
+}
@@ -0,0 +1,205 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "CommandLineParser.h"
+#include "FrameSync.h"
+#include "network/MPIChannel.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#define RANK0 0
+
+// Example ways to run this program:
+// mpirun -n 6 -H localhost ./tideBenchmarkFrameSync --frames 1000 --streams 20
+//
+// Prints, for an increasing number of streams, the time spent per frame with
+// one collective per synchronized object and with a FrameSync per phase.
+
+namespace
+{
+class Timer
+{
+public:
+    using clock = std::chrono::high_resolution_clock;
+
+    void start() { _startTime = clock::now(); }
+    float elapsed() const
+    {
+        const auto now = clock::now();
+        return std::chrono::duration<float>{now - _startTime}.count();
+    }
+
+private:
+    clock::time_point _startTime;
+};
+
+namespace po = boost::program_options;
+
+class BenchmarkOptions : public CommandLineParser
+{
+public:
+    BenchmarkOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("frames,f", po::value<size_t>()->default_value( 1000u ),
+             "number of frames to synchronize for each stream count")
+            ("streams,s", po::value<size_t>()->default_value( 20u ),
+             "maximum number of streams")
+        ;
+        // clang-format on
+    }
+    size_t framesCount() const { return vm["frames"].as<size_t>(); }
+    size_t maxStreams() const { return vm["streams"].as<size_t>(); }
+};
+
+// Quit, screenshot, display group, markers, options, timer and lock
+const size_t sceneObjectsCount = 7;
+
+bool checkVersion(MPIChannel& channel, const uint64_t version)
+{
+    for (auto value : channel.gatherAll(version))
+    {
+        if (value != version)
+            return false;
+    }
+    return true;
+}
+
+bool allReady(MPIChannel& channel, const bool isReady)
+{
+    return channel.globalSum(isReady ? 1 : 0) == channel.getSize();
+}
+
+/** Collectives issued per frame before the introduction of FrameSync. */
+void syncSeparately(MPIChannel& channel, const size_t streams,
+                    const uint64_t version)
+{
+    for (size_t i = 0; i < sceneObjectsCount; ++i)
+        checkVersion(channel, version);
+
+    for (size_t i = 0; i < streams; ++i)
+    {
+        allReady(channel, true);
+        checkVersion(channel, version);
+    }
+}
+
+/** Collectives issued per frame with FrameSync: one per sync phase. */
+void syncBatched(MPIChannel& channel, const size_t streams,
+                 const uint64_t version)
+{
+    const auto globalMin = [&channel](const std::vector<int64_t>& values) {
+        return channel.globalMin(values);
+    };
+
+    FrameSync frameSync;
+    for (size_t i = 0; i < sceneObjectsCount; ++i)
+        frameSync.addVersion(version, nullptr);
+    frameSync.resolve(globalMin);
+
+    for (size_t i = 0; i < streams; ++i)
+    {
+        frameSync.addReady(true, nullptr);
+        frameSync.addVersion(version, nullptr);
+    }
+    frameSync.resolve(globalMin);
+}
+
+template <typename SyncFunc>
+float measure(MPIChannel& channel, const size_t streams, const size_t frames,
+              const SyncFunc& sync)
+{
+    Timer timer;
+    channel.globalBarrier();
+    timer.start();
+    for (size_t frame = 0; frame < frames; ++frame)
+        sync(channel, streams, frame);
+    channel.globalBarrier();
+    return timer.elapsed();
+}
+
+std::vector<size_t> getStreamCounts(const size_t maxStreams)
+{
+    std::vector<size_t> counts{0};
+    for (size_t count = 1; count < maxStreams; count *= 2)
+        counts.push_back(count);
+    if (maxStreams > 0)
+        counts.push_back(maxStreams);
+    return counts;
+}
+}
+
+/**
+ * Measure the time spent synchronizing the wall processes before rendering a
+ * frame, as a function of the number of streams.
+ */
+int main(int argc, char** argv)
+{
+    COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkFrameSync");
+
+    MPIChannel mpiChannel(argc, argv);
+    const auto frames = commandLine.framesCount();
+
+    if (mpiChannel.getRank() == RANK0)
+    {
+        std::cout << "Processes: " << mpiChannel.getSize() << std::endl;
+        std::cout << "Streams | Separate collectives [ms/frame] | "
+                  << "Batched [ms/frame] | Speedup" << std::endl;
+    }
+
+    for (auto streams : getStreamCounts(commandLine.maxStreams()))
+    {
+        const auto separate =
+            measure(mpiChannel, streams, frames, syncSeparately);
+        const auto batched = measure(mpiChannel, streams, frames, syncBatched);
+
+        if (mpiChannel.getRank() == RANK0)
+        {
+            std::cout << streams << " | " << separate * 1000 / frames << " | "
+                      << batched * 1000 / frames << " | "
+                      << separate / batched << std::endl;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -43,8 +43,10 @@
 #include "serialization/utils.h"
 
 #include <chrono>
+#include <ctime>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #define MEGABYTE 1000000
 #define RANK0 0
@@ -56,6 +58,11 @@
 // Time to send 100 objects: 3.445
 // Time per object: 0.03445
 // Throughput [Mbytes/sec]: 1741.66
+//
+// mpirun -n 6 -H localhost ./tideBenchmarkMPI --latency 1000 --interval 1000
+//
+// Small message latency for each MPI wait policy, with the CPU usage of the
+// receiving processes which are waiting for the next message most of the time.
 
 namespace
 {
@@ -88,16 +95,119 @@ public:
              "Size of each data packet [MB]")
             ("packets,p", po::value<size_t>()->default_value( 0u ),
              "number of packets to transmit")
+            ("latency,l", po::value<size_t>()->default_value( 0u ),
+             "number of small messages to exchange per wait policy")
+            ("interval,i", po::value<size_t>()->default_value( 1000u ),
+             "time between two small messages [us]")
         ;
         // clang-format on
     }
     size_t dataSize() const { return vm["datasize"].as<float>() * MEGABYTE; }
     size_t packetsCount() const { return vm["packets"].as<size_t>(); }
+    size_t messagesCount() const { return vm["latency"].as<size_t>(); }
+    size_t interval() const { return vm["interval"].as<size_t>(); }
+};
+
+struct NamedPolicy
+{
+    std::string name;
+    MPIWaitPolicy policy;
 };
+
+std::vector<NamedPolicy> makeWaitPolicies()
+{
+    MPIWaitPolicy yield;
+    yield.yieldTime = 100;
+
+    MPIWaitPolicy spin;
+    spin.spinTime = 50;
+    spin.yieldTime = 100;
+
+    MPIWaitPolicy adaptive = spin;
+    adaptive.adaptive = true;
+
+    return {{"sleep (default)", MPIWaitPolicy()},
+            {"yield 100us", yield},
+            {"spin 50us, yield 100us", spin},
+            {"adaptive spin 50us, yield 100us", adaptive}};
+}
+
+/**
+ * Exchange small messages between rank 0 and all other ranks (ping-pong).
+ * @return the average one-way latency in us, only valid on rank 0.
+ */
+double measureLatency(MPIChannel& mpiChannel, const size_t count,
+                      const size_t interval)
+{
+    const auto tag = int(MPIMessageType::NONE);
+    const std::string message(8, 'x');
+    std::vector<char> buffer(message.size());
+
+    double roundTrips = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (mpiChannel.getRank() != RANK0)
+        {
+            mpiChannel.receive(buffer.data(), buffer.size(), RANK0, tag);
+            mpiChannel.send(MPIMessageType::NONE, message, RANK0);
+            continue;
+        }
+        // Let the other processes wait, as they do between frames
+        std::this_thread::sleep_for(std::chrono::microseconds(interval));
+        for (int dest = 1; dest < mpiChannel.getSize(); ++dest)
+        {
+            Timer timer;
+            timer.start();
+            mpiChannel.send(MPIMessageType::NONE, message, dest);
+            mpiChannel.receive(buffer.data(), buffer.size(), dest, tag);
+            roundTrips += timer.elapsed();
+        }
+    }
+    const auto messages = count * (mpiChannel.getSize() - 1);
+    return messages ? roundTrips / messages / 2.0 * 1e6 : 0.0;
+}
+
+void benchmarkWaitPolicies(MPIChannel& mpiChannel, const size_t count,
+                           const size_t interval)
+{
+    if (mpiChannel.getRank() == RANK0)
+        std::cout << "Small message latency [us] and CPU usage of receivers"
+                  << std::endl;
+
+    for (const auto& wait : makeWaitPolicies())
+    {
+        MPIChannel::setWaitPolicy(wait.policy);
+        mpiChannel.globalBarrier();
+
+        Timer timer;
+        timer.start();
+        const auto cpuStart = std::clock();
+
+        const auto latency = measureLatency(mpiChannel, count, interval);
+
+        const auto cpuTime = float(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        const auto cpuUsage = uint64_t(cpuTime / timer.elapsed() * 100.f);
+        const auto usages = mpiChannel.gatherAll(cpuUsage);
+
+        if (mpiChannel.getRank() != RANK0)
+            continue;
+
+        uint64_t receiversUsage = 0;
+        for (int rank = 1; rank < mpiChannel.getSize(); ++rank)
+            receiversUsage += usages[rank];
+        if (mpiChannel.getSize() > 1)
+            receiversUsage /= mpiChannel.getSize() - 1;
+
+        std::cout << wait.name << ": latency " << latency << ", CPU "
+                  << receiversUsage << "%" << std::endl;
+    }
+    MPIChannel::setWaitPolicy(MPIWaitPolicy());
+}
 }
 
 /**
- * Send data via MPI to benchmark the effective link speed at application level.
+ * Send data via MPI to benchmark the effective link speed at application level,
+ * and the latency of small messages for different wait policies.
  */
 int main(int argc, char** argv)
 {
@@ -105,6 +215,12 @@ int main(int argc, char** argv)
 
     MPIChannel mpiChannel(argc, argv);
 
+    if (commandLine.messagesCount() > 0)
+        benchmarkWaitPolicies(mpiChannel, commandLine.messagesCount(),
+                              commandLine.interval());
+    if (commandLine.packetsCount() == 0)
+        return EXIT_SUCCESS;
+
     // Send buffer
     std::vector<char> noiseBuffer(commandLine.dataSize());
     for (auto& elem : noiseBuffer)
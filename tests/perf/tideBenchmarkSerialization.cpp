@@ -0,0 +1,166 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "CommandLineParser.h"
+#include "network/frameCodec.h"
+#include "serialization/utils.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+// Example way to run this program:
+// ./tideBenchmarkSerialization --segments 64 --segmentsize 100 --frames 1000
+//
+// Compares the cost of preparing a pixel stream frame for the MPI transfer on
+// the master and recovering it on the walls: boost binary archive (image data
+// copied into the archive and out of the receive buffer) versus frameCodec
+// (only the segment descriptions are serialized, MPI transfers the image data
+// in place). The transfer itself is not included.
+
+namespace
+{
+class Timer
+{
+public:
+    using clock = std::chrono::high_resolution_clock;
+
+    void start() { _startTime = clock::now(); }
+    float elapsed() const
+    {
+        const auto now = clock::now();
+        return std::chrono::duration<float>{now - _startTime}.count();
+    }
+
+private:
+    clock::time_point _startTime;
+};
+
+namespace po = boost::program_options;
+
+class BenchmarkOptions : public CommandLineParser
+{
+public:
+    BenchmarkOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("segments,n", po::value<size_t>()->default_value( 64u ),
+             "number of segments per frame")
+            ("segmentsize,s", po::value<size_t>()->default_value( 100u ),
+             "size of the image data of each segment [KB]")
+            ("frames,f", po::value<size_t>()->default_value( 1000u ),
+             "number of frames to process")
+        ;
+        // clang-format on
+    }
+    size_t segments() const { return vm["segments"].as<size_t>(); }
+    size_t segmentSize() const { return vm["segmentsize"].as<size_t>() * 1000; }
+    size_t frames() const { return vm["frames"].as<size_t>(); }
+};
+
+deflect::Frame makeFrame(const size_t segments, const size_t segmentSize)
+{
+    deflect::Frame frame;
+    frame.uri = "benchmark";
+    frame.segments.resize(segments);
+    for (size_t i = 0; i < segments; ++i)
+    {
+        auto& segment = frame.segments[i];
+        segment.parameters.x = uint(i % 8) * 512;
+        segment.parameters.y = uint(i / 8) * 512;
+        segment.parameters.width = 512;
+        segment.parameters.height = 512;
+        segment.parameters.dataType = deflect::DataType::jpeg;
+        segment.imageData = QByteArray(int(segmentSize), char(i));
+    }
+    return frame;
+}
+
+void printResult(const std::string& name, const float time,
+                 const size_t frames, const size_t serializedSize,
+                 const size_t frameSize)
+{
+    std::cout << name << ": " << time / frames * 1e6 << " us/frame, "
+              << frames * frameSize / time / 1e6 << " MB/s, "
+              << serializedSize << " serialized bytes" << std::endl;
+}
+}
+
+/**
+ * Benchmark the serialization of pixel stream frames for the MPI transfer.
+ */
+int main(int argc, char** argv)
+{
+    COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkSerialization");
+
+    const auto frame =
+        makeFrame(commandLine.segments(), commandLine.segmentSize());
+    const auto frameSize = commandLine.segments() * commandLine.segmentSize();
+    const auto frames = commandLine.frames();
+    Timer timer;
+
+    std::cout << "Frame size [MB]: " << frameSize / 1e6 << std::endl;
+
+    size_t serializedSize = 0;
+    timer.start();
+    for (size_t i = 0; i < frames; ++i)
+    {
+        const auto data = serialization::toBinary(frame);
+        const auto copy = serialization::get<deflect::Frame>(data);
+        serializedSize = data.size();
+    }
+    printResult("boost binary archive", timer.elapsed(), frames,
+                serializedSize, frameSize);
+
+    timer.start();
+    for (size_t i = 0; i < frames; ++i)
+    {
+        const auto data = frameCodec::encode(frame);
+        const auto payload = frameCodec::getPayload(frame);
+        const auto copy = frameCodec::decode(data.data(), data.size());
+        const auto target = frameCodec::getPayloadTarget(*copy);
+        serializedSize = data.size();
+    }
+    printResult("frameCodec", timer.elapsed(), frames, serializedSize,
+                frameSize);
+
+    return EXIT_SUCCESS;
+}
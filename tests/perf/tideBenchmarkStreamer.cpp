@@ -0,0 +1,216 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "CommandLineParser.h"
+#include "log.h"
+#include "localstreamer/StreamSender.h"
+
+#include <deflect/Stream.h>
+
+#include <QDir>
+#include <QGuiApplication>
+#include <QQuickView>
+#include <QTemporaryFile>
+
+#include <chrono>
+#include <iostream>
+
+// Example way to run this program, with a running Tide instance:
+// ./tideBenchmarkStreamer --host localhost --frames 300 --width 3840
+//                         --height 2160 --inflight 3
+//
+// Streams a synthetic animated QML scene, first with a single frame in flight
+// (serialized capture, compression and send) then with the given number of
+// frames in flight. Prints the frame rate and the final JPEG quality.
+
+namespace
+{
+const char* qmlScene = R"(
+import QtQuick 2.0
+Rectangle {
+    gradient: Gradient {
+        GradientStop { position: 0.0; color: "steelblue" }
+        GradientStop { position: 1.0; color: "black" }
+    }
+    Grid {
+        anchors.fill: parent
+        columns: 16
+        Repeater {
+            model: 16 * 9
+            Rectangle {
+                width: parent.width / 16
+                height: parent.height / 9
+                color: Qt.hsla(index / 144, 0.7, 0.5, 1.0)
+                border.width: 4
+                Text {
+                    anchors.centerIn: parent
+                    font.pixelSize: parent.height / 3
+                    text: index
+                }
+                RotationAnimation on rotation {
+                    from: 0; to: 360; duration: 2000 + 20 * index
+                    loops: Animation.Infinite
+                }
+            }
+        }
+    }
+}
+)";
+
+class Timer
+{
+public:
+    using clock = std::chrono::high_resolution_clock;
+
+    void start() { _startTime = clock::now(); }
+    float elapsed() const
+    {
+        const auto now = clock::now();
+        return std::chrono::duration<float>{now - _startTime}.count();
+    }
+
+private:
+    clock::time_point _startTime;
+};
+
+namespace po = boost::program_options;
+
+class BenchmarkOptions : public CommandLineParser
+{
+public:
+    BenchmarkOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("host", po::value<std::string>()->default_value( "localhost" ),
+             "Tide host to stream to")
+            ("frames,f", po::value<int>()->default_value( 300 ),
+             "number of frames to stream per run")
+            ("width", po::value<int>()->default_value( 3840 ),
+             "width of the scene [pixels]")
+            ("height", po::value<int>()->default_value( 2160 ),
+             "height of the scene [pixels]")
+            ("inflight,n", po::value<size_t>()->default_value( 3 ),
+             "max number of frames in flight")
+        ;
+        // clang-format on
+    }
+    std::string host() const { return vm["host"].as<std::string>(); }
+    int frames() const { return vm["frames"].as<int>(); }
+    QSize size() const
+    {
+        return QSize(vm["width"].as<int>(), vm["height"].as<int>());
+    }
+    size_t inflight() const { return vm["inflight"].as<size_t>(); }
+};
+
+bool benchmark(QQuickView& view, deflect::Stream& stream, const int frames,
+               const size_t framesInFlight)
+{
+    StreamSender sender{stream, framesInFlight};
+    Timer timer;
+    float captureTime = 0.f;
+
+    timer.start();
+    for (int i = 0; i < frames; ++i)
+    {
+        QCoreApplication::processEvents();
+
+        Timer capture;
+        capture.start();
+        const auto image = view.grabWindow();
+        captureTime += capture.elapsed();
+
+        if (!sender.send(image))
+            return false;
+    }
+    if (!sender.finish())
+        return false;
+    const auto time = timer.elapsed();
+
+    std::cout << "== " << framesInFlight << " frame(s) in flight: "
+              << frames / time << " fps, capture "
+              << captureTime * 1000 / frames << " ms/frame, final quality "
+              << sender.getQuality() << std::endl;
+    return true;
+}
+}
+
+/**
+ * Benchmark the pipelined streaming of a QML scene to Tide.
+ */
+int main(int argc, char** argv)
+{
+    COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkStreamer");
+
+    QGuiApplication app(argc, argv);
+
+    QTemporaryFile qmlFile{QDir::tempPath() + "/XXXXXX.qml"};
+    if (!qmlFile.open() || qmlFile.write(qmlScene) < 0)
+    {
+        std::cerr << "could not write the QML scene" << std::endl;
+        return EXIT_FAILURE;
+    }
+    qmlFile.close();
+
+    // The scene is rendered offscreen by grabWindow(), without showing it
+    QQuickView view;
+    view.setResizeMode(QQuickView::SizeRootObjectToView);
+    view.resize(commandLine.size());
+    view.setSource(QUrl::fromLocalFile(qmlFile.fileName()));
+
+    deflect::Stream stream{"tideBenchmarkStreamer", commandLine.host()};
+    if (!stream.isConnected())
+    {
+        std::cerr << "could not connect to: " << commandLine.host()
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    for (const auto framesInFlight : {size_t(1), commandLine.inflight()})
+    {
+        if (!benchmark(view, stream, commandLine.frames(), framesInFlight))
+        {
+            std::cerr << "stream closed" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+
+#include "CommandLineParser.h"
+#include "log.h"
+#include "thumbnail/ThumbnailGeneratorFactory.h"
+
+#include <QDir>
+#include <QGuiApplication>
+#include <QImageReader>
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <iostream>
+
+// Example way to run this program:
+// ./tideBenchmarkThumbnails --corpus /path/to/large/images --size 512
+//
+// Generates the thumbnails of all the images of a folder (e.g. large JPEG,
+// PNG and TIFF files), first with the thumbnail generators (scaled decoding),
+// then by decoding each image at full resolution and scaling it down. Prints
+// the time spent per file and the peak memory usage after each pass.
+
+namespace
+{
+class Timer
+{
+public:
+    using clock = std::chrono::high_resolution_clock;
+
+    void start() { _startTime = clock::now(); }
+    float elapsed() const
+    {
+        const auto now = clock::now();
+        return std::chrono::duration<float>{now - _startTime}.count();
+    }
+
+private:
+    clock::time_point _startTime;
+};
+
+namespace po = boost::program_options;
+
+class BenchmarkOptions : public CommandLineParser
+{
+public:
+    BenchmarkOptions()
+    {
+        // clang-format off
+        desc.add_options()
+            ("corpus,c", po::value<std::string>()->default_value( "." ),
+             "folder with the image files")
+            ("size,s", po::value<int>()->default_value( 512 ),
+             "size of the thumbnails [pixels]")
+        ;
+        // clang-format on
+    }
+    QString corpus() const
+    {
+        return QString::fromStdString(vm["corpus"].as<std::string>());
+    }
+    QSize size() const
+    {
+        const auto size = vm["size"].as<int>();
+        return QSize(size, size);
+    }
+};
+
+long getPeakMemoryUsage()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024; // ru_maxrss is in KB on Linux
+}
+
+void printResult(const std::string& name, const QString& filename,
+                 const float time, const QImage& thumbnail)
+{
+    std::cout << name << " " << QFileInfo(filename).fileName().toStdString()
+              << ": " << time * 1000 << " ms, " << thumbnail.width() << "x"
+              << thumbnail.height() << std::endl;
+}
+
+void printPeakMemoryUsage(const std::string& name, const float totalTime,
+                          const int files)
+{
+    std::cout << "== " << name << ": " << totalTime * 1000 / files
+              << " ms/file, peak memory usage: " << getPeakMemoryUsage()
+              << " MB" << std::endl;
+}
+}
+
+/**
+ * Benchmark the generation of thumbnails for large images.
+ */
+int main(int argc, char** argv)
+{
+    COMMAND_LINE_PARSER_CHECK(BenchmarkOptions, "tideBenchmarkThumbnails");
+
+    QGuiApplication app(argc, argv); // for the placeholder images
+
+    QStringList filters;
+    for (const auto& format : QImageReader::supportedImageFormats())
+        filters.append("*." + QString::fromLatin1(format));
+
+    const auto files = QDir{commandLine.corpus()}.entryInfoList(filters,
+                                                                QDir::Files);
+    if (files.isEmpty())
+    {
+        std::cerr << "no image files in: " << commandLine.corpus().toStdString()
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto size = commandLine.size();
+    Timer timer;
+
+    float totalTime = 0.f;
+    for (const auto& file : files)
+    {
+        const auto filename = file.absoluteFilePath();
+        timer.start();
+        const auto thumbnail =
+            ThumbnailGeneratorFactory::getGenerator(filename, size)->generate(
+                filename);
+        const auto time = timer.elapsed();
+        totalTime += time;
+        printResult("scaled decode", filename, time, thumbnail);
+    }
+    printPeakMemoryUsage("scaled decode", totalTime, files.size());
+
+    totalTime = 0.f;
+    for (const auto& file : files)
+    {
+        const auto filename = file.absoluteFilePath();
+        timer.start();
+        const auto thumbnail = QImageReader{filename}.read().scaled(
+            size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        const auto time = timer.elapsed();
+        totalTime += time;
+        printResult("full decode", filename, time, thumbnail);
+    }
+    printPeakMemoryUsage("full decode", totalTime, files.size());
+
+    return EXIT_SUCCESS;
+}
@@ -52,6 +52,14 @@ CommandLineParameters::CommandLineParameters()
          "path to configuration file [required]")
         ("sessionfile", po::value<std::string>()->default_value(""),
          "path to an initial session file")
+        ("mpispin", po::value<uint32_t>()->default_value(0),
+         "time to busy-poll when waiting for an MPI message [us]")
+        ("mpiyield", po::value<uint32_t>()->default_value(0),
+         "time to yield the CPU after busy-polling, before sleeping [us]")
+        ("mpiadaptive", po::bool_switch()->default_value(false),
+         "only busy-poll while recent MPI messages arrived within mpispin")
+        ("tracefile", po::value<std::string>()->default_value(""),
+         "write frame latency traces to <tracefile>.<process>.json")
     ;
     // clang-format on
 }
@@ -72,3 +80,17 @@ QString CommandLineParameters::getSessionFilename() const
 {
     return QString::fromStdString(vm["sessionfile"].as<std::string>());
 }
+
+MPIWaitPolicy CommandLineParameters::getMPIWaitPolicy() const
+{
+    MPIWaitPolicy policy;
+    policy.spinTime = vm["mpispin"].as<uint32_t>();
+    policy.yieldTime = vm["mpiyield"].as<uint32_t>();
+    policy.adaptive = vm["mpiadaptive"].as<bool>();
+    return policy;
+}
+
+QString CommandLineParameters::getTraceFilename() const
+{
+    return QString::fromStdString(vm["tracefile"].as<std::string>());
+}
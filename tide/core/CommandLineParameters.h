@@ -41,6 +41,7 @@
 #define COMMANDLINEPARAMETERS_H
 
 #include "CommandLineParser.h"
+#include "network/MPIWaitPolicy.h"
 
 #include <QString>
 
@@ -61,6 +62,12 @@ public:
 
     /** Get the config filename */
     QString getSessionFilename() const;
+
+    /** Get the policy for waiting on MPI messages */
+    MPIWaitPolicy getMPIWaitPolicy() const;
+
+    /** Get the base filename for frame traces, empty if tracing is off */
+    QString getTraceFilename() const;
 };
 
 #endif
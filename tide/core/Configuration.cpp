@@ -122,6 +122,51 @@ void Configuration::_load()
     query.setQuery("string(/configuration/setup/@swapsync)");
     if (getString(query, swapsync) && swapsync == "hardware")
         _swapSync = SwapSync::hardware;
+
+    int processCount = 0;
+    query.setQuery("string(count(//process))");
+    getInt(query, processCount);
+    for (int i = 1; i <= processCount; ++i) // xpath index starts from 1
+        _wallProcessScreens.emplace_back(_loadWallProcessScreens(query, i));
+}
+
+std::vector<QRect> Configuration::_loadWallProcessScreens(
+    QXmlQuery& query, const int processIndex) const
+{
+    std::vector<QRect> screens;
+
+    int screenCount = 0;
+    query.setQuery(
+        QString("string(count(//process[%1]/screen))").arg(processIndex));
+    getInt(query, screenCount);
+
+    for (int i = 1; i <= screenCount; ++i)
+    {
+        QPoint globalIndex;
+        int value = 0;
+
+        query.setQuery(QString("string(//process[%1]/screen[%2]/@i)")
+                           .arg(processIndex)
+                           .arg(i));
+        if (getInt(query, value))
+            globalIndex.setX(value);
+
+        query.setQuery(QString("string(//process[%1]/screen[%2]/@j)")
+                           .arg(processIndex)
+                           .arg(i));
+        if (getInt(query, value))
+            globalIndex.setY(value);
+
+        try
+        {
+            screens.push_back(getScreenRect(globalIndex));
+        }
+        catch (const std::invalid_argument&)
+        {
+            // screens outside of the wall dimensions are never visible
+        }
+    }
+    return screens;
 }
 
 int Configuration::getTotalScreenCountX() const
@@ -202,6 +247,19 @@ QRect Configuration::getScreenRect(const QPoint& tileIndex) const
     return QRect(xPos, yPos, _screenWidth, _screenHeight);
 }
 
+int Configuration::getWallProcessCount() const
+{
+    return _wallProcessScreens.size();
+}
+
+std::vector<QRect> Configuration::getWallProcessScreens(
+    const int processIndex) const
+{
+    if (processIndex < 1 || processIndex > getWallProcessCount())
+        return std::vector<QRect>();
+    return _wallProcessScreens[processIndex - 1];
+}
+
 bool Configuration::getFullscreen() const
 {
     return _fullscreen;
@@ -143,6 +143,17 @@ public:
     /** Get the coordinates and dimensions of a screen in pixel units. */
     QRect getScreenRect(const QPoint& tileIndex) const;
 
+    /** Get the number of wall processes. */
+    int getWallProcessCount() const;
+
+    /**
+     * Get the area covered by the screens of a wall process.
+     * @param processIndex MPI index in the range [1;n] of the wall process
+     * @return the screen rectangles in pixel units, empty if the process does
+     *         not exist.
+     */
+    std::vector<QRect> getWallProcessScreens(int processIndex) const;
+
     /** Display the windows in fullscreen mode. */
     bool getFullscreen() const;
 
@@ -170,8 +181,11 @@ private:
     int _mullionHeight;
     bool _fullscreen;
     SwapSync _swapSync;
+    std::vector<std::vector<QRect>> _wallProcessScreens;
 
     void _load();
+    std::vector<QRect> _loadWallProcessScreens(QXmlQuery& query,
+                                               int processIndex) const;
 };
 
 #endif
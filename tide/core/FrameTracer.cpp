@@ -0,0 +1,391 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "FrameTracer.h"
+
+#include "log.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace
+{
+// Async stages that were never completed, e.g. frames of a closed stream
+const size_t maxPendingAsync = 1024;
+const auto maxPendingAsyncAge = std::chrono::seconds(10);
+
+size_t _getBucket(const uint64_t us)
+{
+    size_t bucket = 0;
+    for (auto value = us >> 1; value > 0; value >>= 1)
+        ++bucket;
+    return std::min(bucket, LatencyHistogram::bucketCount - 1);
+}
+
+double _toMs(const double us)
+{
+    return us / 1000.0;
+}
+
+int64_t _toUs(const FrameTracer::clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+        .count();
+}
+
+int64_t _getEpochUs()
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+QString _escape(QString string)
+{
+    return string.replace('\\', "\\\\").replace('"', "\\\"");
+}
+}
+
+const char* getStageName(const TraceStage stage)
+{
+    switch (stage)
+    {
+    case TraceStage::streamReceive:
+        return "stream_receive";
+    case TraceStage::mpiSend:
+        return "mpi_send";
+    case TraceStage::mpiReceive:
+        return "mpi_receive";
+    case TraceStage::decode:
+        return "decode";
+    case TraceStage::pboCopy:
+        return "pbo_copy";
+    case TraceStage::upload:
+        return "upload";
+    case TraceStage::sync:
+        return "sync";
+    case TraceStage::render:
+        return "render";
+    case TraceStage::swapBarrier:
+        return "swap_barrier";
+    case TraceStage::swapBuffers:
+        return "swap_buffers";
+    case TraceStage::tileWait:
+        return "tile_wait";
+    default:
+        return "unknown";
+    }
+}
+
+void LatencyHistogram::add(const std::chrono::microseconds latency)
+{
+    const auto us = uint64_t(std::max<int64_t>(latency.count(), 0));
+    ++_buckets[_getBucket(us)];
+    ++_count;
+    _totalUs += us;
+    _maxUs = std::max(_maxUs, us);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (size_t i = 0; i < bucketCount; ++i)
+        _buckets[i] += other._buckets[i];
+    _count += other._count;
+    _totalUs += other._totalUs;
+    _maxUs = std::max(_maxUs, other._maxUs);
+}
+
+double LatencyHistogram::getMeanMs() const
+{
+    return _count > 0 ? _toMs(double(_totalUs) / _count) : 0.0;
+}
+
+double LatencyHistogram::getMaxMs() const
+{
+    return _toMs(_maxUs);
+}
+
+double LatencyHistogram::getPercentileMs(const double percentile) const
+{
+    if (_count == 0)
+        return 0.0;
+
+    const auto rank = std::max(percentile, 0.0) / 100.0 * _count;
+    uint64_t cumulated = 0;
+    for (size_t i = 0; i < bucketCount; ++i)
+    {
+        if (_buckets[i] == 0 || cumulated + _buckets[i] < rank)
+        {
+            cumulated += _buckets[i];
+            continue;
+        }
+        const auto lower = i == 0 ? 0.0 : double(getBucketLimitUs(i - 1));
+        const auto upper = double(getBucketLimitUs(i));
+        const auto fraction = (rank - cumulated) / _buckets[i];
+        const auto us = lower + fraction * (upper - lower);
+        return _toMs(std::min(us, double(_maxUs)));
+    }
+    return getMaxMs();
+}
+
+uint64_t LatencyHistogram::getBucketLimitUs(const size_t bucket)
+{
+    return uint64_t(2) << bucket;
+}
+
+LatencyHistogram& FrameTraceStatistics::operator[](const TraceStage stage)
+{
+    return _stages[size_t(stage)];
+}
+
+const LatencyHistogram& FrameTraceStatistics::operator[](
+    const TraceStage stage) const
+{
+    return _stages[size_t(stage)];
+}
+
+void FrameTraceStatistics::merge(const FrameTraceStatistics& other)
+{
+    for (size_t i = 0; i < _stages.size(); ++i)
+        _stages[i].merge(other._stages[i]);
+    _queuedTileLoads += other._queuedTileLoads;
+    _runningTileLoads += other._runningTileLoads;
+}
+
+bool FrameTraceStatistics::isEmpty() const
+{
+    return _queuedTileLoads == 0 && _runningTileLoads == 0 &&
+           std::all_of(_stages.begin(), _stages.end(),
+                       [](const LatencyHistogram& histogram) {
+                           return histogram.getCount() == 0;
+                       });
+}
+
+void FrameTraceStatistics::setTileLoads(const uint64_t queued,
+                                        const uint64_t running)
+{
+    _queuedTileLoads = queued;
+    _runningTileLoads = running;
+}
+
+FrameTracer::FrameTracer(const clock::duration interval)
+    : _interval(interval)
+    , _intervalStart(clock::now())
+    , _traceStart(clock::now())
+    , _traceStartEpochUs(_getEpochUs())
+{
+}
+
+FrameTracer& FrameTracer::instance()
+{
+    static FrameTracer tracer;
+    return tracer;
+}
+
+void FrameTracer::record(const TraceStage stage, const clock::time_point start,
+                         const clock::time_point end)
+{
+    const QMutexLocker lock(&_mutex);
+    _record(stage, start, end);
+}
+
+void FrameTracer::beginAsync(const TraceStage stage, const uintptr_t id)
+{
+    const auto now = clock::now();
+    const QMutexLocker lock(&_mutex);
+
+    if (_pending.size() >= maxPendingAsync)
+    {
+        for (auto it = _pending.begin(); it != _pending.end();)
+        {
+            if (now - it->second > maxPendingAsyncAge)
+                it = _pending.erase(it);
+            else
+                ++it;
+        }
+        if (_pending.size() >= maxPendingAsync)
+            return;
+    }
+    _pending[std::make_pair(stage, id)] = now;
+}
+
+void FrameTracer::endAsync(const TraceStage stage, const uintptr_t id)
+{
+    const auto now = clock::now();
+    const QMutexLocker lock(&_mutex);
+
+    const auto it = _pending.find(std::make_pair(stage, id));
+    if (it == _pending.end())
+        return;
+
+    _record(stage, it->second, now);
+    _pending.erase(it);
+}
+
+FrameTraceStatistics FrameTracer::getStatistics() const
+{
+    const QMutexLocker lock(&_mutex);
+    const auto elapsed = clock::now() - _intervalStart;
+
+    // Same as after _rotate(), which can't be called from this const method
+    FrameTraceStatistics statistics;
+    if (elapsed < _interval)
+        statistics.merge(_previousStatistics);
+    if (elapsed < 2 * _interval)
+        statistics.merge(_statistics);
+    statistics.setTileLoads(_statistics.getQueuedTileLoads(),
+                            _statistics.getRunningTileLoads());
+    return statistics;
+}
+
+void FrameTracer::setTileLoads(const uint64_t queued, const uint64_t running)
+{
+    const QMutexLocker lock(&_mutex);
+    _rotate(clock::now());
+    _statistics.setTileLoads(queued, running);
+}
+
+void FrameTracer::enableChromeTrace(const QString& filename,
+                                    const size_t maxEvents)
+{
+    const QMutexLocker lock(&_mutex);
+    _traceFilename = filename;
+    _maxEvents = maxEvents;
+    _events.reserve(std::min<size_t>(maxEvents, 65536));
+}
+
+bool FrameTracer::writeChromeTrace() const
+{
+    const QMutexLocker lock(&_mutex);
+    if (_traceFilename.isEmpty())
+        return false;
+
+    QFile file(_traceFilename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        put_flog(LOG_ERROR, "could not write trace file: '%s'",
+                 _traceFilename.toLocal8Bit().constData());
+        return false;
+    }
+
+    const auto pid = QCoreApplication::applicationPid();
+    const auto processName = QString::fromStdString(logger_id);
+
+    QTextStream out(&file);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"name\":\""
+        << _escape(processName.isEmpty() ? "tide" : processName) << "\"}}";
+    for (const auto& thread : _threadNames)
+    {
+        out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+            << ",\"tid\":" << thread.first << ",\"args\":{\"name\":\""
+            << _escape(thread.second) << "\"}}";
+    }
+    for (const auto& event : _events)
+    {
+        out << ",\n{\"name\":\"" << getStageName(event.stage)
+            << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":" << pid
+            << ",\"tid\":" << event.thread << ",\"ts\":" << event.startUs
+            << ",\"dur\":" << event.durationUs << "}";
+    }
+    out << "\n]}\n";
+    out.flush();
+
+    if (_events.size() >= _maxEvents)
+    {
+        put_flog(LOG_WARN, "trace truncated to the first %lu events",
+                 (unsigned long)_maxEvents);
+    }
+    return file.error() == QFile::NoError;
+}
+
+void FrameTracer::_record(const TraceStage stage,
+                          const clock::time_point start,
+                          const clock::time_point end)
+{
+    const auto durationUs = _toUs(end - start);
+    _rotate(end);
+    _statistics[stage].add(std::chrono::microseconds(durationUs));
+
+    if (_events.size() >= _maxEvents)
+        return;
+
+    const auto startUs = _traceStartEpochUs + _toUs(start - _traceStart);
+    _events.push_back({stage, _getThreadId(), startUs, durationUs});
+}
+
+void FrameTracer::_rotate(const clock::time_point now)
+{
+    const auto elapsed = now - _intervalStart;
+    if (elapsed < _interval)
+        return;
+
+    // The occupancy of the tile loader is a gauge, not a sample
+    FrameTraceStatistics statistics;
+    statistics.setTileLoads(_statistics.getQueuedTileLoads(),
+                            _statistics.getRunningTileLoads());
+
+    std::swap(_previousStatistics, _statistics);
+    if (elapsed >= 2 * _interval)
+        _previousStatistics = FrameTraceStatistics();
+    _statistics = statistics;
+    _intervalStart = now;
+}
+
+int FrameTracer::_getThreadId()
+{
+    static std::atomic<int> threadCount{0};
+    thread_local const int threadId = ++threadCount;
+
+    if (!_threadNames.count(threadId))
+    {
+        auto name = QThread::currentThread()->objectName();
+        if (name.isEmpty())
+            name = QString("thread%1").arg(threadId);
+        _threadNames[threadId] = name;
+    }
+    return threadId;
+}
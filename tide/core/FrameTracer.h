@@ -0,0 +1,316 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef FRAMETRACER_H
+#define FRAMETRACER_H
+
+#include "serialization/includes.h"
+
+#include <QMutex>
+#include <QString>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/**
+ * The stages of the path of a pixel stream frame, from its reception by the
+ * master application to its presentation on the wall, and of the loading of
+ * the tiles of all contents.
+ */
+enum class TraceStage
+{
+    streamReceive, // master: frame received from deflect until sent over MPI
+    mpiSend,       // master: frame routed and sent to the wall processes
+    mpiReceive,    // wall: frame payload received from the master
+    decode,        // wall: stream tile decompression
+    pboCopy,       // wall: copy of tile pixels to the PboRing (loader threads)
+    upload,        // wall: copy of tile pixels to OpenGL buffers (rendering)
+    sync,          // wall: synchronization of the scene between processes
+    render,        // wall: rendering of all windows of the process
+    swapBarrier,   // wall: wait for the other processes before swap
+    swapBuffers,   // wall: buffer swap and flush of the GPU commands
+    tileWait,      // wall: tile load request waiting for a loader thread
+    count
+};
+
+/** @return the name of the stage, as used in the REST API and traces. */
+const char* getStageName(TraceStage stage);
+
+/**
+ * Histogram of latencies with logarithmic (power of two) microsecond buckets.
+ *
+ * Percentiles are interpolated linearly within a bucket, which bounds their
+ * error to the width of the bucket while keeping the histogram small enough
+ * to be sent over the network.
+ */
+class LatencyHistogram
+{
+public:
+    /** Number of buckets, the last one also counts all larger values. */
+    static const size_t bucketCount = 24;
+
+    /** Add a sample. */
+    void add(std::chrono::microseconds latency);
+
+    /** Add all the samples of another histogram. */
+    void merge(const LatencyHistogram& other);
+
+    /** @return the number of samples. */
+    uint64_t getCount() const { return _count; }
+
+    /** @return the mean of the samples in milliseconds. */
+    double getMeanMs() const;
+
+    /** @return the largest sample in milliseconds. */
+    double getMaxMs() const;
+
+    /**
+     * @param percentile in the range [0, 100]
+     * @return the estimated latency of the percentile in milliseconds.
+     */
+    double getPercentileMs(double percentile) const;
+
+    /** @return the number of samples in each bucket. */
+    const std::array<uint64_t, bucketCount>& getBuckets() const
+    {
+        return _buckets;
+    }
+
+    /** @return the upper bound of the given bucket in microseconds. */
+    static uint64_t getBucketLimitUs(size_t bucket);
+
+private:
+    friend class boost::serialization::access;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int /*version*/)
+    {
+        // clang-format off
+        for (auto& bucket : _buckets)
+            ar & bucket;
+        ar & _count;
+        ar & _totalUs;
+        ar & _maxUs;
+        // clang-format on
+    }
+
+    std::array<uint64_t, bucketCount> _buckets{};
+    uint64_t _count = 0;
+    uint64_t _totalUs = 0;
+    uint64_t _maxUs = 0;
+};
+
+/**
+ * The latency histograms of all the stages traced by a process, and the
+ * last known occupancy of its tile loader.
+ */
+class FrameTraceStatistics
+{
+public:
+    /** @return the histogram of the given stage. */
+    LatencyHistogram& operator[](TraceStage stage);
+
+    /** @return the histogram of the given stage. */
+    const LatencyHistogram& operator[](TraceStage stage) const;
+
+    /** Add all the samples and tile loads of other statistics. */
+    void merge(const FrameTraceStatistics& other);
+
+    /** @return true if no stage has any sample and no tile is loading. */
+    bool isEmpty() const;
+
+    /** Set the number of tile loads waiting in the queue and running. */
+    void setTileLoads(uint64_t queued, uint64_t running);
+
+    /** @return the number of tile loads waiting in the queue. */
+    uint64_t getQueuedTileLoads() const { return _queuedTileLoads; }
+
+    /** @return the number of tile loads running. */
+    uint64_t getRunningTileLoads() const { return _runningTileLoads; }
+
+private:
+    friend class boost::serialization::access;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int /*version*/)
+    {
+        // clang-format off
+        for (auto& histogram : _stages)
+            ar & histogram;
+        ar & _queuedTileLoads;
+        ar & _runningTileLoads;
+        // clang-format on
+    }
+
+    std::array<LatencyHistogram, size_t(TraceStage::count)> _stages;
+    uint64_t _queuedTileLoads = 0;
+    uint64_t _runningTileLoads = 0;
+};
+
+/**
+ * Record the latency of the stages of the frame path.
+ *
+ * Each process keeps the statistics of a rolling window of the last one to
+ * two intervals, so that recent regressions are not hidden by the history of
+ * the process. The wall processes periodically send them to the master
+ * application. Optionally, all the recorded
+ * events can also be written in the Chrome trace event format to be
+ * inspected with chrome://tracing.
+ *
+ * This class is thread-safe.
+ */
+class FrameTracer
+{
+    Q_DISABLE_COPY(FrameTracer)
+
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor, use instance() outside of unit tests.
+     * @param interval the duration after which samples start expiring
+     */
+    explicit FrameTracer(clock::duration interval = std::chrono::seconds(5));
+
+    /** @return the tracer of this process. */
+    static FrameTracer& instance();
+
+    /**
+     * Record a completed stage.
+     * @param stage the traced stage
+     * @param start the time at which the stage started
+     * @param end the time at which the stage completed
+     */
+    void record(TraceStage stage, clock::time_point start,
+                clock::time_point end = clock::now());
+
+    /**
+     * Begin a stage that completes in another function or thread.
+     * @param stage the traced stage
+     * @param id an identifier of the traced object, e.g. its address
+     */
+    void beginAsync(TraceStage stage, uintptr_t id);
+
+    /**
+     * Complete a stage started with beginAsync(), ignored if it was not.
+     * @param stage the traced stage
+     * @param id the identifier given to beginAsync()
+     */
+    void endAsync(TraceStage stage, uintptr_t id);
+
+    /**
+     * @return the statistics of the current and previous intervals, and the
+     *         last occupancy of the tile loader.
+     */
+    FrameTraceStatistics getStatistics() const;
+
+    /**
+     * Update the occupancy of the tile loader of this process.
+     * @param queued the number of tile loads waiting in the queue
+     * @param running the number of tile loads running
+     */
+    void setTileLoads(uint64_t queued, uint64_t running);
+
+    /**
+     * Keep the recorded events to write them with writeChromeTrace().
+     * @param filename the output file
+     * @param maxEvents the number of events after which recording stops
+     */
+    void enableChromeTrace(const QString& filename,
+                           size_t maxEvents = 1000000);
+
+    /**
+     * Write the recorded events to the file given to enableChromeTrace().
+     * @return false if the trace is not enabled or the file cannot be written
+     */
+    bool writeChromeTrace() const;
+
+    /** Record the duration of a scope. */
+    class Scope
+    {
+    public:
+        explicit Scope(TraceStage stage, FrameTracer& tracer = instance())
+            : _tracer(tracer)
+            , _stage(stage)
+            , _start(clock::now())
+        {
+        }
+
+        ~Scope() { _tracer.record(_stage, _start); }
+
+    private:
+        FrameTracer& _tracer;
+        const TraceStage _stage;
+        const clock::time_point _start;
+    };
+
+private:
+    struct Event
+    {
+        TraceStage stage;
+        int thread;
+        int64_t startUs;
+        int64_t durationUs;
+    };
+
+    mutable QMutex _mutex;
+    const clock::duration _interval;
+    clock::time_point _intervalStart;
+    FrameTraceStatistics _statistics;
+    FrameTraceStatistics _previousStatistics;
+    std::map<std::pair<TraceStage, uintptr_t>, clock::time_point> _pending;
+
+    QString _traceFilename;
+    size_t _maxEvents = 0;
+    std::vector<Event> _events;
+    std::map<int, QString> _threadNames;
+    const clock::time_point _traceStart;
+    const int64_t _traceStartEpochUs;
+
+    void _record(TraceStage stage, clock::time_point start,
+                 clock::time_point end);
+    void _rotate(clock::time_point now);
+    int _getThreadId();
+};
+
+#endif
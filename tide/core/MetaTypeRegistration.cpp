@@ -40,6 +40,7 @@
 #include "config.h"
 #include "types.h"
 
+#include "FrameTracer.h"
 #include "network/MPIHeader.h"
 #include "scene/ContentWindow.h"
 
@@ -62,6 +63,8 @@ struct MetaTypeRegistration
             "ContentSynchronizerSharedPtr");
         qRegisterMetaType<DisplayGroupPtr>("DisplayGroupPtr");
         qRegisterMetaType<DisplayGroupConstPtr>("DisplayGroupConstPtr");
+        qRegisterMetaType<DisplayGroupPatchPtr>("DisplayGroupPatchPtr");
+        qRegisterMetaType<FrameTraceStatistics>("FrameTraceStatistics");
         qRegisterMetaType<ImagePtr>("ImagePtr");
         qRegisterMetaType<MarkersPtr>("MarkersPtr");
         qRegisterMetaType<MPIMessageType>("MPIMessageType");
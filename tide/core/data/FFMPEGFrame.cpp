@@ -52,9 +52,20 @@ FFMPEGFrame::FFMPEGFrame()
         put_flog(LOG_ERROR, "Error allocating RGB frame");
 }
 
+FFMPEGFrame::FFMPEGFrame(const AVFrame& frame)
+    : _avFrame(av_frame_clone(&frame))
+{
+    if (!_avFrame)
+        put_flog(LOG_ERROR, "Error referencing frame");
+}
+
 FFMPEGFrame::~FFMPEGFrame()
 {
+#if (LIBAVCODEC_VERSION_INT < AV_VERSION_INT(55, 28, 0))
     av_free(_avFrame);
+#else
+    av_frame_free(&_avFrame);
+#endif
 }
 
 int FFMPEGFrame::getWidth() const
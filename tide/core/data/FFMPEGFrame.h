@@ -50,10 +50,18 @@ extern "C" {
 /** A frame of an FFMPEG movie. */
 class FFMPEGFrame
 {
+
 public:
     /** Constructor. */
     FFMPEGFrame();
 
+    /**
+     * Create a new reference to the buffers of a decoded frame.
+     * @param frame the frame to reference; its data is copied only if it is
+     *        not reference-counted.
+     */
+    explicit FFMPEGFrame(const AVFrame& frame);
+
     /** Destructor. */
     ~FFMPEGFrame();
 
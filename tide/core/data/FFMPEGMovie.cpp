@@ -221,7 +221,22 @@ void FFMPEGMovie::setFormat(const TextureFormat format)
     _format = format;
 }
 
-PicturePtr FFMPEGMovie::getFrame(double posInSeconds)
+PicturePtr FFMPEGMovie::getFrame(const double posInSeconds)
+{
+    return _decode<PicturePtr>(posInSeconds, [this] {
+        return _videoStream->decodePictureForLastPacket(_format);
+    });
+}
+
+FFMPEGFramePtr FFMPEGMovie::getDecodedFrame(const double posInSeconds)
+{
+    return _decode<FFMPEGFramePtr>(posInSeconds, [this] {
+        return _videoStream->getFrameForLastPacket();
+    });
+}
+
+template <typename T>
+T FFMPEGMovie::_decode(double posInSeconds, std::function<T()> getResult)
 {
     posInSeconds = std::max(0.0, std::min(posInSeconds, getDuration()));
 
@@ -233,10 +248,10 @@ PicturePtr FFMPEGMovie::getFrame(double posInSeconds)
         const double target = std::max(0.0, posInSeconds - frameDuration);
         const int64_t frameIndex = _videoStream->getFrameIndex(target);
         if (!_videoStream->seekToNearestFullframe(frameIndex))
-            return PicturePtr();
+            return T();
     }
 
-    PicturePtr picture;
+    T result;
     const int64_t targetTimestamp = _videoStream->getTimestamp(posInSeconds);
 
     AVPacket packet;
@@ -248,10 +263,10 @@ PicturePtr FFMPEGMovie::getFrame(double posInSeconds)
         const int64_t timestamp = _videoStream->decodeTimestamp(packet);
         if (timestamp >= targetTimestamp)
         {
-            picture = _videoStream->decodePictureForLastPacket(_format);
+            result = getResult();
             // This validity check is to prevent against rare decoding errors
             // and is not inherently part of the seeking process.
-            if (picture)
+            if (result)
             {
                 _streamPosition = _videoStream->getPositionInSec(timestamp);
 
@@ -266,7 +281,7 @@ PicturePtr FFMPEGMovie::getFrame(double posInSeconds)
 
     // handle (rare) EOF case
     if (avReadStatus < 0)
-        picture = PicturePtr();
+        result = T();
 
-    return picture;
+    return result;
 }
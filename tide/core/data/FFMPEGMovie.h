@@ -53,6 +53,8 @@ extern "C" {
 
 #include <QString>
 
+#include <functional>
+
 /**
  * Read and play movies using the FFMPEG library.
  */
@@ -105,6 +107,17 @@ public:
      */
     PicturePtr getFrame(double posInSeconds);
 
+    /**
+     * Get a decoded frame at the given position in seconds, without
+     * converting it to the output format.
+     *
+     * @param posInSeconds request position in seconds; clamped if out-of-bounds
+     * @return the decoded frame that was closest to posInSeconds, nullptr
+     *         otherwise
+     * @sa FFMPEGVideoFrameConverter to convert (regions of) the frame.
+     */
+    FFMPEGFramePtr getDecodedFrame(double posInSeconds);
+
 private:
     AVFormatContext* _avFormatContext = nullptr;
     std::unique_ptr<FFMPEGVideoStream> _videoStream;
@@ -116,6 +129,9 @@ private:
     bool _open(const QString& uri);
     bool _createAvFormatContext(const QString& uri);
     void _releaseAvFormatContext();
+
+    template <typename T>
+    T _decode(double posInSeconds, std::function<T()> getResult);
 };
 
 #endif
@@ -39,36 +39,88 @@
 
 #include "FFMPEGPicture.h"
 
+#include "FFMPEGFrame.h"
+
+#include <QRect>
+
 #pragma clang diagnostic ignored "-Wdeprecated"
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
-FFMPEGPicture::FFMPEGPicture(const uint width, const uint height,
-                             const TextureFormat format)
-    : _width{width}
-    , _height{height}
-    , _format{format}
+extern "C" {
+#include <libavutil/buffer.h>
+}
+
+namespace
+{
+uint _getPlaneCount(const TextureFormat format)
 {
     switch (format)
     {
     case TextureFormat::rgba:
-        _data[0] = QByteArray{int(width * height * 4), Qt::Uninitialized};
-        break;
+        return 1;
     case TextureFormat::yuv420:
     case TextureFormat::yuv422:
     case TextureFormat::yuv444:
-    {
-        const auto uvSize = getTextureSize(1);
-        const int uvDataSize = uvSize.width() * uvSize.height();
-        _data[0] = QByteArray{int(width * height), Qt::Uninitialized};
-        _data[1] = QByteArray{uvDataSize, Qt::Uninitialized};
-        _data[2] = QByteArray{uvDataSize, Qt::Uninitialized};
-        break;
-    }
+        return 3;
     default:
         throw std::logic_error("FFMPEGPicture: unsupported format");
     }
 }
 
+std::shared_ptr<AVBufferRef> _makeShared(AVBufferRef* buffer)
+{
+    if (!buffer)
+        throw std::bad_alloc();
+    return std::shared_ptr<AVBufferRef>(buffer, [](AVBufferRef* ref) {
+        av_buffer_unref(&ref);
+    });
+}
+}
+
+FFMPEGPicture::FFMPEGPicture(const uint width, const uint height,
+                             const TextureFormat format)
+    : FFMPEGPicture(width, height, format,
+                    [](const int size) { return av_buffer_alloc(size); })
+{
+}
+
+FFMPEGPicture::FFMPEGPicture(const uint width, const uint height,
+                             const TextureFormat format,
+                             const BufferAllocator& allocate)
+    : _width{width}
+    , _height{height}
+    , _format{format}
+{
+    const auto bpp = format == TextureFormat::rgba ? 4 : 1;
+    for (uint i = 0; i < _getPlaneCount(format); ++i)
+    {
+        const auto size = getTextureSize(i);
+        _lineSize[i] = size.width() * bpp;
+        _buffers[i] = _makeShared(allocate(_lineSize[i] * size.height()));
+        _data[i] = _buffers[i]->data;
+    }
+}
+
+FFMPEGPicture::FFMPEGPicture(FFMPEGFramePtr frame, const QRect& region,
+                             const TextureFormat format)
+    : _width(region.width())
+    , _height(region.height())
+    , _format{format}
+    , _frame{std::move(frame)}
+{
+    const auto bpp = format == TextureFormat::rgba ? 4 : 1;
+    const auto& avFrame = _frame->getAVFrame();
+    const int chromaShiftX = format == TextureFormat::yuv444 ? 0 : 1;
+    const int chromaShiftY = format == TextureFormat::yuv420 ? 1 : 0;
+    for (uint i = 0; i < _getPlaneCount(format); ++i)
+    {
+        const int x = i == 0 ? region.x() : region.x() >> chromaShiftX;
+        const int y = i == 0 ? region.y() : region.y() >> chromaShiftY;
+        _lineSize[i] = avFrame.linesize[i];
+        _data[i] = avFrame.data[i] + y * avFrame.linesize[i] + x * bpp;
+    }
+}
+
 int FFMPEGPicture::getWidth() const
 {
     return _width;
@@ -84,7 +136,7 @@ const uint8_t* FFMPEGPicture::getData(const uint texture) const
     if (texture >= _data.size())
         return nullptr;
 
-    return reinterpret_cast<const uint8_t*>(_data[texture].constData());
+    return _data[texture];
 }
 
 TextureFormat FFMPEGPicture::getFormat() const
@@ -94,18 +146,26 @@ TextureFormat FFMPEGPicture::getFormat() const
 
 uint8_t* FFMPEGPicture::getData(const uint texture)
 {
-    if (texture >= _data.size())
+    if (texture >= _data.size() || _frame)
         return nullptr;
 
-    return reinterpret_cast<uint8_t*>(_data[texture].data());
+    return _data[texture];
 }
 
 size_t FFMPEGPicture::getDataSize(const uint texture) const
 {
-    if (texture >= _data.size())
+    if (texture >= _data.size() || !_data[texture])
+        return 0;
+
+    return Image::getDataSize(texture);
+}
+
+int FFMPEGPicture::getLineSize(const uint texture) const
+{
+    if (texture >= _lineSize.size())
         return 0;
 
-    return _data[texture].size();
+    return _lineSize[texture];
 }
 
 QImage FFMPEGPicture::toQImage() const
@@ -113,5 +173,6 @@ QImage FFMPEGPicture::toQImage() const
     if (getFormat() != TextureFormat::rgba)
         return QImage();
 
-    return QImage(getData(), getWidth(), getHeight(), QImage::Format_RGBA8888);
+    return QImage(getData(), getWidth(), getHeight(), getLineSize(0),
+                  QImage::Format_RGBA8888);
 }
@@ -42,20 +42,50 @@
 
 #include "YUVImage.h"
 
-#include <QByteArray>
 #include <QImage>
 
 #include <array>
+#include <functional>
+
+struct AVBufferRef;
 
 /**
  * A decoded frame of the movie stream in RGBA or YUV format.
+ *
+ * The pixels are either stored in reference-counted buffers, which can be
+ * recycled from a pool, or they directly reference a region of a decoded
+ * frame, in which case the rows of each plane are strided.
  */
 class FFMPEGPicture : public YUVImage
 {
 public:
+    /** Allocates a buffer of the given size, or returns nullptr. */
+    using BufferAllocator = std::function<AVBufferRef*(int size)>;
+
     /** Allocate a new picture. */
     FFMPEGPicture(uint width, uint height, TextureFormat format);
 
+    /**
+     * Allocate a new picture.
+     * @param width of the picture
+     * @param height of the picture
+     * @param format of the picture
+     * @param allocate the allocator for the buffer of each plane
+     * @throw std::bad_alloc if a buffer could not be allocated
+     */
+    FFMPEGPicture(uint width, uint height, TextureFormat format,
+                  const BufferAllocator& allocate);
+
+    /**
+     * Reference a region of a decoded frame without copying its pixels.
+     * @param frame the decoded frame, which must be in the planar pixel format
+     *        matching the given format.
+     * @param region the region of the frame, aligned to its chroma subsampling
+     * @param format of the picture
+     */
+    FFMPEGPicture(FFMPEGFramePtr frame, const QRect& region,
+                  TextureFormat format);
+
     /** @copydoc Image::getWidth */
     int getWidth() const final;
 
@@ -68,12 +98,18 @@ public:
     /** @copydoc Image::getFormat */
     TextureFormat getFormat() const final;
 
-    /** @return write access to fill a given image texture plane. */
+    /**
+     * @return write access to fill a given image texture plane, or nullptr if
+     *         the picture references a decoded frame.
+     */
     uint8_t* getData(uint texture);
 
     /** @return data size of a given image texture plane. */
     size_t getDataSize(uint texture) const;
 
+    /** @copydoc Image::getLineSize */
+    int getLineSize(uint texture) const final;
+
     /** @return the picture as a QImage, or an empty one if format != rgba. */
     QImage toQImage() const;
 
@@ -81,7 +117,10 @@ private:
     const uint _width;
     const uint _height;
     const TextureFormat _format;
-    std::array<QByteArray, 3> _data;
+    std::array<std::shared_ptr<AVBufferRef>, 3> _buffers;
+    FFMPEGFramePtr _frame;
+    std::array<uint8_t*, 3> _data{{nullptr, nullptr, nullptr}};
+    std::array<int, 3> _lineSize{{0, 0, 0}};
 };
 
 #endif
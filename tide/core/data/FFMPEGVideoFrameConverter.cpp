@@ -48,9 +48,17 @@
 #include "FFMPEGDefines.h"
 
 extern "C" {
+#include <libavutil/buffer.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 }
 
+#include <QRect>
+
+#include <map>
+#include <tuple>
+
 AVPixelFormat _toAVPixelFormat(const TextureFormat format)
 {
     switch (format)
@@ -70,7 +78,34 @@ AVPixelFormat _toAVPixelFormat(const TextureFormat format)
 
 struct FFMPEGVideoFrameConverter::Impl
 {
-    SwsContext* swsContext = nullptr;
+    // Regions of a frame have few distinct sizes (e.g. tiles at the borders),
+    // keep one context for each instead of re-creating a single one.
+    using Key = std::tuple<int, int, AVPixelFormat, AVPixelFormat>;
+    std::map<Key, SwsContext*> swsContexts;
+
+    // Recycle the buffers of the converted pictures, one pool per plane size
+    std::map<int, AVBufferPool*> bufferPools;
+
+    AVBufferRef* getBuffer(const int size)
+    {
+        auto& pool = bufferPools[size];
+        if (!pool)
+            pool = av_buffer_pool_init(size, nullptr);
+        return pool ? av_buffer_pool_get(pool) : nullptr;
+    }
+
+    SwsContext* getContext(const QSize& size, const AVPixelFormat srcFormat,
+                           const AVPixelFormat dstFormat)
+    {
+        auto& context = swsContexts[Key{size.width(), size.height(),
+                                        srcFormat, dstFormat}];
+        if (!context)
+            context = sws_getContext(size.width(), size.height(), srcFormat,
+                                     size.width(), size.height(), dstFormat,
+                                     SWS_FAST_BILINEAR, nullptr, nullptr,
+                                     nullptr);
+        return context;
+    }
 };
 
 FFMPEGVideoFrameConverter::FFMPEGVideoFrameConverter()
@@ -80,41 +115,90 @@ FFMPEGVideoFrameConverter::FFMPEGVideoFrameConverter()
 
 FFMPEGVideoFrameConverter::~FFMPEGVideoFrameConverter()
 {
-    sws_freeContext(_impl->swsContext);
+    for (auto& context : _impl->swsContexts)
+        sws_freeContext(context.second);
+    // Buffers still in use by pictures are freed when they are released
+    for (auto& pool : _impl->bufferPools)
+        av_buffer_pool_uninit(&pool.second);
 }
 
 PicturePtr FFMPEGVideoFrameConverter::convert(const FFMPEGFrame& srcFrame,
                                               const TextureFormat format)
 {
-    auto picture =
-        std::make_shared<FFMPEGPicture>(srcFrame.getWidth(),
-                                        srcFrame.getHeight(), format);
-
-    const auto avFormat = _toAVPixelFormat(format);
-
-    _impl->swsContext =
-        sws_getCachedContext(_impl->swsContext, srcFrame.getWidth(),
-                             srcFrame.getHeight(), srcFrame.getAVPixelFormat(),
-                             picture->getWidth(), picture->getHeight(),
-                             avFormat, SWS_FAST_BILINEAR, nullptr, nullptr,
-                             nullptr);
-    if (!_impl->swsContext)
+    // The frame is not owned and might be reused, always copy its pixels
+    return _convert(srcFrame, format,
+                    QRect(0, 0, srcFrame.getWidth(), srcFrame.getHeight()));
+}
+
+PicturePtr FFMPEGVideoFrameConverter::convert(FFMPEGFramePtr srcFrame,
+                                              const TextureFormat format,
+                                              const QRect& region)
+{
+    const auto srcFormat = srcFrame->getAVPixelFormat();
+    const auto desc = av_pix_fmt_desc_get(srcFormat);
+    if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL))
+        return PicturePtr();
+
+    const auto frameRect =
+        QRect(0, 0, srcFrame->getWidth(), srcFrame->getHeight());
+    auto roi = region.intersected(frameRect);
+    // Subsampled chroma planes can only be offset by whole chroma pixels
+    roi.setLeft(roi.left() & ~((1 << desc->log2_chroma_w) - 1));
+    roi.setTop(roi.top() & ~((1 << desc->log2_chroma_h) - 1));
+    if (roi.isEmpty())
+        return PicturePtr();
+
+    if (srcFormat == _toAVPixelFormat(format))
+        return std::make_shared<FFMPEGPicture>(std::move(srcFrame), roi,
+                                               format);
+
+    return _convert(*srcFrame, format, roi);
+}
+
+PicturePtr FFMPEGVideoFrameConverter::_convert(const FFMPEGFrame& srcFrame,
+                                               const TextureFormat format,
+                                               const QRect& roi)
+{
+    const auto srcFormat = srcFrame.getAVPixelFormat();
+    const auto desc = av_pix_fmt_desc_get(srcFormat);
+    if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL))
         return PicturePtr();
 
+    auto context = _impl->getContext(roi.size(), srcFormat,
+                                     _toAVPixelFormat(format));
+    if (!context)
+        return PicturePtr();
+
+    // Point to the top-left pixel of the region in each plane of the source
+    int pixelSteps[4];
+    av_image_fill_max_pixsteps(pixelSteps, nullptr, desc);
+    const auto& avFrame = srcFrame.getAVFrame();
+    const uint8_t* srcData[4] = {nullptr, nullptr, nullptr, nullptr};
+    for (int i = 0; i < 4 && avFrame.data[i]; ++i)
+    {
+        const bool palette = i == 1 && (desc->flags & AV_PIX_FMT_FLAG_PAL);
+        const bool chroma = i == 1 || i == 2;
+        const int x = chroma ? roi.x() >> desc->log2_chroma_w : roi.x();
+        const int y = chroma ? roi.y() >> desc->log2_chroma_h : roi.y();
+        srcData[i] = palette ? avFrame.data[i]
+                             : avFrame.data[i] + y * avFrame.linesize[i] +
+                                   x * pixelSteps[i];
+    }
+
+    auto picture = std::make_shared<FFMPEGPicture>(
+        roi.width(), roi.height(), format,
+        [this](const int size) { return _impl->getBuffer(size); });
+
     uint8_t* dstData[3];
     int linesize[3];
-    for (size_t i = 0; i < 3; ++i)
+    for (uint i = 0; i < 3; ++i)
     {
         dstData[i] = picture->getData(i);
-        // width of image plane in pixels * bytes per pixel
-        linesize[i] =
-            picture->getDataSize(i) / picture->getTextureSize(i).height();
+        linesize[i] = picture->getLineSize(i);
     }
 
-    const auto outputHeight =
-        sws_scale(_impl->swsContext, srcFrame.getAVFrame().data,
-                  srcFrame.getAVFrame().linesize, 0, srcFrame.getHeight(),
-                  dstData, linesize);
+    const auto outputHeight = sws_scale(context, srcData, avFrame.linesize, 0,
+                                        roi.height(), dstData, linesize);
     if (outputHeight != picture->getHeight())
         return PicturePtr();
 
@@ -62,9 +62,28 @@ public:
      */
     PicturePtr convert(const FFMPEGFrame& srcFrame, TextureFormat format);
 
+    /**
+     * Convert a region of an AVFrame to the target format.
+     *
+     * Only the pixels of the region are read and converted. Its origin is
+     * aligned down to the chroma subsampling of the source frame if needed.
+     * If the frame is already in the target format, the picture references
+     * its pixels instead of copying them.
+     * @param srcFrame The source frame
+     * @param format The desired data output format for the picture
+     * @param region The region of the source frame to convert
+     * @return The converted picture of the size of the region, or nullptr on
+     *         error
+     */
+    PicturePtr convert(FFMPEGFramePtr srcFrame, TextureFormat format,
+                       const QRect& region);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
+
+    PicturePtr _convert(const FFMPEGFrame& srcFrame, TextureFormat format,
+                        const QRect& roi);
 };
 
 #endif
@@ -48,6 +48,9 @@
 
 // FFMPEG 3.1
 #define USE_NEW_FFMPEG_API (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 48, 0))
+// FFMPEG 2.1
+#define USE_REFCOUNTED_FRAMES                                                  \
+    (LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(55, 28, 0))
 
 FFMPEGVideoStream::FFMPEGVideoStream(AVFormatContext& avFormatContext)
     : _avFormatContext(avFormatContext)
@@ -98,6 +101,11 @@ PicturePtr FFMPEGVideoStream::decodePictureForLastPacket(
     return _frameConverter->convert(*_frame, format);
 }
 
+FFMPEGFramePtr FFMPEGVideoStream::getFrameForLastPacket() const
+{
+    return std::make_shared<FFMPEGFrame>(_frame->getAVFrame());
+}
+
 bool FFMPEGVideoStream::_isVideoPacket(const AVPacket& packet) const
 {
     return packet.stream_index == _videoStream->index;
@@ -138,6 +146,10 @@ bool FFMPEGVideoStream::_decodeToAvFrame(AVPacket& packet)
         return false;
     }
 #else
+#if USE_REFCOUNTED_FRAMES
+    // release the reference to the previous frame, which is owned by us
+    av_frame_unref(&_frame->getAVFrame());
+#endif
     int frameDecodingComplete = 0;
     const int errCode =
         avcodec_decode_video2(_videoCodecContext, &_frame->getAVFrame(),
@@ -313,6 +325,11 @@ void FFMPEGVideoStream::_openVideoStreamDecoder()
         throw std::runtime_error("No decoder found for video stream");
 
     _videoCodecContext = _videoStream->codec; // ptr, allocated by avcodec_open2
+#if USE_REFCOUNTED_FRAMES
+    // Decoded frames can then be referenced by pictures instead of copied.
+    // This is always the case with the new API.
+    _videoCodecContext->refcounted_frames = 1;
+#endif
 #endif
 
     const int ret = avcodec_open2(_videoCodecContext, codec, NULL);
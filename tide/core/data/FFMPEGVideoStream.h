@@ -98,6 +98,13 @@ public:
      */
     PicturePtr decodePictureForLastPacket(TextureFormat format);
 
+    /**
+     * Call after a successful decodeTimestamp to keep the decoded frame
+     * without converting it.
+     * @return a new reference to the decoded frame.
+     */
+    FFMPEGFramePtr getFrameForLastPacket() const;
+
     /** Get the width of the video stream. */
     unsigned int getWidth() const;
 
@@ -72,7 +72,10 @@ public:
     /** @return the pointer to the pixels of the given texture plane. */
     virtual const uint8_t* getData(uint texture = 0) const = 0;
 
-    /** @return the size of the pixel data buffer of the given texture plane. */
+    /**
+     * @return the size of the pixel data of the given texture plane, without
+     *         any padding between the rows.
+     */
     virtual size_t getDataSize(const uint texture = 0) const
     {
         const auto tex = getTextureSize(texture);
@@ -80,6 +83,17 @@ public:
         return tex.width() * tex.height() * bpp;
     }
 
+    /**
+     * @return the distance in bytes between two rows of the given texture
+     *         plane, larger than a row if the pixels are a region of a larger
+     *         buffer.
+     */
+    virtual int getLineSize(const uint texture = 0) const
+    {
+        const auto bpp = getFormat() == TextureFormat::rgba ? 4 : 1;
+        return getTextureSize(texture).width() * bpp;
+    }
+
     /** @return the format of the image. */
     virtual TextureFormat getFormat() const = 0;
 
@@ -62,6 +62,25 @@ struct TiffPyramidReader::Impl
         if (!TIFFIsTiled(tif.get()))
             throw std::runtime_error("Not a tiled tiff image");
     }
+
+    bool setDirectory(const uint lod)
+    {
+        if (!TIFFSetDirectory(tif.get(), lod))
+            return false;
+
+        // Let libtiff convert YCbCr JPEG tiles to RGB when decoding them
+        uint16 compression = COMPRESSION_NONE;
+        uint16 photometric = PHOTOMETRIC_RGB;
+        TIFFGetField(tif.get(), TIFFTAG_COMPRESSION, &compression);
+        TIFFGetField(tif.get(), TIFFTAG_PHOTOMETRIC, &photometric);
+        if (compression == COMPRESSION_JPEG &&
+            photometric == PHOTOMETRIC_YCBCR)
+        {
+            TIFFSetField(tif.get(), TIFFTAG_JPEGCOLORMODE, JPEGCOLORMODE_RGB);
+        }
+        return true;
+    }
+
     TIFFPtr tif;
 };
 
@@ -136,7 +155,7 @@ QImage TiffPyramidReader::readTile(const int i, const int j, const uint lod)
 {
     const QSize tileSize = getTileSize();
 
-    if (!TIFFSetDirectory(_impl->tif.get(), lod))
+    if (!_impl->setDirectory(lod))
     {
         put_flog(LOG_WARN, "Invalid pyramid level: %d", lod);
         return QImage();
@@ -165,7 +184,7 @@ QImage TiffPyramidReader::readTopLevelImage()
 
 QSize TiffPyramidReader::readSize(const uint lod)
 {
-    if (!TIFFSetDirectory(_impl->tif.get(), lod))
+    if (!_impl->setDirectory(lod))
     {
         put_flog(LOG_WARN, "Invalid pyramid level: %d", lod);
         return QSize();
@@ -175,7 +194,7 @@ QSize TiffPyramidReader::readSize(const uint lod)
 
 QImage TiffPyramidReader::readImage(const uint lod)
 {
-    if (!TIFFSetDirectory(_impl->tif.get(), lod))
+    if (!_impl->setDirectory(lod))
     {
         put_flog(LOG_WARN, "Invalid pyramid level: %d", lod);
         return QImage();
@@ -0,0 +1,208 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "TiffPyramidWriter.h"
+
+#include "log.h"
+
+#include <QBuffer>
+#include <QImageWriter>
+#include <tiffio.h>
+
+#include <stdexcept>
+
+namespace
+{
+// Classic TIFF files use 32-bit offsets, use BigTIFF for larger images
+const quint64 maxClassicTiffSize = 0x7fffffffu;
+
+struct TIFFDeleter
+{
+    void operator()(TIFF* file) { TIFFClose(file); }
+};
+typedef std::unique_ptr<TIFF, TIFFDeleter> TIFFPtr;
+
+const char* _getOpenMode(const QSize& imageSize)
+{
+    // Uncompressed size of the pyramid (4/3 of the full resolution image)
+    const auto rawSize = quint64(imageSize.width()) * imageSize.height() * 4;
+    return rawSize > maxClassicTiffSize ? "w8" : "w";
+}
+
+uint _computeTopLevel(const QSize& imageSize, const int tileSize)
+{
+    uint lod = 0;
+    int maxDim = std::max(imageSize.width(), imageSize.height());
+    while (maxDim > tileSize)
+    {
+        maxDim = maxDim >> 1;
+        ++lod;
+    }
+    return lod;
+}
+}
+
+struct TiffPyramidWriter::Impl
+{
+    Impl(const QString& uri, const QSize& size, const int tileSize_)
+        : tif{TIFFOpen(uri.toLocal8Bit().constData(), _getOpenMode(size))}
+        , imageSize{size}
+        , tileSize{tileSize_}
+        , topLevel{_computeTopLevel(size, tileSize_)}
+    {
+        if (!tif)
+            throw std::runtime_error("File could not be created");
+    }
+
+    void setLevelFields(const uint lod)
+    {
+        TIFF* file = tif.get();
+        const QSize size = getLevelSize(lod);
+
+        TIFFSetField(file, TIFFTAG_SUBFILETYPE,
+                     lod > 0 ? FILETYPE_REDUCEDIMAGE : 0);
+        TIFFSetField(file, TIFFTAG_IMAGEWIDTH, uint32(size.width()));
+        TIFFSetField(file, TIFFTAG_IMAGELENGTH, uint32(size.height()));
+        TIFFSetField(file, TIFFTAG_TILEWIDTH, uint32(tileSize));
+        TIFFSetField(file, TIFFTAG_TILELENGTH, uint32(tileSize));
+        TIFFSetField(file, TIFFTAG_BITSPERSAMPLE, 8);
+        TIFFSetField(file, TIFFTAG_SAMPLESPERPIXEL, 3);
+        TIFFSetField(file, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+        TIFFSetField(file, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+        TIFFSetField(file, TIFFTAG_COMPRESSION, COMPRESSION_JPEG);
+        // Tiles are complete JPEG streams (as written by Qt: YCbCr 4:2:0)
+        TIFFSetField(file, TIFFTAG_JPEGTABLESMODE, 0);
+        TIFFSetField(file, TIFFTAG_PHOTOMETRIC, PHOTOMETRIC_YCBCR);
+        TIFFSetField(file, TIFFTAG_YCBCRSUBSAMPLING, 2, 2);
+    }
+
+    QSize getLevelSize(const uint lod) const
+    {
+        return QSize{std::max(imageSize.width() >> lod, 1),
+                     std::max(imageSize.height() >> lod, 1)};
+    }
+
+    TIFFPtr tif;
+    const QSize imageSize;
+    const int tileSize;
+    const uint topLevel;
+    int currentLevel = -1;
+};
+
+TiffPyramidWriter::TiffPyramidWriter(const QString& uri,
+                                     const QSize& imageSize,
+                                     const int tileSize)
+    : _impl{new Impl{uri, imageSize, tileSize}}
+{
+}
+
+TiffPyramidWriter::~TiffPyramidWriter()
+{
+    if (_impl->currentLevel != int(_impl->topLevel))
+        put_flog(LOG_WARN, "incomplete image pyramid, stopped at level: %d",
+                 _impl->currentLevel);
+}
+
+int TiffPyramidWriter::getTileSize() const
+{
+    return _impl->tileSize;
+}
+
+uint TiffPyramidWriter::getTopPyramidLevel() const
+{
+    return _impl->topLevel;
+}
+
+QSize TiffPyramidWriter::getLevelSize(const uint lod) const
+{
+    return _impl->getLevelSize(lod);
+}
+
+QSize TiffPyramidWriter::getTilesCount(const uint lod) const
+{
+    const auto size = getLevelSize(lod);
+    const auto tileSize = _impl->tileSize;
+    return QSize{(size.width() + tileSize - 1) / tileSize,
+                 (size.height() + tileSize - 1) / tileSize};
+}
+
+void TiffPyramidWriter::startLevel(const uint lod)
+{
+    if (int(lod) != _impl->currentLevel + 1 || lod > _impl->topLevel)
+        throw std::runtime_error("Pyramid levels must be written in order");
+
+    if (lod > 0 && !TIFFWriteDirectory(_impl->tif.get()))
+        throw std::runtime_error("Could not write pyramid level");
+
+    _impl->setLevelFields(lod);
+    _impl->currentLevel = lod;
+}
+
+void TiffPyramidWriter::writeTile(const int i, const int j,
+                                  const QByteArray& jpeg)
+{
+    TIFF* file = _impl->tif.get();
+    const auto x = uint32(i * _impl->tileSize);
+    const auto y = uint32(j * _impl->tileSize);
+
+    if (!TIFFCheckTile(file, x, y, 0, 0))
+        throw std::runtime_error("Invalid tile index");
+
+    // The tile is already compressed, bypass libtiff's JPEG codec
+    const auto tile = TIFFComputeTile(file, x, y, 0, 0);
+    auto data = const_cast<char*>(jpeg.constData());
+    if (TIFFWriteRawTile(file, tile, data, jpeg.size()) != jpeg.size())
+        throw std::runtime_error("Could not write tile");
+}
+
+QByteArray TiffPyramidWriter::encodeTile(const QImage& image,
+                                         const int quality)
+{
+    QByteArray jpeg;
+    QBuffer buffer{&jpeg};
+    buffer.open(QIODevice::WriteOnly);
+
+    QImageWriter writer{&buffer, "jpeg"};
+    writer.setQuality(quality);
+    if (!writer.write(image.convertToFormat(QImage::Format_RGB32)))
+        put_flog(LOG_WARN, "could not encode tile: %s",
+                 writer.errorString().toLocal8Bit().constData());
+    return jpeg;
+}
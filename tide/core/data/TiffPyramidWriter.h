@@ -0,0 +1,116 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef TIFFPYRAMIDWRITER_H
+#define TIFFPYRAMIDWRITER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <memory>
+
+/**
+ * Writer for TIFF image pyramid files, as read by TiffPyramidReader.
+ *
+ * The levels must be written in order, from the full resolution image
+ * (level 0) to the top of the pyramid (the first level that fits in a tile).
+ * The dimensions of each level are half of those of the level beneath it.
+ *
+ * The tiles are stored as JPEG images (YCbCr, 4:2:0). They are encoded with
+ * encodeTile(), which is threadsafe, so that the caller can compress them in
+ * parallel.
+ */
+class TiffPyramidWriter
+{
+public:
+    /**
+     * Create an image pyramid file.
+     * @param uri the TIFF image file to create
+     * @param imageSize the full size of the image
+     * @param tileSize the size of the (square) tiles
+     * @throw std::runtime_error if the file could not be created
+     */
+    TiffPyramidWriter(const QString& uri, const QSize& imageSize,
+                      int tileSize);
+
+    /** Close the file, the pyramid must be complete. */
+    ~TiffPyramidWriter();
+
+    /** @return the size of the (square) tiles. */
+    int getTileSize() const;
+
+    /** @return the index of the top level of the pyramid. */
+    uint getTopPyramidLevel() const;
+
+    /** @return the size of the image at a level of the pyramid. */
+    QSize getLevelSize(uint lod) const;
+
+    /** @return the number of tiles of a level of the pyramid. */
+    QSize getTilesCount(uint lod) const;
+
+    /**
+     * Start writing the next level of the pyramid.
+     * @param lod the level, which must follow the last one.
+     * @throw std::runtime_error on error
+     */
+    void startLevel(uint lod);
+
+    /**
+     * Write a tile of the current level.
+     * @param i the column of the tile
+     * @param j the row of the tile
+     * @param jpeg the tile image, as returned by encodeTile()
+     * @throw std::runtime_error on error
+     */
+    void writeTile(int i, int j, const QByteArray& jpeg);
+
+    /**
+     * Compress a tile image for writing. threadsafe.
+     * @param image the tile, padded to the tile size
+     * @param quality the JPEG quality [1-100]
+     * @return the JPEG-compressed tile
+     */
+    static QByteArray encodeTile(const QImage& image, int quality);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
+};
+
+#endif
@@ -52,6 +52,40 @@
             put_flog(LOG_ERROR, "Error detected! (%d)", err); \
     }
 
+namespace
+{
+/**
+ * Derived datatype describing a list of buffers by their absolute address,
+ * to transfer them with a single MPI operation starting at MPI_BOTTOM.
+ */
+class BuffersType
+{
+public:
+    explicit BuffersType(const MPIBuffers& buffers)
+    {
+        std::vector<int> lengths;
+        std::vector<MPI_Aint> displacements;
+        for (const auto& buffer : buffers)
+        {
+            if (buffer.size == 0)
+                continue;
+            MPI_Aint address;
+            MPI_Get_address(buffer.data, &address);
+            lengths.push_back(int(buffer.size));
+            displacements.push_back(address);
+        }
+        MPI_Type_create_hindexed(int(lengths.size()), lengths.data(),
+                                 displacements.data(), MPI_BYTE, &_type);
+        MPI_Type_commit(&_type);
+    }
+
+    ~BuffersType() { MPI_Type_free(&_type); }
+    MPI_Datatype get() const { return _type; }
+private:
+    MPI_Datatype _type;
+};
+}
+
 MPIChannel::MPIChannel(int argc, char* argv[])
     : _mpiContext(new MPIContext(argc, argv))
     , _mpiComm(MPI_COMM_WORLD)
@@ -79,6 +113,11 @@ MPIChannel::~MPIChannel()
         MPI_Comm_disconnect(&_mpiComm);
 }
 
+void MPIChannel::setWaitPolicy(const MPIWaitPolicy& policy)
+{
+    MPI_Nospin_setWaitPolicy(policy);
+}
+
 int MPIChannel::getRank() const
 {
     return _mpiRank;
@@ -102,6 +141,16 @@ int MPIChannel::globalSum(const int localValue) const
     return globalValue;
 }
 
+std::vector<int64_t> MPIChannel::globalMin(
+    const std::vector<int64_t>& localValues) const
+{
+    std::vector<int64_t> globalValues(localValues.size());
+    MPI_CHECK(MPI_Allreduce((void*)localValues.data(),
+                            (void*)globalValues.data(), localValues.size(),
+                            MPI_LONG_LONG_INT, MPI_MIN, _mpiComm));
+    return globalValues;
+}
+
 bool MPIChannel::isMessageAvailable(const int src)
 {
     int flag;
@@ -122,6 +171,31 @@ void MPIChannel::send(const MPIMessageType type,
                               _mpiComm));
 }
 
+void MPIChannel::sendMessage(const MPIMessageType type,
+                             const std::string& serializedData, const int dest)
+{
+    MPIHeader mh;
+    mh.size = serializedData.size();
+    mh.type = type;
+
+    _send(mh, dest);
+    send(type, serializedData, dest);
+}
+
+void MPIChannel::sendMessage(const MPIMessageType type,
+                             const std::string& serializedData,
+                             const MPIBuffers& payload, const int dest)
+{
+    sendMessage(type, serializedData, dest);
+
+    if (!_isValid(dest))
+        return;
+
+    const BuffersType buffers{payload};
+    MPI_CHECK(MPI_Send_Nospin(MPI_BOTTOM, 1, buffers.get(), dest, int(type),
+                              _mpiComm));
+}
+
 void MPIChannel::sendAll(const MPIMessageType type)
 {
     MPIHeader mh;
@@ -146,6 +220,16 @@ void MPIChannel::broadcast(const MPIMessageType type,
                         MPI_BYTE, _mpiRank, _mpiComm));
 }
 
+void MPIChannel::broadcast(const MPIMessageType type,
+                           const std::string& serializedData,
+                           const MPIBuffers& payload)
+{
+    broadcast(type, serializedData);
+
+    const BuffersType buffers{payload};
+    MPI_CHECK(MPI_Bcast(MPI_BOTTOM, 1, buffers.get(), _mpiRank, _mpiComm));
+}
+
 MPIHeader MPIChannel::receiveHeader(const int src)
 {
     MPI_Status status;
@@ -189,6 +273,21 @@ void MPIChannel::receiveBroadcast(char* dataBuffer, const size_t messageSize,
         MPI_Bcast((void*)dataBuffer, messageSize, MPI_BYTE, src, _mpiComm));
 }
 
+void MPIChannel::receive(const MPIBuffers& payload, const int src,
+                         const int tag)
+{
+    const BuffersType buffers{payload};
+    MPI_Status status;
+    MPI_CHECK(MPI_Recv_Nospin(MPI_BOTTOM, 1, buffers.get(), src, tag,
+                              _mpiComm, &status));
+}
+
+void MPIChannel::receiveBroadcast(const MPIBuffers& payload, const int src)
+{
+    const BuffersType buffers{payload};
+    MPI_CHECK(MPI_Bcast(MPI_BOTTOM, 1, buffers.get(), src, _mpiComm));
+}
+
 std::vector<uint64_t> MPIChannel::gatherAll(const uint64_t value)
 {
     std::vector<uint64_t> results(_mpiSize);
@@ -41,6 +41,7 @@
 #define MPICHANNEL_H
 
 #include "MPIHeader.h"
+#include "MPIWaitPolicy.h"
 #include "types.h"
 
 #include <mpi.h>
@@ -92,6 +93,13 @@ public:
     /** Destructor, closes the MPI channel. */
     ~MPIChannel();
 
+    /**
+     * Set how the blocking operations of all channels wait for messages.
+     * Not threadsafe, call it while no communication is in progress.
+     * @param policy the wait policy
+     */
+    static void setWaitPolicy(const MPIWaitPolicy& policy);
+
     /** Get the rank of this process. */
     int getRank() const;
 
@@ -108,6 +116,14 @@ public:
      */
     int globalSum(int localValue) const;
 
+    /**
+     * Get the element-wise minimum of the given values across all processes.
+     * @param localValues The values, in the same number on all processes
+     * @return the minimum of each value
+     */
+    std::vector<int64_t> globalMin(
+        const std::vector<int64_t>& localValues) const;
+
     /**
      * Send data to a single process
      * @param type The type of data to send
@@ -116,6 +132,29 @@ public:
      */
     void send(MPIMessageType type, const std::string& serializedData, int dest);
 
+    /**
+     * Send a message preceded by its header to a single process
+     * @param type The message type
+     * @param serializedData The serialized data
+     * @param dest The destination process
+     * @see receiveHeader()
+     * @see receive()
+     */
+    void sendMessage(MPIMessageType type, const std::string& serializedData,
+                     int dest);
+
+    /**
+     * Send a message preceded by its header to a single process, followed by
+     * a payload gathered in place from the given buffers.
+     * @param type The message type
+     * @param serializedData The serialized data, which describes the payload
+     * @param payload The buffers to send in a second message
+     * @param dest The destination process
+     * @see receive(const MPIBuffers&, int, int)
+     */
+    void sendMessage(MPIMessageType type, const std::string& serializedData,
+                     const MPIBuffers& payload, int dest);
+
     /**
      * Send a signal to all processes
      * @param type The type of signal
@@ -129,6 +168,17 @@ public:
      */
     void broadcast(MPIMessageType type, const std::string& serializedData);
 
+    /**
+     * Send a brodcast message to all other processes, followed by a payload
+     * gathered in place from the given buffers.
+     * @param type The message type
+     * @param serializedData The serialized data, which describes the payload
+     * @param payload The buffers to broadcast in a second message
+     * @see receiveBroadcast(const MPIBuffers&, int)
+     */
+    void broadcast(MPIMessageType type, const std::string& serializedData,
+                   const MPIBuffers& payload);
+
     /** Nonblocking probe for messages from a given source */
     bool isMessageAvailable(int src);
 
@@ -161,6 +211,17 @@ public:
      */
     void receive(char* dataBuffer, size_t messageSize, int src, int tag = 0);
 
+    /**
+     * Receive a payload from a specific process, scattered in place to the
+     * given buffers.
+     * This call is blocking.
+     * @param payload The target buffers, which must match the sent ones in
+     *        total size
+     * @param src The source process
+     * @param tag The message tag/type
+     */
+    void receive(const MPIBuffers& payload, int src, int tag);
+
     /**
      * Recieve a broadcast.
      * This call is blocking.
@@ -171,6 +232,15 @@ public:
      */
     void receiveBroadcast(char* dataBuffer, size_t messageSize, int src);
 
+    /**
+     * Recieve a broadcast payload, scattered in place to the given buffers.
+     * This call is blocking.
+     * @param payload The target buffers, which must match the sent ones in
+     *        total size
+     * @param src The source process
+     */
+    void receiveBroadcast(const MPIBuffers& payload, int src);
+
     /**
      * Gather the values accross all the processes.
      * @param value The local value
@@ -40,7 +40,9 @@
 #ifndef MPIHEADER_H
 #define MPIHEADER_H
 
+#include <cstddef>
 #include <stdint.h>
+#include <vector>
 
 /** The type of MPI message. */
 enum class MPIMessageType
@@ -58,7 +60,10 @@ enum class MPIMessageType
     IMAGE,
     TIMER,
     PIXELSTREAM_CLOSE,
-    LOCK
+    LOCK,
+    PIXELSTREAM_PARTIAL,
+    REQUEST_DISPLAYGROUP,
+    TRACE_STATISTICS
 };
 
 /** Fixed-size message header. */
@@ -71,4 +76,18 @@ struct MPIHeader
     uint32_t size;
 };
 
+/**
+ * A memory region transferred in place by the scatter/gather operations of the
+ * MPIChannel, without being copied into a serialization buffer.
+ */
+struct MPIBuffer
+{
+    /** Start of the region. */
+    char* data;
+
+    /** Size of the region in bytes. */
+    size_t size;
+};
+using MPIBuffers = std::vector<MPIBuffer>;
+
 #endif
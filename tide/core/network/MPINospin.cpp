@@ -45,29 +45,83 @@
 #include "MPINospin.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <ctime>
+#include <thread>
 
 namespace
 {
+using clock = std::chrono::steady_clock;
+using microseconds = std::chrono::microseconds;
+
 const size_t nsec_start = 1000;
-const size_t nsec_max = 100000;
+
+// Moving average of the fraction of waits completed within the spin time
+const float hitRateWeight = 0.125f;
+const float minHitRate = 0.25f;
+
+MPIWaitPolicy waitPolicy;
+std::atomic<float> spinHitRate{1.f};
+
+template <typename Test>
+void _waitUntil(const Test& isDone)
+{
+    if (isDone())
+        return;
+
+    const auto start = clock::now();
+    const auto spinTime = microseconds(waitPolicy.spinTime);
+    const auto yieldTime = spinTime + microseconds(waitPolicy.yieldTime);
+    const size_t nsec_max = std::max(size_t(waitPolicy.maxSleepTime) * 1000,
+                                     nsec_start);
+    const bool spin = !waitPolicy.adaptive || spinHitRate >= minHitRate;
+
+    timespec ts{0, nsec_start};
+    do
+    {
+        const auto elapsed = clock::now() - start;
+        if (spin && elapsed < spinTime)
+            continue;
+        if (elapsed < yieldTime)
+            std::this_thread::yield();
+        else
+        {
+            nanosleep(&ts, nullptr);
+            ts.tv_nsec = std::min(size_t(ts.tv_nsec << 1), nsec_max);
+        }
+    } while (!isDone());
+
+    if (waitPolicy.adaptive)
+    {
+        // Also measured when not spinning, to detect when it is useful again
+        const bool hit = clock::now() - start <= spinTime;
+        spinHitRate = spinHitRate * (1.f - hitRateWeight) +
+                      (hit ? hitRateWeight : 0.f);
+    }
+}
+}
+
+void MPI_Nospin_setWaitPolicy(const MPIWaitPolicy& policy)
+{
+    waitPolicy = policy;
+    spinHitRate = 1.f;
+}
+
+const MPIWaitPolicy& MPI_Nospin_getWaitPolicy()
+{
+    return waitPolicy;
 }
 
 int MPI_Probe_Nospin(const int source, const int tag, MPI_Comm comm,
                      MPI_Status* status)
 {
+    int ret = MPI_SUCCESS;
     int flag = 0;
-    int ret = MPI_Iprobe(source, tag, comm, &flag, status);
-    if (ret != MPI_SUCCESS)
-        return ret;
-
-    timespec ts{0, nsec_start};
-    while (!flag)
-    {
-        nanosleep(&ts, nullptr);
-        ts.tv_nsec = std::min(size_t(ts.tv_nsec << 1), nsec_max);
+    _waitUntil([&] {
         ret = MPI_Iprobe(source, tag, comm, &flag, status);
-    }
+        return flag || ret != MPI_SUCCESS;
+    });
     return ret;
 }
 
@@ -79,15 +133,12 @@ int MPI_Send_Nospin(void* buff, const int count, MPI_Datatype datatype,
     if (ret != MPI_SUCCESS)
         return ret;
 
-    timespec ts{0, nsec_start};
-    int flag = 0;
-    while (!flag)
-    {
-        nanosleep(&ts, nullptr);
-        ts.tv_nsec = std::min(size_t(ts.tv_nsec << 1), nsec_max);
+    _waitUntil([&req] {
+        int flag = 0;
         // Always returns success. Status unused for single send operations.
         MPI_Request_get_status(req, &flag, MPI_STATUS_IGNORE);
-    }
+        return flag != 0;
+    });
     return MPI_Wait(&req, MPI_STATUS_IGNORE); // release the request object
 }
 
@@ -100,13 +151,10 @@ int MPI_Recv_Nospin(void* buff, const int count, MPI_Datatype datatype,
     if (ret != MPI_SUCCESS)
         return ret;
 
-    timespec ts{0, nsec_start};
-    int flag = 0;
-    while (!flag)
-    {
-        nanosleep(&ts, nullptr);
-        ts.tv_nsec = std::min(size_t(ts.tv_nsec << 1), nsec_max);
+    _waitUntil([&req, status] {
+        int flag = 0;
         MPI_Request_get_status(req, &flag, status); // Always returns success
-    }
+        return flag != 0;
+    });
     return MPI_Wait(&req, status); // release the request object
 }
@@ -40,23 +40,35 @@
 #ifndef MPISENDRECV_H
 #define MPISENDRECV_H
 
+#include "MPIWaitPolicy.h"
+
 #include <mpi.h>
 
 /**
- * Implements a blocking, non-spinning MPI_Probe to minimize CPU usage.
+ * Set the wait policy of the Nospin functions.
+ * Not threadsafe, call it while no communication is in progress.
+ * @param policy the new wait policy.
+ */
+void MPI_Nospin_setWaitPolicy(const MPIWaitPolicy& policy);
+
+/** @return the wait policy of the Nospin functions. */
+const MPIWaitPolicy& MPI_Nospin_getWaitPolicy();
+
+/**
+ * Implements a blocking MPI_Probe which waits according to the wait policy.
  * @see MPI_Probe
  */
 int MPI_Probe_Nospin(int source, int tag, MPI_Comm comm, MPI_Status* status);
 
 /**
- * Implements a blocking, non-spinning MPI_Send to minimize CPU usage.
+ * Implements a blocking MPI_Send which waits according to the wait policy.
  * @see MPI_Send
  */
 int MPI_Send_Nospin(void* buff, int count, MPI_Datatype datatype, int dest,
                     int tag, MPI_Comm comm);
 
 /**
- * Implements a blocking, non-spinning MPI_Recv to minimize CPU usage.
+ * Implements a blocking MPI_Recv which waits according to the wait policy.
  * @see MPI_Recv
  */
 int MPI_Recv_Nospin(void* buff, int count, MPI_Datatype datatype, int from,
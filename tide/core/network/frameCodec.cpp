@@ -0,0 +1,195 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "frameCodec.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+const uint32_t FRAME_MAGIC = 0x54465246;
+const uint32_t FRAME_CODEC_VERSION = 2;
+
+struct FrameHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t segmentCount;
+    uint32_t uriSize;
+    uint64_t payloadSize;
+};
+
+struct SegmentDescriptor
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    int32_t dataType;
+    int32_t view;
+    uint32_t dataSize;
+};
+
+template <typename T>
+void _append(std::string& data, const T& object)
+{
+    data.append(reinterpret_cast<const char*>(&object), sizeof(T));
+}
+
+template <typename T>
+T _read(const char*& data, const char* end)
+{
+    if (size_t(end - data) < sizeof(T))
+        throw std::runtime_error("Truncated pixel stream frame description");
+    T object;
+    std::memcpy(&object, data, sizeof(T));
+    data += sizeof(T);
+    return object;
+}
+}
+
+namespace frameCodec
+{
+std::string encode(const deflect::Frame& frame)
+{
+    const auto uri = frame.uri.toUtf8();
+    uint64_t payloadSize = 0;
+    for (const auto& segment : frame.segments)
+        payloadSize += segment.imageData.size();
+    const FrameHeader header{FRAME_MAGIC, FRAME_CODEC_VERSION,
+                             uint32_t(frame.segments.size()),
+                             uint32_t(uri.size()), payloadSize};
+
+    std::string data;
+    data.reserve(sizeof(FrameHeader) + uri.size() +
+                 frame.segments.size() * sizeof(SegmentDescriptor));
+    _append(data, header);
+    data.append(uri.constData(), uri.size());
+
+    for (const auto& segment : frame.segments)
+    {
+        const auto& params = segment.parameters;
+        const SegmentDescriptor descriptor{params.x,
+                                           params.y,
+                                           params.width,
+                                           params.height,
+                                           int32_t(params.dataType),
+                                           int32_t(segment.view),
+                                           uint32_t(segment.imageData.size())};
+        _append(data, descriptor);
+    }
+    return data;
+}
+
+MPIBuffers getPayload(const deflect::Frame& frame)
+{
+    MPIBuffers payload;
+    payload.reserve(frame.segments.size());
+    for (const auto& segment : frame.segments)
+    {
+        // MPI only reads from the buffers when sending
+        const auto data = const_cast<char*>(segment.imageData.constData());
+        payload.push_back({data, size_t(segment.imageData.size())});
+    }
+    return payload;
+}
+
+deflect::FramePtr decode(const char* data, const size_t size)
+{
+    const auto end = data + size;
+
+    const auto header = _read<FrameHeader>(data, end);
+    if (header.magic != FRAME_MAGIC || header.version != FRAME_CODEC_VERSION)
+        throw std::runtime_error("Invalid pixel stream frame description");
+    if (size_t(end - data) < header.uriSize ||
+        size_t(end - data - header.uriSize) / sizeof(SegmentDescriptor) <
+            header.segmentCount)
+    {
+        throw std::runtime_error("Truncated pixel stream frame description");
+    }
+
+    auto frame = std::make_shared<deflect::Frame>();
+    frame->uri = QString::fromUtf8(data, int(header.uriSize));
+    data += header.uriSize;
+
+    uint64_t payloadSize = 0;
+    frame->segments.resize(header.segmentCount);
+    for (auto& segment : frame->segments)
+    {
+        const auto descriptor = _read<SegmentDescriptor>(data, end);
+        segment.parameters.x = descriptor.x;
+        segment.parameters.y = descriptor.y;
+        segment.parameters.width = descriptor.width;
+        segment.parameters.height = descriptor.height;
+        segment.parameters.dataType = deflect::DataType(descriptor.dataType);
+        segment.view = deflect::View(descriptor.view);
+        if (descriptor.dataSize > uint32_t(std::numeric_limits<int>::max()))
+            throw std::runtime_error("Invalid pixel stream segment size");
+        segment.imageData.resize(int(descriptor.dataSize));
+        payloadSize += descriptor.dataSize;
+    }
+    if (payloadSize != header.payloadSize)
+        throw std::runtime_error("Inconsistent pixel stream payload size");
+    return frame;
+}
+
+uint64_t getPayloadSize(const char* data, const size_t size)
+{
+    FrameHeader header;
+    if (size < sizeof(FrameHeader))
+        return 0;
+    std::memcpy(&header, data, sizeof(FrameHeader));
+    if (header.magic != FRAME_MAGIC || header.version != FRAME_CODEC_VERSION)
+        return 0;
+    return header.payloadSize;
+}
+
+MPIBuffers getPayloadTarget(deflect::Frame& frame)
+{
+    MPIBuffers payload;
+    payload.reserve(frame.segments.size());
+    for (auto& segment : frame.segments)
+        payload.push_back({segment.imageData.data(),
+                           size_t(segment.imageData.size())});
+    return payload;
+}
+}
@@ -0,0 +1,92 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef FRAMECODEC_H
+#define FRAMECODEC_H
+
+#include "network/MPIHeader.h"
+
+#include <deflect/Frame.h>
+
+#include <string>
+
+/**
+ * Wire format of the pixel stream frames sent to the wall processes.
+ *
+ * A frame is transferred as a compact description of its segments (fixed
+ * header, uri, one descriptor per segment) followed by the segments' image
+ * data as a separate payload. The payload is sent directly from the segments
+ * and received directly into the segments of the new frame, so the image data
+ * is never copied into or out of an intermediate serialization buffer.
+ */
+namespace frameCodec
+{
+/** @return the serialized description of the frame. */
+std::string encode(const deflect::Frame& frame);
+
+/** @return the image data of the frame to send after its description. */
+MPIBuffers getPayload(const deflect::Frame& frame);
+
+/**
+ * Create a frame from its serialized description.
+ *
+ * The image data of the segments is allocated but not filled.
+ * @param data the serialized description
+ * @param size the size of the description
+ * @return the new frame
+ * @throw std::runtime_error if the description is invalid
+ */
+deflect::FramePtr decode(const char* data, size_t size);
+
+/**
+ * Get the size of the payload of a frame, even if its description can not be
+ * decoded, so that the payload can be received and discarded.
+ * @param data the serialized description
+ * @param size the size of the description
+ * @return the size of the payload in bytes, 0 if the fixed header of the
+ *         description is invalid
+ */
+uint64_t getPayloadSize(const char* data, size_t size);
+
+/** @return the image data of a decoded frame to receive the payload in. */
+MPIBuffers getPayloadTarget(deflect::Frame& frame);
+}
+
+#endif
@@ -189,6 +189,7 @@ signals:
 
 private:
     friend class boost::serialization::access;
+    friend class DisplayGroupPatch;
 
     /** No-argument constructor required for serialization. */
     DisplayGroup();
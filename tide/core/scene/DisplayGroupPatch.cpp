@@ -0,0 +1,161 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "DisplayGroupPatch.h"
+
+#include "DisplayGroup.h"
+
+#include <boost/make_shared.hpp>
+
+namespace
+{
+using WindowMap = std::map<QUuid, ContentWindowPtr>;
+
+WindowMap _mapByID(const ContentWindowPtrs& windows)
+{
+    WindowMap map;
+    for (const auto& window : windows)
+        map[window->getID()] = window;
+    return map;
+}
+
+ContentWindowPtr _find(const WindowMap& windows, const QUuid& id)
+{
+    const auto it = windows.find(id);
+    return it != windows.end() ? it->second : ContentWindowPtr();
+}
+}
+
+DisplayGroupPatch::DisplayGroupPatch(const DisplayGroup& group,
+                                     const uint64_t sequence,
+                                     WindowVersions& sentVersions,
+                                     const bool snapshot)
+    : _sequence{sequence}
+    , _snapshot{snapshot}
+    , _coordinates{group.getCoordinates()}
+{
+    WindowVersions versions;
+    for (const auto& window : group.getContentWindows())
+    {
+        const auto& id = window->getID();
+        const auto version = window->getVersion();
+        const auto it = sentVersions.find(id);
+        if (snapshot || it == sentVersions.end() || it->second != version)
+            _windows.push_back(window);
+
+        _order.push_back(id);
+        versions[id] = version;
+    }
+    // Forget the removed windows, they must be sent again if re-added
+    sentVersions = std::move(versions);
+
+    for (const auto& window : group.getFocusedWindows())
+        _focused.push_back(window->getID());
+    for (const auto& window : group.getPanels())
+        _panels.push_back(window->getID());
+    if (const auto fullscreen = group.getFullscreenWindow())
+        _fullscreen = fullscreen->getID();
+}
+
+uint64_t DisplayGroupPatch::getSequence() const
+{
+    return _sequence;
+}
+
+bool DisplayGroupPatch::isSnapshot() const
+{
+    return _snapshot;
+}
+
+const ContentWindowPtrs& DisplayGroupPatch::getContentWindows() const
+{
+    return _windows;
+}
+
+DisplayGroupPtr DisplayGroupPatch::apply(const DisplayGroup* previous) const
+{
+    if (!_snapshot && !previous)
+        return DisplayGroupPtr();
+
+    const auto modified = _mapByID(_windows);
+    const auto unchanged = _snapshot || !previous
+                               ? WindowMap()
+                               : _mapByID(previous->getContentWindows());
+
+    auto group = boost::make_shared<DisplayGroup>(_coordinates.size());
+    group->setCoordinates(_coordinates);
+
+    // The windows are not watched for changes: the unchanged ones are shared
+    // with the previous group and must remain read-only.
+    for (const auto& id : _order)
+    {
+        auto window = _find(modified, id);
+        if (!window)
+            window = _find(unchanged, id);
+        if (!window)
+            return DisplayGroupPtr();
+        group->_contentWindows.push_back(window);
+    }
+
+    const auto windows = _mapByID(group->_contentWindows);
+    for (const auto& id : _focused)
+    {
+        if (auto window = _find(windows, id))
+            group->_focusedWindows.insert(window);
+    }
+    for (const auto& id : _panels)
+    {
+        if (auto window = _find(windows, id))
+            group->_panels.insert(window);
+    }
+    if (!_fullscreen.isNull())
+        group->_fullscreenWindow = _find(windows, _fullscreen);
+
+    return group;
+}
+
+void DisplayGroupPatch::moveToThread(QThread* thread)
+{
+    for (auto window : _windows)
+    {
+        window->moveToThread(thread);
+        window->getContent()->moveToThread(thread);
+    }
+}
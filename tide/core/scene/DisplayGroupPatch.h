@@ -0,0 +1,141 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef DISPLAYGROUPPATCH_H
+#define DISPLAYGROUPPATCH_H
+
+#include "ContentWindow.h" // member, needed for serialization
+#include "serialization/includes.h"
+#include "types.h"
+
+#include <QRectF>
+#include <QUuid>
+
+#include <map>
+
+/**
+ * Incremental update of a replicated DisplayGroup.
+ *
+ * A patch always carries the group-level state (coordinates, stacking order,
+ * focus, fullscreen and panels) as window ids, but only the ContentWindows
+ * which were added or modified since the previous patch. Unchanged windows are
+ * taken from the previously applied DisplayGroup when the patch is applied.
+ *
+ * Patches are numbered so that the receiver can detect a missing update and
+ * ask for a snapshot, which is a patch that contains all the windows.
+ */
+class DisplayGroupPatch
+{
+public:
+    /** Version of each window, as last sent to the receivers. */
+    using WindowVersions = std::map<QUuid, size_t>;
+
+    /** No-argument constructor required for serialization. */
+    DisplayGroupPatch() = default;
+
+    /**
+     * Create a patch from the current state of a DisplayGroup.
+     *
+     * @param group the DisplayGroup to replicate.
+     * @param sequence the number of this patch; must be incremented by one for
+     *        each patch sent.
+     * @param sentVersions the window versions of the previous patch; updated
+     *        with the versions of the windows in this patch.
+     * @param snapshot include all windows regardless of their version.
+     */
+    DisplayGroupPatch(const DisplayGroup& group, uint64_t sequence,
+                      WindowVersions& sentVersions, bool snapshot);
+
+    /** @return the sequence number of this patch. */
+    uint64_t getSequence() const;
+
+    /** @return true if the patch contains all the windows of the group. */
+    bool isSnapshot() const;
+
+    /** @return the added or modified windows carried by this patch. */
+    const ContentWindowPtrs& getContentWindows() const;
+
+    /**
+     * Build the next DisplayGroup by applying this patch.
+     *
+     * The unchanged windows are shared with the previous group, which is left
+     * untouched.
+     * @param previous the group that resulted from the previous patch; can be
+     *        nullptr for a snapshot.
+     * @return the new DisplayGroup, or nullptr if the patch could not be
+     *         applied because a window is missing from the previous group.
+     */
+    DisplayGroupPtr apply(const DisplayGroup* previous) const;
+
+    /**
+     * Move the windows carried by the patch to the given QThread.
+     * @param thread the target thread.
+     */
+    void moveToThread(QThread* thread);
+
+private:
+    friend class boost::serialization::access;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        // clang-format off
+        ar & _sequence;
+        ar & _snapshot;
+        ar & _coordinates;
+        ar & _order;
+        ar & _windows;
+        ar & _focused;
+        ar & _fullscreen;
+        ar & _panels;
+        // clang-format on
+    }
+
+    uint64_t _sequence = 0;
+    bool _snapshot = false;
+    QRectF _coordinates;
+    std::vector<QUuid> _order;
+    ContentWindowPtrs _windows;
+    std::vector<QUuid> _focused;
+    QUuid _fullscreen;
+    std::vector<QUuid> _panels;
+};
+
+#endif
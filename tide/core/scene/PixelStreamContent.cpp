@@ -48,6 +48,7 @@ IMPLEMENT_SERIALIZE_FOR_XML(PixelStreamContent)
 namespace
 {
 const QString ICON_KEYBOARD("qrc:///img/keyboard.svg");
+const uint assembledTileSize = 512;
 }
 
 PixelStreamContent::PixelStreamContent(const QString& uri, const bool keyboard)
@@ -58,6 +59,11 @@ PixelStreamContent::PixelStreamContent(const QString& uri, const bool keyboard)
         _createActions();
 }
 
+uint PixelStreamContent::getAssembledTileSize()
+{
+    return assembledTileSize;
+}
+
 CONTENT_TYPE PixelStreamContent::getType() const
 {
     return CONTENT_TYPE_PIXEL_STREAM;
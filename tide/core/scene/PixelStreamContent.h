@@ -78,6 +78,13 @@ public:
 
     /** Parse data received from the deflect::Stream. */
     virtual void parseData(QByteArray data) { Q_UNUSED(data); }
+
+    /**
+     * @return the size of the tiles that the wall processes assemble from the
+     *         segments of a stream, to align the routing of segments on them.
+     */
+    static uint getAssembledTileSize();
+
 signals:
     /** Emitted when an Event occured. */
     void notify(deflect::Event event);
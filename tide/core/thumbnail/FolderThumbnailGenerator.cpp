@@ -106,8 +106,8 @@ void FolderThumbnailGenerator::_paintThumbnailsMosaic(
         // Avoid recursion into subfolders
         if (QDir(filename).exists())
             thumbnail = _createFolderImage(QDir(filename), false);
-        else
-            thumbnail = thumbnail::create(filename, rect[i].size().toSize());
+        else // Full size to share the stored thumbnails of the file browser
+            thumbnail = thumbnail::create(filename, _size);
 
         // Draw the thumbnail centered in its rectangle, preserving aspect ratio
         QSizeF paintedSize(thumbnail.size());
@@ -50,9 +50,17 @@ ImagePyramidThumbnailGenerator::ImagePyramidThumbnailGenerator(
 
 QImage ImagePyramidThumbnailGenerator::generate(const QString& filename) const
 {
-    const QImage image = TiffPyramidReader{filename}.readTopLevelImage();
+    TiffPyramidReader reader{filename};
+
+    // Read the smallest level of the pyramid that covers the thumbnail
+    const auto size = reader.readSize(0).scaled(_size, _aspectRatioMode);
+    auto lod = reader.findLevel(size);
+    if (lod > 0 && reader.readSize(lod).width() < size.width())
+        --lod;
+
+    const QImage image = reader.readImage(lod);
 
     if (!image.isNull())
-        return image.scaled(_size, _aspectRatioMode);
+        return image.scaled(_size, _aspectRatioMode, Qt::SmoothTransformation);
     return createErrorImage("pyramid");
 }
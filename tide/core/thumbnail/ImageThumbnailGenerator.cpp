@@ -39,13 +39,20 @@
 
 #include "ImageThumbnailGenerator.h"
 
-#include <QFileInfo>
 #include <QImageReader>
 
 #include "log.h"
 
-#define SIZEOF_MEGABYTE (1024 * 1024)
-#define MAX_IMAGE_FILE_SIZE (100 * SIZEOF_MEGABYTE)
+namespace
+{
+// Formats whose decoder can skip the full resolution (DCT scaling in libjpeg)
+const QList<QByteArray> SCALED_DECODE_FORMATS{"jpeg", "jpg"};
+// DCT scaling reduces each dimension by at most 8, i.e. the size by 64
+const qint64 MAX_DECODE_SCALE_FACTOR = 64;
+// Limit of the size of the decoded image, at full resolution for the formats
+// that do not support scaled decoding
+const qint64 MAX_DECODED_IMAGE_SIZE = qint64(512) * 1024 * 1024;
+}
 
 ImageThumbnailGenerator::ImageThumbnailGenerator(const QSize& size)
     : ThumbnailGenerator(size)
@@ -55,17 +62,40 @@ ImageThumbnailGenerator::ImageThumbnailGenerator(const QSize& size)
 QImage ImageThumbnailGenerator::generate(const QString& filename) const
 {
     QImageReader reader(filename);
-    if (reader.canRead())
+    if (!reader.canRead())
     {
-        if (QFileInfo(filename).size() > MAX_IMAGE_FILE_SIZE)
+        put_flog(LOG_ERROR, "could not open image file: '%s'",
+                 filename.toLatin1().constData());
+        return createErrorImage("image");
+    }
+
+    const auto imageSize = reader.size();
+    if (imageSize.isValid())
+    {
+        const bool scaledDecode =
+            SCALED_DECODE_FORMATS.contains(reader.format().toLower());
+        auto decodedSize =
+            qint64(imageSize.width()) * imageSize.height() * sizeof(QRgb);
+        if (scaledDecode)
+            decodedSize /= MAX_DECODE_SCALE_FACTOR;
+        if (decodedSize > MAX_DECODED_IMAGE_SIZE)
             return _createLargeImagePlaceholder();
 
-        return reader.read().scaled(_size, _aspectRatioMode);
+        const auto thumbnailSize = imageSize.scaled(_size, _aspectRatioMode);
+        if (thumbnailSize.width() < imageSize.width())
+            reader.setScaledSize(thumbnailSize);
     }
 
-    put_flog(LOG_ERROR, "could not open image file: '%s'",
-             filename.toLatin1().constData());
-    return createErrorImage("image");
+    const auto image = reader.read();
+    if (image.isNull())
+    {
+        put_flog(LOG_ERROR, "could not read image file: '%s'",
+                 filename.toLatin1().constData());
+        return createErrorImage("image");
+    }
+    if (image.size() == image.size().scaled(_size, _aspectRatioMode))
+        return image;
+    return image.scaled(_size, _aspectRatioMode, Qt::SmoothTransformation);
 }
 
 QImage ImageThumbnailGenerator::_createLargeImagePlaceholder() const
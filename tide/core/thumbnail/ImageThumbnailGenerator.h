@@ -54,9 +54,12 @@ public:
     /**
      * Generate a thumbnail of an image.
      *
+     * The image is decoded directly at the thumbnail resolution if the format
+     * supports it (JPEG), otherwise at full resolution and then scaled.
+     *
      * @param filename the filename of the image.
-     * @return the desired thumbnail, or a placeholder if the file is too large
-     *         (>100MB) or an error occured.
+     * @return the desired thumbnail, or a placeholder if the image is too large
+     *         to be decoded at full resolution (>512MB) or an error occured.
      */
     QImage generate(const QString& filename) const final;
 
@@ -48,12 +48,22 @@
 
 #define THUMBNAIL_FONT_SIZE 30
 
+namespace
+{
+const QString PLACEHOLDER_KEY("placeholder");
+}
+
 ThumbnailGenerator::ThumbnailGenerator(const QSize& size)
     : _size(size)
     , _aspectRatioMode(Qt::KeepAspectRatio)
 {
 }
 
+bool ThumbnailGenerator::isPlaceholder(const QImage& image)
+{
+    return !image.text(PLACEHOLDER_KEY).isEmpty();
+}
+
 QImage ThumbnailGenerator::createErrorImage(const QString& message) const
 {
     QImage img = createGradientImage(Qt::red, Qt::darkRed);
@@ -94,4 +104,6 @@ void ThumbnailGenerator::paintText(QImage& img, const QString& text) const
     int flags = Qt::AlignVCenter | Qt::AlignHCenter | Qt::TextWrapAnywhere;
     painter.drawText(img.rect(), flags, text);
     painter.end();
+
+    img.setText(PLACEHOLDER_KEY, "true");
 }
@@ -72,6 +72,14 @@ public:
      */
     virtual QImage generate(const QString& filename) const = 0;
 
+    /**
+     * Check if an image is a placeholder rather than an actual thumbnail.
+     *
+     * Placeholders are images with text painted by paintText(), such as the
+     * error images. They are not worth storing.
+     */
+    static bool isPlaceholder(const QImage& image);
+
 protected:
     /** Target size for the thumbnails. */
     const QSize _size;
@@ -86,7 +94,7 @@ protected:
     QImage createGradientImage(const QColor& bgcolor1,
                                const QColor& bgcolor2) const;
 
-    /** Paint text over an image, for example on top of a placeholder image. */
+    /** Paint text over an image, which marks it as a placeholder image. */
     void paintText(QImage& img, const QString& text) const;
 };
 
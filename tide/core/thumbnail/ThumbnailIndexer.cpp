@@ -0,0 +1,88 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "ThumbnailIndexer.h"
+
+#include "log.h"
+#include "scene/ContentFactory.h"
+#include "thumbnail.h"
+
+#include <QDirIterator>
+#include <QElapsedTimer>
+
+ThumbnailIndexer::ThumbnailIndexer(const QString& directory, const QSize& size)
+    : _directory{directory}
+    , _size{size}
+{
+}
+
+ThumbnailIndexer::~ThumbnailIndexer()
+{
+    requestInterruption();
+    wait();
+}
+
+void ThumbnailIndexer::run()
+{
+    // Only use the cpu time left over by the rest of the application
+    setPriority(QThread::IdlePriority);
+
+    auto filters = ContentFactory::getSupportedFilesFilter();
+    filters.append("*.dcx");
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int count = 0;
+    QDirIterator it{_directory, filters, QDir::Files,
+                    QDirIterator::Subdirectories};
+    while (it.hasNext() && !isInterruptionRequested())
+    {
+        // Loading stored thumbnails would only reorder the store's LRU
+        const auto filename = it.next();
+        if (thumbnail::isStored(filename, _size))
+            continue;
+        thumbnail::create(filename, _size);
+        ++count;
+    }
+
+    put_flog(LOG_INFO, "indexed thumbnails of %d new files in '%s' in %d ms",
+             count, _directory.toLocal8Bit().constData(), int(timer.elapsed()));
+}
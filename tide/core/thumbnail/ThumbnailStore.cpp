@@ -0,0 +1,191 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "ThumbnailStore.h"
+
+#include "fileCache.h"
+#include "log.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace
+{
+const QString THUMBNAIL_FORMAT{"png"};
+
+QString _getKey(const QString& filename, const QSize& size)
+{
+    const auto variant = QString("%1x%2").arg(size.width()).arg(size.height());
+    return fileCache::getKey(filename, variant);
+}
+}
+
+ThumbnailStore::ThumbnailStore(const QString& directory, const qint64 maxSize)
+    : _directory{directory}
+    , _maxSize{maxSize}
+{
+    if (!QDir().mkpath(_directory))
+        put_flog(LOG_WARN, "could not create thumbnail store: '%s'",
+                 _directory.toLocal8Bit().constData());
+    _loadEntries();
+}
+
+QImage ThumbnailStore::load(const QString& filename, const QSize& size)
+{
+    const auto key = _getKey(filename, size);
+    if (key.isEmpty() || !contains(filename, size))
+        return QImage();
+
+    const auto path = _getPath(key);
+    const auto image = QImage{path, THUMBNAIL_FORMAT.toLatin1()};
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        if (image.isNull()) // evicted by another process or corrupted
+        {
+            _remove(key);
+            return image;
+        }
+        const auto it = _entries.find(key);
+        if (it == _entries.end())
+            return image;
+        _lru.splice(_lru.begin(), _lru, it->second.lru);
+    }
+    // The modification date persists the LRU order for the next sessions
+    fileCache::touch(path);
+    return image;
+}
+
+bool ThumbnailStore::save(const QString& filename, const QSize& size,
+                          const QImage& image)
+{
+    const auto key = _getKey(filename, size);
+    if (key.isEmpty() || image.isNull())
+        return false;
+
+    const auto path = _getPath(key);
+    QSaveFile file{path};
+    if (!file.open(QIODevice::WriteOnly) ||
+        !image.save(&file, THUMBNAIL_FORMAT.toLatin1()) || !file.commit())
+    {
+        put_flog(LOG_WARN, "could not store thumbnail: '%s'",
+                 path.toLocal8Bit().constData());
+        return false;
+    }
+    const auto fileSize = QFileInfo{path}.size();
+
+    const std::lock_guard<std::mutex> lock{_mutex};
+    _remove(key); // in case another thread stored it concurrently
+    _add(key, fileSize);
+    _evict();
+    return true;
+}
+
+bool ThumbnailStore::contains(const QString& filename, const QSize& size)
+{
+    const auto key = _getKey(filename, size);
+    if (key.isEmpty())
+        return false;
+
+    {
+        const std::lock_guard<std::mutex> lock{_mutex};
+        if (_entries.count(key))
+            return true;
+    }
+
+    // The thumbnail may have been stored by another process
+    const QFileInfo file{_getPath(key)};
+    if (!file.isFile())
+        return false;
+
+    const std::lock_guard<std::mutex> lock{_mutex};
+    if (!_entries.count(key))
+        _add(key, file.size());
+    return true;
+}
+
+qint64 ThumbnailStore::getSize() const
+{
+    const std::lock_guard<std::mutex> lock{_mutex};
+    return _totalSize;
+}
+
+void ThumbnailStore::_loadEntries()
+{
+    // Restore the LRU order of the previous sessions, oldest entries first
+    const auto filter = QStringList{"*." + THUMBNAIL_FORMAT};
+    const auto sort = QDir::Time | QDir::Reversed;
+    const auto files = QDir{_directory}.entryInfoList(filter, QDir::Files, sort);
+    for (const auto& file : files)
+        _add(file.completeBaseName(), file.size());
+    _evict();
+}
+
+QString ThumbnailStore::_getPath(const QString& key) const
+{
+    return _directory + '/' + key + '.' + THUMBNAIL_FORMAT;
+}
+
+void ThumbnailStore::_add(const QString& key, const qint64 size)
+{
+    _lru.push_front(key);
+    _entries[key] = Entry{size, _lru.begin()};
+    _totalSize += size;
+}
+
+void ThumbnailStore::_remove(const QString& key)
+{
+    const auto it = _entries.find(key);
+    if (it == _entries.end())
+        return;
+    _totalSize -= it->second.size;
+    _lru.erase(it->second.lru);
+    _entries.erase(it);
+}
+
+void ThumbnailStore::_evict()
+{
+    while (_totalSize > _maxSize && !_lru.empty())
+    {
+        const auto key = _lru.back();
+        QFile::remove(_getPath(key));
+        _remove(key);
+    }
+}
@@ -0,0 +1,125 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef THUMBNAILSTORE_H
+#define THUMBNAILSTORE_H
+
+#include <QImage>
+#include <QString>
+
+#include <list>
+#include <map>
+#include <mutex>
+
+/**
+ * Persistent on-disk store of file thumbnails.
+ *
+ * Entries are addressed by the file path, modification date and size, and by
+ * the requested thumbnail dimensions, so that modified files are never served
+ * an outdated image. The total size of the store is capped; the least
+ * recently used entries are evicted first.
+ *
+ * The store is thread-safe and several processes can share the same
+ * directory.
+ */
+class ThumbnailStore
+{
+public:
+    /**
+     * Open a thumbnail store, creating its directory if needed.
+     *
+     * @param directory where the thumbnails are stored.
+     * @param maxSize the maximum size of the store in bytes.
+     */
+    ThumbnailStore(const QString& directory, qint64 maxSize);
+
+    /**
+     * Load the thumbnail of a file.
+     *
+     * @param filename the file for which to get the thumbnail.
+     * @param size the requested size of the thumbnail.
+     * @return the stored thumbnail, or a null image if there is none.
+     */
+    QImage load(const QString& filename, const QSize& size);
+
+    /**
+     * Store the thumbnail of a file, evicting old entries if needed.
+     *
+     * @param filename the file to which the thumbnail belongs.
+     * @param size the requested size of the thumbnail.
+     * @param image the thumbnail.
+     * @return true on success.
+     */
+    bool save(const QString& filename, const QSize& size, const QImage& image);
+
+    /**
+     * Check if the thumbnail of a file is in the store.
+     *
+     * @param filename the file for which to look for a thumbnail.
+     * @param size the requested size of the thumbnail.
+     */
+    bool contains(const QString& filename, const QSize& size);
+
+    /** @return the total size of the stored thumbnails in bytes. */
+    qint64 getSize() const;
+
+private:
+    struct Entry
+    {
+        qint64 size;
+        std::list<QString>::iterator lru;
+    };
+
+    const QString _directory;
+    const qint64 _maxSize;
+
+    mutable std::mutex _mutex;
+    std::map<QString, Entry> _entries;
+    std::list<QString> _lru; // keys of the entries, most recently used first
+    qint64 _totalSize = 0;
+
+    void _loadEntries();
+    QString _getPath(const QString& key) const;
+    void _add(const QString& key, qint64 size);
+    void _remove(const QString& key);
+    void _evict();
+};
+
+#endif
@@ -40,7 +40,9 @@
 #include "thumbnail.h"
 
 #include "StreamThumbnailGenerator.h"
+#include "ThumbnailGenerator.h"
 #include "ThumbnailGeneratorFactory.h"
+#include "ThumbnailStore.h"
 #include "config.h"
 #include "scene/Content.h"
 
@@ -49,6 +51,13 @@
 #include "scene/WebbrowserContent.h"
 #endif
 
+#include <QFileInfo>
+
+namespace
+{
+std::shared_ptr<ThumbnailStore> _store;
+}
+
 namespace thumbnail
 {
 QImage create(const Content& content, const QSize& size)
@@ -66,7 +75,32 @@ QImage create(const Content& content, const QSize& size)
 
 QImage create(const QString& filename, const QSize& size)
 {
+    const auto store = std::atomic_load(&_store);
+    // Folder thumbnails are cheap mosaics of the (stored) files they contain
+    const bool useStore = store && QFileInfo(filename).isFile();
+    if (useStore)
+    {
+        const auto image = store->load(filename, size);
+        if (!image.isNull())
+            return image;
+    }
+
     auto generator = ThumbnailGeneratorFactory::getGenerator(filename, size);
-    return generator->generate(filename);
+    const auto image = generator->generate(filename);
+    // Placeholders may be the result of a transient error, retry next time
+    if (useStore && !ThumbnailGenerator::isPlaceholder(image))
+        store->save(filename, size, image);
+    return image;
+}
+
+bool isStored(const QString& filename, const QSize& size)
+{
+    const auto store = std::atomic_load(&_store);
+    return store && store->contains(filename, size);
+}
+
+void setStore(std::shared_ptr<ThumbnailStore> store)
+{
+    std::atomic_store(&_store, store);
 }
 }
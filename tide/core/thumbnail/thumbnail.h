@@ -42,7 +42,10 @@
 
 #include <QImage>
 
+#include <memory>
+
 class Content;
+class ThumbnailStore;
 
 /**
  * Utility functions for thumbnail generation.
@@ -66,6 +69,22 @@ QImage create(const Content& content, const QSize& size);
  * @return a valid image of the desired size (can be a placeholder).
  */
 QImage create(const QString& filename, const QSize& size);
+
+/**
+ * Check if the thumbnail of a file is in the persistent store.
+ *
+ * @param filename the file for which to look for a thumbnail.
+ * @param size the size of the thumbnail.
+ * @return true if create() would return the stored thumbnail.
+ */
+bool isStored(const QString& filename, const QSize& size);
+
+/**
+ * Set the persistent store used by create() for the thumbnails of files.
+ *
+ * @param store the store to use, or nullptr to always generate the images.
+ */
+void setStore(std::shared_ptr<ThumbnailStore> store);
 }
 
 #endif
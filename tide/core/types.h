@@ -94,6 +94,16 @@ enum class TextureType
     Dynamic
 };
 
+/**
+ * The policies for generating texture mipmaps after each update.
+ */
+enum class MipmapPolicy
+{
+    never,
+    lazy, // only while the texture is displayed below a scale threshold
+    always
+};
+
 class Configuration;
 class Content;
 class ContentSynchronizer;
@@ -101,12 +111,14 @@ class ContentWindow;
 class DataProvider;
 class DataSource;
 class DisplayGroup;
+class DisplayGroupPatch;
 class DisplayGroupRenderer;
 class FFMPEGFrame;
 class FFMPEGMovie;
 class FFMPEGPicture;
 class FFMPEGVideoFrameConverter;
 class FFMPEGVideoStream;
+class FrameSync;
 class Image;
 class ImageSource;
 class ImagePyramidDataSource;
@@ -119,6 +131,7 @@ class MovieUpdater;
 class MPIChannel;
 class NetworkBarrier;
 class Options;
+class PboRing;
 class PDFContent;
 class PixelStreamUpdater;
 class PixelStreamWindowManager;
@@ -137,8 +150,10 @@ typedef std::shared_ptr<ContentSynchronizer> ContentSynchronizerSharedPtr;
 typedef boost::shared_ptr<ContentWindow> ContentWindowPtr;
 typedef boost::shared_ptr<DisplayGroup> DisplayGroupPtr;
 typedef boost::shared_ptr<const DisplayGroup> DisplayGroupConstPtr;
+typedef std::shared_ptr<DisplayGroupPatch> DisplayGroupPatchPtr;
 typedef std::shared_ptr<Image> ImagePtr;
 typedef boost::shared_ptr<InactivityTimer> InactivityTimerPtr;
+typedef std::shared_ptr<FFMPEGFrame> FFMPEGFramePtr;
 typedef std::shared_ptr<FFMPEGPicture> PicturePtr;
 typedef boost::shared_ptr<Markers> MarkersPtr;
 typedef boost::shared_ptr<MPIChannel> MPIChannelPtr;
@@ -73,6 +73,36 @@ size_t LoggingUtility::getWindowCount() const
     return _windowCounter;
 }
 
+size_t LoggingUtility::getStreamFrameCount() const
+{
+    return _streamFrameCounter;
+}
+
+quint64 LoggingUtility::getLastStreamFrameBytesSaved() const
+{
+    return _lastStreamFrameBytesSaved;
+}
+
+quint64 LoggingUtility::getAverageStreamFrameBytesSaved() const
+{
+    if (_streamFrameCounter == 0)
+        return 0;
+    return _streamBytesSavedTotal / _streamFrameCounter;
+}
+
+size_t LoggingUtility::getDisplayGroupSentCount() const
+{
+    return _displayGroupSentCounter;
+}
+
+size_t LoggingUtility::getDisplayGroupSuppressedCount() const
+{
+    // The last modifications may not have been sent yet
+    if (_displayGroupModifiedCounter < _displayGroupSentCounter)
+        return 0;
+    return _displayGroupModifiedCounter - _displayGroupSentCounter;
+}
+
 void LoggingUtility::contentWindowAdded(ContentWindowPtr contentWindow)
 {
     connect(contentWindow.get(), &ContentWindow::stateChanged,
@@ -121,6 +151,41 @@ void LoggingUtility::powerStateChanged(const ScreenState state)
     _lastPowerStateChanged = _getTimeStamp();
 }
 
+void LoggingUtility::pixelStreamSent(const quint64 bytesSent,
+                                     const quint64 bytesSaved)
+{
+    Q_UNUSED(bytesSent);
+    ++_streamFrameCounter;
+    _lastStreamFrameBytesSaved = bytesSaved;
+    _streamBytesSavedTotal += bytesSaved;
+}
+
+void LoggingUtility::displayGroupModified()
+{
+    ++_displayGroupModifiedCounter;
+}
+
+void LoggingUtility::displayGroupSent()
+{
+    ++_displayGroupSentCounter;
+}
+
+std::map<QString, FrameTraceStatistics> LoggingUtility::getTraceStatistics()
+    const
+{
+    auto statistics = _traceStatistics;
+    const auto masterStatistics = FrameTracer::instance().getStatistics();
+    if (!masterStatistics.isEmpty())
+        statistics["master"] = masterStatistics;
+    return statistics;
+}
+
+void LoggingUtility::traceStatisticsReceived(
+    const FrameTraceStatistics statistics, const QString node)
+{
+    _traceStatistics[node] = statistics;
+}
+
 QString LoggingUtility::getLastScreenStateChanged() const
 {
     return _lastPowerStateChanged;
@@ -42,8 +42,11 @@
 
 #include <QObject>
 
+#include "FrameTracer.h"
 #include "types.h"
 
+#include <map>
+
 /**
  * Provides information/statistics on application usage.
  */
@@ -76,6 +79,29 @@ public:
     /** @return the number of currently open windows. */
     size_t getWindowCount() const;
 
+    /** @return the number of pixel stream frames sent to the wall. */
+    size_t getStreamFrameCount() const;
+
+    /** @return the bytes saved by routing the last pixel stream frame. */
+    quint64 getLastStreamFrameBytesSaved() const;
+
+    /** @return the average bytes saved per pixel stream frame. */
+    quint64 getAverageStreamFrameBytesSaved() const;
+
+    /** @return the number of DisplayGroup updates sent to the wall. */
+    size_t getDisplayGroupSentCount() const;
+
+    /** @return the number of DisplayGroup modifications merged into another
+     * update. */
+    size_t getDisplayGroupSuppressedCount() const;
+
+    /**
+     * @return the frame latency statistics of each process that has traced
+     *         any, i.e. the last ones received from the wall processes and
+     *         the current ones of the master ("master").
+     */
+    std::map<QString, FrameTraceStatistics> getTraceStatistics() const;
+
 public slots:
     /** Log the event, update the counters and update the timestamp of last
      * interaction */
@@ -92,6 +118,18 @@ public slots:
     /** Log the event and update the timestamp of last power action */
     void powerStateChanged(const ScreenState state);
 
+    /** Update the pixel stream counters after sending a frame to the wall */
+    void pixelStreamSent(quint64 bytesSent, quint64 bytesSaved);
+
+    /** Update the DisplayGroup counters after a modification */
+    void displayGroupModified();
+
+    /** Update the DisplayGroup counters after sending an update to the wall */
+    void displayGroupSent();
+
+    /** Store the frame latency statistics received from a wall process */
+    void traceStatisticsReceived(FrameTraceStatistics statistics, QString node);
+
 private:
     size_t _windowCounter = 0;
     size_t _windowCounterTotal = 0;
@@ -100,6 +138,15 @@ private:
     QString _lastInteractionTime;
     size_t _interactionCounter = 0;
 
+    size_t _streamFrameCounter = 0;
+    quint64 _lastStreamFrameBytesSaved = 0;
+    quint64 _streamBytesSavedTotal = 0;
+
+    size_t _displayGroupModifiedCounter = 0;
+    size_t _displayGroupSentCounter = 0;
+
+    std::map<QString, FrameTraceStatistics> _traceStatistics;
+
     QString _lastPowerStateChanged;
     ScreenState _state = ScreenState::UNDEF;
 
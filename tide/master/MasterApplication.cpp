@@ -41,6 +41,7 @@
 #include "MasterApplication.h"
 
 #include "ContentLoader.h"
+#include "FrameTracer.h"
 #include "InactivityTimer.h"
 #include "MasterConfiguration.h"
 #include "MasterDisplayGroupRenderer.h"
@@ -52,6 +53,7 @@
 #include "control/DisplayGroupController.h"
 #include "localstreamer/PixelStreamerLauncher.h"
 #include "log.h"
+#include "network/DisplayGroupPublisher.h"
 #include "network/MasterFromWallChannel.h"
 #include "network/MasterToForkerChannel.h"
 #include "network/MasterToWallChannel.h"
@@ -60,6 +62,8 @@
 #include "scene/Markers.h"
 #include "scene/Options.h"
 #include "scene/WebbrowserContent.h"
+#include "thumbnail/ThumbnailStore.h"
+#include "thumbnail/thumbnail.h"
 #include "ui/MasterQuickView.h"
 #include "ui/MasterWindow.h"
 
@@ -92,8 +96,10 @@ MasterApplication::MasterApplication(int& argc_, char** argv_,
     : QApplication(argc_, argv_)
     , _config(new MasterConfiguration(config))
     , _masterToForkerChannel(new MasterToForkerChannel(forkChannel))
-    , _masterToWallChannel(new MasterToWallChannel(worldChannel))
+    , _masterToWallChannel(new MasterToWallChannel(worldChannel, *_config))
     , _masterFromWallChannel(new MasterFromWallChannel(worldChannel))
+    , _displayGroupPublisher(
+          new DisplayGroupPublisher(_config->getMaxUpdateRate()))
     , _lock(ScreenLock::create())
     , _markers(Markers::create())
     , _options(Options::create())
@@ -118,6 +124,10 @@ MasterApplication::~MasterApplication()
     _deflectServer.reset();
     _pixelStreamerLauncher.reset();
 
+    put_flog(LOG_INFO, "DisplayGroup updates sent: %lu, suppressed: %lu",
+             _displayGroupPublisher->getSentCount(),
+             _displayGroupPublisher->getSuppressedCount());
+
     // Make sure the send quit happens after any pending send operation;
     // If a send operation is not matched by a receive, the MPI connection
     // will block indefintely when trying to disconnect.
@@ -178,6 +188,14 @@ void MasterApplication::_save(const QString sessionFile, BoolCallback callback)
 
 void MasterApplication::_init()
 {
+    if (_config->getThumbnailStoreSize() > 0)
+    {
+        const auto maxSize =
+            qint64(_config->getThumbnailStoreSize()) * 1024 * 1024;
+        thumbnail::setStore(std::make_shared<ThumbnailStore>(
+            _config->getThumbnailStoreDir(), maxSize));
+    }
+
     _displayGroup.reset(new DisplayGroup(_config->getTotalSize()));
     connect(_displayGroup.get(), &DisplayGroup::contentWindowRemoved, this,
             &MasterApplication::_deleteTempContentFile);
@@ -365,6 +383,9 @@ void MasterApplication::_setupMPIConnections()
             _masterToForkerChannel.get(), &MasterToForkerChannel::sendStart);
 
     connect(_displayGroup.get(), &DisplayGroup::modified,
+            _displayGroupPublisher.get(), &DisplayGroupPublisher::update);
+
+    connect(_displayGroupPublisher.get(), &DisplayGroupPublisher::publish,
             _masterToWallChannel.get(),
             [this](DisplayGroupPtr displayGroup) {
                 _masterToWallChannel->sendAsync(displayGroup);
@@ -416,6 +437,13 @@ void MasterApplication::_setupMPIConnections()
                 &MasterFromWallChannel::receivedRequestFrame,
                 _deflectServer.get(), &deflect::Server::requestFrame);
 
+        // Traced until the frame is sent by the MasterToWallChannel
+        connect(_deflectServer.get(), &deflect::Server::receivedFrame,
+                [](deflect::FramePtr frame) {
+                    FrameTracer::instance().beginAsync(
+                        TraceStage::streamReceive, uintptr_t(frame.get()));
+                });
+
         connect(_deflectServer.get(), &deflect::Server::receivedFrame,
                 _masterToWallChannel.get(), &MasterToWallChannel::send);
     }
@@ -425,6 +453,12 @@ void MasterApplication::_setupMPIConnections()
             _pixelStreamWindowManager.get(),
             &PixelStreamWindowManager::handleStreamEnd);
 
+    connect(_masterFromWallChannel.get(),
+            &MasterFromWallChannel::receivedDisplayGroupRequest, this,
+            [this]() {
+                _masterToWallChannel->sendSnapshotAsync(_displayGroup);
+            });
+
     connect(_masterFromWallChannel.get(),
             &MasterFromWallChannel::receivedScreenshot,
             _screenshotAssembler.get(), &ScreenshotAssembler::addImage);
@@ -512,6 +546,18 @@ void MasterApplication::_initRestInterface()
     connect(_displayGroup.get(), &DisplayGroup::contentWindowMovedToFront,
             _logger.get(), &LoggingUtility::contentWindowMovedToFront);
 
+    connect(_masterToWallChannel.get(), &MasterToWallChannel::pixelStreamSent,
+            _logger.get(), &LoggingUtility::pixelStreamSent);
+
+    connect(_displayGroup.get(), &DisplayGroup::modified, _logger.get(),
+            &LoggingUtility::displayGroupModified);
+    connect(_displayGroupPublisher.get(), &DisplayGroupPublisher::publish,
+            _logger.get(), &LoggingUtility::displayGroupSent);
+
+    connect(_masterFromWallChannel.get(),
+            &MasterFromWallChannel::receivedTraceStatistics, _logger.get(),
+            &LoggingUtility::traceStatisticsReceived);
+
     _restInterface->exposeStatistics(*_logger);
 
     const auto& appController = _restInterface->getAppController();
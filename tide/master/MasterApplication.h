@@ -56,6 +56,7 @@
 #include <QFutureWatcher>
 #include <QThread>
 
+class DisplayGroupPublisher;
 class MasterDisplayGroupRenderer;
 class MasterQuickView;
 class MasterToWallChannel;
@@ -106,6 +107,7 @@ private:
     std::unique_ptr<MasterToForkerChannel> _masterToForkerChannel;
     std::unique_ptr<MasterToWallChannel> _masterToWallChannel;
     std::unique_ptr<MasterFromWallChannel> _masterFromWallChannel;
+    std::unique_ptr<DisplayGroupPublisher> _displayGroupPublisher;
     QThread _mpiSendThread;
     QThread _mpiReceiveThread;
 
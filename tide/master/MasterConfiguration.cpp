@@ -42,22 +42,28 @@
 #include "log.h"
 
 #include <QDomElement>
+#include <QStandardPaths>
 #include <QtXmlPatterns>
+#include <algorithm>
 #include <stdexcept>
 
 namespace
 {
 const int DEFAULT_WEBSERVICE_PORT = 8888;
 const int DEFAULT_PLANAR_TIMEOUT = 60;
+const int DEFAULT_MAX_UPDATE_RATE = 60;
+const int DEFAULT_THUMBNAIL_STORE_SIZE_MB = 512;
 const QString DEFAULT_URL("http://www.google.com");
 const QString DEFAULT_WHITEBOARD_SAVE_FOLDER("/tmp/");
 }
 
 MasterConfiguration::MasterConfiguration(const QString& filename)
     : Configuration(filename)
+    , _thumbnailStoreSize(DEFAULT_THUMBNAIL_STORE_SIZE_MB)
     , _webServicePort(DEFAULT_WEBSERVICE_PORT)
     , _backgroundColor(Qt::black)
     , _planarTimeout(DEFAULT_PLANAR_TIMEOUT)
+    , _maxUpdateRate(DEFAULT_MAX_UPDATE_RATE)
 {
     loadMasterSettings();
 }
@@ -73,6 +79,7 @@ void MasterConfiguration::loadMasterSettings()
     loadContentDirectory(query);
     loadSessionsDirectory(query);
     loadUploadDirectory(query);
+    loadThumbnailStore(query);
     loadLauncherSettings(query);
     loadWebService(query);
     loadAppLauncher(query);
@@ -86,6 +93,10 @@ void MasterConfiguration::loadMasterProcessInfo(QXmlQuery& query)
 {
     query.setQuery("string(/configuration/masterProcess/@headless)");
     getBool(query, _headless);
+
+    query.setQuery("string(/configuration/masterProcess/@maxUpdateRate)");
+    getInt(query, _maxUpdateRate);
+    _maxUpdateRate = std::max(_maxUpdateRate, 0);
 }
 
 void MasterConfiguration::loadContentDirectory(QXmlQuery& query)
@@ -112,6 +123,20 @@ void MasterConfiguration::loadUploadDirectory(QXmlQuery& query)
         _uploadDir = QDir::tempPath();
 }
 
+void MasterConfiguration::loadThumbnailStore(QXmlQuery& query)
+{
+    query.setQuery("string(/configuration/thumbnails/@directory)");
+    getString(query, _thumbnailStoreDir);
+    if (_thumbnailStoreDir.isEmpty())
+        _thumbnailStoreDir = QStandardPaths::writableLocation(
+                                 QStandardPaths::GenericCacheLocation) +
+                             "/tide/thumbnails";
+
+    query.setQuery("string(/configuration/thumbnails/@maxSize)");
+    getInt(query, _thumbnailStoreSize);
+    _thumbnailStoreSize = std::max(_thumbnailStoreSize, 0);
+}
+
 void MasterConfiguration::loadLauncherSettings(QXmlQuery& query)
 {
     query.setQuery("string(/configuration/launcher/@display)");
@@ -196,11 +221,26 @@ int MasterConfiguration::getPlanarTimeout() const
     return _planarTimeout;
 }
 
+int MasterConfiguration::getMaxUpdateRate() const
+{
+    return _maxUpdateRate;
+}
+
 const QString& MasterConfiguration::getSessionsDir() const
 {
     return _sessionsDir;
 }
 
+const QString& MasterConfiguration::getThumbnailStoreDir() const
+{
+    return _thumbnailStoreDir;
+}
+
+int MasterConfiguration::getThumbnailStoreSize() const
+{
+    return _thumbnailStoreSize;
+}
+
 const QString& MasterConfiguration::getUploadDir() const
 {
     return _uploadDir;
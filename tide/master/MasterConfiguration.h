@@ -65,6 +65,12 @@ public:
      */
     bool getHeadless() const;
 
+    /**
+     * Get the maximum rate at which the scene is sent to the wall processes.
+     * @return updates per second, 0 if unlimited; default value if unspecified.
+     */
+    int getMaxUpdateRate() const;
+
     /**
      * Get the root directory for opening contents.
      * @return directory path
@@ -83,6 +89,18 @@ public:
      */
     const QString& getSessionsDir() const;
 
+    /**
+     * Get the directory where the thumbnails of files are stored.
+     * @return directory path; default value if unspecified.
+     */
+    const QString& getThumbnailStoreDir() const;
+
+    /**
+     * Get the maximum size of the thumbnail store.
+     * @return size in MB, 0 to disable the store; default value if unspecified.
+     */
+    int getThumbnailStoreSize() const;
+
     /**
      * Get the DISPLAY identifier in string format for starting the Launcher.
      */
@@ -184,6 +202,7 @@ private:
     void loadPlanarSettings(QXmlQuery& query);
     void loadSessionsDirectory(QXmlQuery& query);
     void loadUploadDirectory(QXmlQuery& query);
+    void loadThumbnailStore(QXmlQuery& query);
     void loadWebService(QXmlQuery& query);
     void loadWhiteboard(QXmlQuery& query);
     void loadAppLauncher(QXmlQuery& query);
@@ -196,6 +215,9 @@ private:
     QString _uploadDir;
     QString _appLauncherFile;
 
+    QString _thumbnailStoreDir;
+    int _thumbnailStoreSize;
+
     QString _launcherDisplay;
     QString _demoServiceUrl;
     QString _demoServiceImageFolder;
@@ -209,6 +231,8 @@ private:
 
     QString _planarSerialPort;
     int _planarTimeout;
+
+    int _maxUpdateRate;
 };
 
 #endif
@@ -44,6 +44,7 @@
 
 #include <QImage>
 #include <QObject>
+#include <QRegion>
 #include <QSize>
 
 /**
@@ -69,8 +70,13 @@ public slots:
     virtual void processEvent(deflect::Event event) = 0;
 
 signals:
-    /** Emit this signal after a new image has been generated. */
-    void imageUpdated(QImage image);
+    /**
+     * Emit this signal after a new image has been generated.
+     * @param image the new image
+     * @param region the area of the image which changed since the previous
+     *        one, the full image if its size changed
+     */
+    void imageUpdated(QImage image, QRegion region);
 
     /** Emit this signal to update the state of the remote Tide Content. */
     void stateChanged(QByteArray data);
@@ -0,0 +1,147 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "StreamSender.h"
+
+#include <deflect/Stream.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+const int maxQuality = 90;
+const int minQuality = 40;
+const int qualityDecrement = 10;
+const int qualityIncrement = 2;
+}
+
+StreamSender::StreamSender(deflect::Stream& stream,
+                           const size_t maxFramesInFlight, const bool compress)
+    : _stream(stream)
+    , _maxFramesInFlight{std::max(maxFramesInFlight, size_t(1))}
+    , _compress{compress}
+    , _quality{maxQuality}
+{
+}
+
+StreamSender::~StreamSender()
+{
+    finish();
+}
+
+bool StreamSender::send(QImage image)
+{
+    _popSentFrames();
+    _adaptQuality();
+    while (_pendingFrames.size() >= _maxFramesInFlight)
+        _waitForOldestFrame();
+
+    if (!_success)
+        return false;
+
+    // QImage Format_RGB32 (0xffRRGGBB) corresponds in fact to
+    // GL_BGRA == deflect::BGRA. Uncompressed segments carry no pixel format,
+    // the walls expect them in RGBA.
+    const auto format = image.format() == QImage::Format_RGBA8888
+                            ? deflect::RGBA
+                            : deflect::BGRA;
+    deflect::ImageWrapper deflectImage(image.constBits(), image.width(),
+                                       image.height(), format);
+    if (_compress)
+    {
+        deflectImage.compressionPolicy = deflect::COMPRESSION_ON;
+        deflectImage.compressionQuality = _quality;
+    }
+    else
+        deflectImage.compressionPolicy = deflect::COMPRESSION_OFF;
+
+    // The image data must remain valid until the frame is sent
+    auto sent = _stream.sendAndFinish(deflectImage);
+    _pendingFrames.push_back(PendingFrame{std::move(image), std::move(sent)});
+    return true;
+}
+
+bool StreamSender::finish()
+{
+    while (!_pendingFrames.empty())
+        _waitForOldestFrame();
+    return _success;
+}
+
+int StreamSender::getQuality() const
+{
+    return _quality;
+}
+
+size_t StreamSender::getQueueDepth() const
+{
+    return _pendingFrames.size();
+}
+
+void StreamSender::_popSentFrames()
+{
+    const auto ready = [](const PendingFrame& frame) {
+        return frame.sent.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+    };
+    // Frames are sent in order
+    while (!_pendingFrames.empty() && ready(_pendingFrames.front()))
+        _waitForOldestFrame();
+}
+
+void StreamSender::_waitForOldestFrame()
+{
+    if (!_pendingFrames.front().sent.get())
+        _success = false;
+    _pendingFrames.pop_front();
+}
+
+void StreamSender::_adaptQuality()
+{
+    if (!_compress)
+        return;
+
+    const auto depth = _pendingFrames.size();
+    if (depth >= _maxFramesInFlight)
+        _quality = std::max(_quality - qualityDecrement, minQuality);
+    else if (depth <= _maxFramesInFlight / 2)
+        _quality = std::min(_quality + qualityIncrement, maxQuality);
+}
@@ -0,0 +1,126 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef STREAMSENDER_H
+#define STREAMSENDER_H
+
+#include <QImage>
+
+#include <deque>
+#include <future>
+
+namespace deflect
+{
+class Stream;
+}
+
+/**
+ * Send images on a deflect::Stream with several frames in flight.
+ *
+ * The images are segmented and JPEG-compressed in parallel by the stream,
+ * while the application already renders the next frames. The compression
+ * quality adapts to the depth of the send queue: it is lowered when the queue
+ * is full, i.e. when compression or network cannot keep up, and raised again
+ * while the queue is short.
+ *
+ * Compression can be disabled for streams to the local host, for which
+ * sending raw pixels is faster than compressing them.
+ *
+ * Images are always sent whole. Deflect's server only forwards the latest
+ * complete frame of a stream to the walls, so a frame made of the changed
+ * segments only would lose the changes of the older frames that it replaces.
+ */
+class StreamSender
+{
+public:
+    /**
+     * Create a sender for a stream.
+     * @param stream the stream to send the images to.
+     * @param maxFramesInFlight the maximum number of frames in the send queue.
+     * @param compress JPEG-compress the images, otherwise they are sent raw.
+     */
+    StreamSender(deflect::Stream& stream, size_t maxFramesInFlight = 3,
+                 bool compress = true);
+
+    /** Wait for the frames in flight. */
+    ~StreamSender();
+
+    /**
+     * Send an image as the next frame of the stream.
+     *
+     * Blocks only if the send queue is full.
+     * @param image the image (ARGB32 or RGB32, RGBA8888 if not compressed) to
+     *        send, which is kept as long as it is in the send queue.
+     * @return false if sending a frame failed.
+     */
+    bool send(QImage image);
+
+    /**
+     * Wait until all the frames in flight are sent.
+     * @return false if sending a frame failed.
+     */
+    bool finish();
+
+    /** @return the current JPEG quality. */
+    int getQuality() const;
+
+    /** @return the number of frames in the send queue. */
+    size_t getQueueDepth() const;
+
+private:
+    struct PendingFrame
+    {
+        QImage image;
+        std::future<bool> sent;
+    };
+
+    deflect::Stream& _stream;
+    const size_t _maxFramesInFlight;
+    const bool _compress;
+    std::deque<PendingFrame> _pendingFrames;
+    int _quality;
+    bool _success = true;
+
+    void _popSentFrames();
+    void _waitForOldestFrame();
+    void _adaptQuality();
+};
+
+#endif
@@ -52,16 +52,46 @@ using namespace zeroeq::http;
 #endif
 
 #include <QKeyEvent>
+#include <QPainter>
 #include <QWebElement>
 #include <QWebFrame>
 #include <QWebHistory>
 #include <QWebView>
 
+#include <cstring>
+
 #define WEBPAGE_MIN_WIDTH 640
 #define WEBPAGE_MIN_HEIGHT 512
 
 #define WEBPAGE_DEFAULT_ZOOM 2.0
 
+namespace
+{
+// Shortest interval between two frames, i.e. the maximum frame rate
+const int minFrameIntervalMs = 30;
+// Interval between two full renderings of the page when it looks idle
+const int fullCheckIntervalMs = 1000;
+// Duration of full frame rate polling after an unreported change
+const int pollingDurationMs = 3000;
+// Size of the blocks compared to detect unreported changes
+const int compareBlockSize = 64;
+
+bool _isSameBlock(const QImage& a, const QImage& b, const QRect& block)
+{
+    const auto bytes = size_t(block.width()) * sizeof(QRgb);
+    const auto offset = size_t(block.x()) * sizeof(QRgb);
+    for (int y = block.top(); y <= block.bottom(); ++y)
+    {
+        if (std::memcmp(a.constScanLine(y) + offset,
+                        b.constScanLine(y) + offset, bytes) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
 WebkitPixelStreamer::WebkitPixelStreamer(const QSize& webpageSize,
                                          const QString& url)
     : PixelStreamer()
@@ -100,8 +130,14 @@ WebkitPixelStreamer::WebkitPixelStreamer(const QSize& webpageSize,
 
     setUrl(url);
 
+    connect(_webView.page(), &QWebPage::repaintRequested,
+            [this](const QRect& rect) { _markDirty(rect); });
+    connect(_webView.page(), &QWebPage::scrollRequested,
+            [this](int, int, const QRect& rect) { _markDirty(rect); });
+
     connect(&_timer, SIGNAL(timeout()), this, SLOT(_update()));
-    _timer.start(30);
+    _timer.setSingleShot(true);
+    _timer.start(minFrameIntervalMs);
 }
 
 WebkitPixelStreamer::~WebkitPixelStreamer()
@@ -294,18 +330,99 @@ void WebkitPixelStreamer::_update()
 {
     QMutexLocker locker(&_mutex);
 
-    QWebPage* page = _webView.page();
-    if (!page->viewportSize().isEmpty())
+    const QSize viewportSize = _webView.page()->viewportSize();
+    if (viewportSize.isEmpty())
     {
-        if (_image.size() != page->viewportSize())
-            _image = QImage(page->viewportSize(), QImage::Format_ARGB32);
+        _timer.start(fullCheckIntervalMs);
+        return;
+    }
 
-        QPainter painter(&_image);
-        page->mainFrame()->render(&painter);
-        painter.end();
+    if (_image.size() != viewportSize)
+    {
+        _image = QImage(viewportSize, QImage::Format_ARGB32);
+        _image.fill(Qt::transparent);
+        _dirtyRegion = QRect(QPoint(), viewportSize);
+    }
+    // Damage reported while rendering is kept for the next update
+    const auto dirtyRegion = _dirtyRegion & QRect(QPoint(), viewportSize);
+    _dirtyRegion = QRegion();
 
-        emit imageUpdated(_image);
+    QRegion updatedRegion;
+    if (_isPolling() || !_lastFullCheck.isValid() ||
+        _lastFullCheck.elapsed() > fullCheckIntervalMs)
+    {
+        updatedRegion = _renderAndCompare(dirtyRegion) + dirtyRegion;
     }
+    else if (!dirtyRegion.isEmpty())
+    {
+        _render(_image, dirtyRegion);
+        updatedRegion = dirtyRegion;
+    }
+
+    if (!updatedRegion.isEmpty())
+        emit imageUpdated(_image, updatedRegion);
+
+    // Wake up at full frame rate as long as the page changes, a damage
+    // notification also wakes up an idle streamer (see _markDirty).
+    const bool idle =
+        updatedRegion.isEmpty() && _dirtyRegion.isEmpty() && !_isPolling();
+    _timer.start(idle ? fullCheckIntervalMs : minFrameIntervalMs);
+}
+
+void WebkitPixelStreamer::_markDirty(const QRect& rect)
+{
+    // Called from the main thread like _update(), no locking needed. Some of
+    // these notifications are emitted synchronously while handling events,
+    // which already holds the (non-recursive) mutex.
+    _dirtyRegion += rect;
+    if (_timer.remainingTime() > minFrameIntervalMs)
+        _timer.start(minFrameIntervalMs);
+}
+
+bool WebkitPixelStreamer::_isPolling() const
+{
+    return _lastUnreportedChange.isValid() &&
+           _lastUnreportedChange.elapsed() < pollingDurationMs;
+}
+
+void WebkitPixelStreamer::_render(QImage& image, const QRegion& region)
+{
+    QPainter painter(&image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const auto& rect : region.rects())
+        painter.fillRect(rect, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    _webView.page()->mainFrame()->render(&painter, region);
+}
+
+QRegion WebkitPixelStreamer::_renderAndCompare(const QRegion& dirtyRegion)
+{
+    _lastFullCheck.start();
+
+    if (_fullRender.size() != _image.size())
+        _fullRender = QImage(_image.size(), QImage::Format_ARGB32);
+    _render(_fullRender, QRect(QPoint(), _fullRender.size()));
+
+    QRegion changedRegion;
+    const QRect imageRect(QPoint(), _image.size());
+    for (int y = 0; y < _image.height(); y += compareBlockSize)
+    {
+        for (int x = 0; x < _image.width(); x += compareBlockSize)
+        {
+            const auto block = QRect(x, y, compareBlockSize, compareBlockSize)
+                                   .intersected(imageRect);
+            if (!_isSameBlock(_image, _fullRender, block))
+                changedRegion += block;
+        }
+    }
+
+    if (!changedRegion.subtracted(dirtyRegion).isEmpty())
+        _lastUnreportedChange.start();
+
+    if (!changedRegion.isEmpty())
+        std::swap(_image, _fullRender);
+
+    return changedRegion;
 }
 
 QWebHitTestResult WebkitPixelStreamer::performHitTest(
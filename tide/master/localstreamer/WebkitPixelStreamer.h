@@ -43,8 +43,10 @@
 #include "PixelStreamer.h" // base class
 #include "config.h"
 
+#include <QElapsedTimer>
 #include <QImage>
 #include <QMutex>
+#include <QRegion>
 #include <QString>
 #include <QTimer>
 #include <QWebView>
@@ -61,6 +63,12 @@ class QWebElement;
 
 /**
  * Stream webpages with user interaction support.
+ *
+ * Only the areas of the page reported as damaged by WebKit are rendered, and
+ * no image is emitted as long as the page does not change. The page is also
+ * fully rendered once in a while to detect changes which are not reported
+ * (e.g. composited layers or WebGL canvases), in which case it is polled
+ * at full frame rate for some time.
  */
 class WebkitPixelStreamer : public PixelStreamer
 {
@@ -110,6 +118,10 @@ private:
     QTimer _timer;
     QMutex _mutex;
     QImage _image;
+    QImage _fullRender;
+    QRegion _dirtyRegion;
+    QElapsedTimer _lastFullCheck;
+    QElapsedTimer _lastUnreportedChange;
 
     bool _interactionModeActive = 0;
     unsigned int _initialWidth = 0;
@@ -128,6 +140,11 @@ private:
     bool isWebGLElement(const QWebElement& element) const;
     void setSize(const QSize& webpageSize);
     void recomputeZoomFactor();
+
+    void _markDirty(const QRect& rect);
+    bool _isPolling() const;
+    void _render(QImage& image, const QRegion& region);
+    QRegion _renderAndCompare(const QRegion& dirtyRegion);
 };
 
 #endif
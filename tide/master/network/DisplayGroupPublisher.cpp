@@ -0,0 +1,88 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "DisplayGroupPublisher.h"
+
+DisplayGroupPublisher::DisplayGroupPublisher(const uint maxRate)
+    : _interval(maxRate > 0 ? 1000 / maxRate : 0)
+{
+    _timer.setSingleShot(true);
+    connect(&_timer, &QTimer::timeout, this, &DisplayGroupPublisher::flush);
+}
+
+size_t DisplayGroupPublisher::getSentCount() const
+{
+    return _sentCount;
+}
+
+size_t DisplayGroupPublisher::getSuppressedCount() const
+{
+    return _updateCount - _sentCount;
+}
+
+void DisplayGroupPublisher::update(DisplayGroupPtr displayGroup)
+{
+    ++_updateCount;
+    _pending = displayGroup;
+
+    if (_timer.isActive())
+        return;
+
+    const auto elapsed = _lastPublication.isValid()
+                             ? _lastPublication.elapsed()
+                             : qint64(_interval);
+    if (elapsed >= _interval)
+        flush();
+    else
+        _timer.start(_interval - elapsed);
+}
+
+void DisplayGroupPublisher::flush()
+{
+    _timer.stop();
+    if (!_pending)
+        return;
+
+    DisplayGroupPtr displayGroup;
+    displayGroup.swap(_pending);
+    ++_sentCount;
+    _lastPublication.start();
+    emit publish(displayGroup);
+}
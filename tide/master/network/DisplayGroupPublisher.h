@@ -0,0 +1,101 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef DISPLAYGROUPPUBLISHER_H
+#define DISPLAYGROUPPUBLISHER_H
+
+#include "types.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+/**
+ * Coalesce the modifications of the DisplayGroup before publishing it.
+ *
+ * Interactions such as pinching or dragging a window modify the DisplayGroup
+ * hundreds of times per second, while the wall processes only render the
+ * latest state at each frame. The first modification after an idle period is
+ * published immediately; the following ones are merged and published at most
+ * once per period, always including the latest state.
+ */
+class DisplayGroupPublisher : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(DisplayGroupPublisher)
+
+public:
+    /**
+     * Create a publisher.
+     * @param maxRate the maximum number of publications per second, or 0 to
+     *        publish every modification.
+     */
+    explicit DisplayGroupPublisher(uint maxRate);
+
+    /** @return the number of times the DisplayGroup was published. */
+    size_t getSentCount() const;
+
+    /** @return the number of modifications merged into another publication. */
+    size_t getSuppressedCount() const;
+
+public slots:
+    /**
+     * Notify that the DisplayGroup was modified.
+     * @param displayGroup the modified DisplayGroup, published now or later.
+     */
+    void update(DisplayGroupPtr displayGroup);
+
+    /** Publish the pending modification now, if any. */
+    void flush();
+
+signals:
+    /** Emitted at most maxRate times per second with the latest state. */
+    void publish(DisplayGroupPtr displayGroup);
+
+private:
+    const int _interval; // ms
+    QTimer _timer;
+    QElapsedTimer _lastPublication;
+    DisplayGroupPtr _pending;
+    size_t _updateCount = 0;
+    size_t _sentCount = 0;
+};
+
+#endif
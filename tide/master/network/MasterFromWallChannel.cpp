@@ -88,6 +88,14 @@ void MasterFromWallChannel::processMessages()
         case MPIMessageType::PIXELSTREAM_CLOSE:
             emit pixelStreamClose(serialization::get<QString>(_buffer));
             break;
+        case MPIMessageType::REQUEST_DISPLAYGROUP:
+            emit receivedDisplayGroupRequest();
+            break;
+        case MPIMessageType::TRACE_STATISTICS:
+            emit receivedTraceStatistics(
+                serialization::get<FrameTraceStatistics>(_buffer),
+                QString("wall%1").arg(result.src));
+            break;
         case MPIMessageType::QUIT:
             _processMessages = false;
             break;
@@ -41,6 +41,7 @@
 #ifndef MASTERFROMWALLCHANNEL_H
 #define MASTERFROMWALLCHANNEL_H
 
+#include "FrameTracer.h"
 #include "network/MPIHeader.h"
 #include "network/ReceiveBuffer.h"
 #include "types.h"
@@ -86,6 +87,19 @@ signals:
      */
     void pixelStreamClose(QString uri);
 
+    /**
+     * Emitted when a wall process needs the complete DisplayGroup, e.g.
+     * because it missed an update.
+     */
+    void receivedDisplayGroupRequest();
+
+    /**
+     * Emitted when a wall process sent the statistics of its frame tracer.
+     * @param statistics The latencies accumulated since the process started
+     * @param node The name of the wall process, e.g. "wall1"
+     */
+    void receivedTraceStatistics(FrameTraceStatistics statistics, QString node);
+
 private:
     MPIChannelPtr _mpiChannel;
     ReceiveBuffer _buffer;
@@ -39,9 +39,11 @@
 
 #include "MasterToWallChannel.h"
 
+#include "FrameTracer.h"
 #include "InactivityTimer.h"
 #include "ScreenLock.h"
 #include "network/MPIChannel.h"
+#include "network/frameCodec.h"
 #include "scene/ContentWindow.h"
 #include "scene/DisplayGroup.h"
 #include "scene/Markers.h"
@@ -50,15 +52,22 @@
 
 #include <deflect/Frame.h>
 
-MasterToWallChannel::MasterToWallChannel(MPIChannelPtr mpiChannel)
-    : _mpiChannel(mpiChannel)
+namespace
+{
+size_t _getImageDataSize(const deflect::Frame& frame)
 {
+    size_t size = 0;
+    for (const auto& segment : frame.segments)
+        size += segment.imageData.size();
+    return size;
+}
 }
 
-template <typename T>
-void MasterToWallChannel::broadcast(const T& object, const MPIMessageType type)
+MasterToWallChannel::MasterToWallChannel(MPIChannelPtr mpiChannel,
+                                         const Configuration& config)
+    : _mpiChannel(mpiChannel)
+    , _router(config)
 {
-    _mpiChannel->broadcast(type, serialization::toBinary(object));
 }
 
 template <typename T>
@@ -74,7 +83,22 @@ void MasterToWallChannel::broadcastAsync(const T& object,
 
 void MasterToWallChannel::sendAsync(DisplayGroupPtr displayGroup)
 {
-    broadcastAsync(displayGroup, MPIMessageType::DISPLAYGROUP);
+    _router.updateGeometry(*displayGroup);
+    _sendDisplayGroupAsync(*displayGroup, _displayGroupSequence == 0);
+}
+
+void MasterToWallChannel::sendSnapshotAsync(DisplayGroupPtr displayGroup)
+{
+    _router.updateGeometry(*displayGroup);
+    _sendDisplayGroupAsync(*displayGroup, true);
+}
+
+void MasterToWallChannel::_sendDisplayGroupAsync(const DisplayGroup& group,
+                                                 const bool snapshot)
+{
+    const DisplayGroupPatch patch{group, ++_displayGroupSequence,
+                                  _sentWindowVersions, snapshot};
+    broadcastAsync(patch, MPIMessageType::DISPLAYGROUP);
 }
 
 void MasterToWallChannel::sendAsync(OptionsPtr options)
@@ -100,12 +124,34 @@ void MasterToWallChannel::sendAsync(MarkersPtr markers)
 void MasterToWallChannel::send(deflect::FramePtr frame)
 {
     assert(!frame->segments.empty() && "received an empty frame");
-#if BOOST_VERSION >= 106000
-    broadcast(frame, MPIMessageType::PIXELSTREAM);
-#else
-    // WAR missing support for std::shared_ptr
-    broadcast(*frame, MPIMessageType::PIXELSTREAM);
-#endif
+
+    auto& tracer = FrameTracer::instance();
+    tracer.endAsync(TraceStage::streamReceive, uintptr_t(frame.get()));
+    const FrameTracer::Scope trace(TraceStage::mpiSend, tracer);
+
+    const auto wallProcessCount = size_t(_mpiChannel->getSize() - 1);
+    const auto frameSize = _getImageDataSize(*frame);
+
+    const auto frames = _router.split(*frame);
+    if (frames.size() != wallProcessCount)
+    {
+        _mpiChannel->broadcast(MPIMessageType::PIXELSTREAM,
+                               frameCodec::encode(*frame),
+                               frameCodec::getPayload(*frame));
+        emit pixelStreamSent(frameSize * wallProcessCount, 0);
+        return;
+    }
+
+    size_t bytesSent = 0;
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        const auto rank = int(i) + 1;
+        _mpiChannel->sendMessage(MPIMessageType::PIXELSTREAM_PARTIAL,
+                                 frameCodec::encode(*frames[i]),
+                                 frameCodec::getPayload(*frames[i]), rank);
+        bytesSent += _getImageDataSize(*frames[i]);
+    }
+    emit pixelStreamSent(bytesSent, frameSize * wallProcessCount - bytesSent);
 }
 
 void MasterToWallChannel::sendRequestScreenshot()
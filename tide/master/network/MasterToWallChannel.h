@@ -40,7 +40,9 @@
 #ifndef MASTERTOWALLCHANNEL_H
 #define MASTERTOWALLCHANNEL_H
 
+#include "PixelStreamRouter.h"
 #include "network/MPIHeader.h"
+#include "scene/DisplayGroupPatch.h"
 #include "types.h"
 
 #include <QObject>
@@ -61,6 +63,13 @@
  * The given object is serialized synchronously (in the calling thread), then
  * the serialized data is sent asynchronously in the MasterToWallChannel's
  * thread.
+ *
+ * The DisplayGroup is sent as a sequence of DisplayGroupPatch which only carry
+ * the windows that changed since the previous one. The first patch, and any
+ * patch sent with sendSnapshotAsync(), contains all the windows.
+ *
+ * Pixel stream frames are sent point-to-point to each wall process with only
+ * the segments that it can see, unless the stream covers most of the wall.
  */
 class MasterToWallChannel : public QObject
 {
@@ -68,16 +77,30 @@ class MasterToWallChannel : public QObject
     Q_DISABLE_COPY(MasterToWallChannel)
 
 public:
-    /** Constructor */
-    MasterToWallChannel(MPIChannelPtr mpiChannel);
+    /**
+     * Constructor
+     * @param mpiChannel The MPI channel to the wall processes
+     * @param config The configuration, for routing pixel streams
+     */
+    MasterToWallChannel(MPIChannelPtr mpiChannel, const Configuration& config);
 
 public slots:
     /**
      * Send the given DisplayGroup to the wall processes.
+     *
+     * Also updates the geometry used for routing pixel stream frames.
      * @param displayGroup The DisplayGroup to send
      */
     void sendAsync(DisplayGroupPtr displayGroup);
 
+    /**
+     * Send the complete DisplayGroup to the wall processes.
+     *
+     * Used to resynchronize the walls, for instance when they missed a patch.
+     * @param displayGroup The DisplayGroup to send
+     */
+    void sendSnapshotAsync(DisplayGroupPtr displayGroup);
+
     /**
      * Send the given Options to the wall processes.
      * @param options The options to send
@@ -118,14 +141,26 @@ public slots:
      */
     void sendQuit();
 
+signals:
+    /**
+     * Emitted after sending a pixel stream frame.
+     * @param bytesSent The image data sent to all the processes
+     * @param bytesSaved The image data saved compared to a broadcast
+     */
+    void pixelStreamSent(quint64 bytesSent, quint64 bytesSaved);
+
 private:
     MPIChannelPtr _mpiChannel;
+    PixelStreamRouter _router;
+
+    DisplayGroupPatch::WindowVersions _sentWindowVersions;
+    uint64_t _displayGroupSequence = 0;
 
-    template <typename T>
-    void broadcast(const T& object, const MPIMessageType type);
     template <typename T>
     void broadcastAsync(const T& object, const MPIMessageType type);
 
+    void _sendDisplayGroupAsync(const DisplayGroup& group, bool snapshot);
+
 private slots:
     void _broadcast(MPIMessageType type, std::string data);
 };
@@ -0,0 +1,230 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "PixelStreamRouter.h"
+
+#include "Configuration.h"
+#include "ZoomHelper.h"
+#include "scene/ContentWindow.h"
+#include "scene/DisplayGroup.h"
+#include "scene/PixelStreamContent.h"
+
+#include <deflect/Frame.h>
+
+#include <cmath>
+
+namespace
+{
+bool _isStream(const Content& content)
+{
+    return content.getType() == CONTENT_TYPE_PIXEL_STREAM ||
+           content.getType() == CONTENT_TYPE_WEBBROWSER;
+}
+
+QRectF _toRect(const deflect::SegmentParameters& params)
+{
+    return QRectF(params.x, params.y, params.width, params.height);
+}
+
+QRectF _alignToTiles(const QRectF& area)
+{
+    if (area.isEmpty())
+        return area;
+
+    // The wall processes need all the segments overlapping a tile to assemble
+    const qreal tileSize = PixelStreamContent::getAssembledTileSize();
+    const auto left = std::floor(area.left() / tileSize) * tileSize;
+    const auto top = std::floor(area.top() / tileSize) * tileSize;
+    const auto right = std::ceil(area.right() / tileSize) * tileSize;
+    const auto bottom = std::ceil(area.bottom() / tileSize) * tileSize;
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+QRectF _toFrameArea(const QRectF& windowArea, const QRectF& contentRect,
+                    const QSize& frameSize)
+{
+    // Same transform as ZoomHelper::toTilesArea() on the wall processes
+    const auto area =
+        windowArea.translated(-contentRect.x(), -contentRect.y());
+    const auto xScale = frameSize.width() / contentRect.width();
+    const auto yScale = frameSize.height() / contentRect.height();
+    return QRectF(area.x() * xScale, area.y() * yScale, area.width() * xScale,
+                  area.height() * yScale);
+}
+}
+
+PixelStreamRouter::PixelStreamRouter(const Configuration& config)
+    : _wallArea(config.getTotalWidth() * config.getTotalHeight())
+{
+    for (int i = 1; i <= config.getWallProcessCount(); ++i)
+        _processScreens.push_back(config.getWallProcessScreens(i));
+}
+
+void PixelStreamRouter::updateGeometry(const DisplayGroup& group)
+{
+    std::map<QString, StreamWindows> windows;
+    for (const auto& window : group.getContentWindows())
+    {
+        const auto& content = *window->getContent();
+        if (!_isStream(content))
+            continue;
+
+        // Hidden windows are registered without geometry, so that their
+        // frames are not sent to any process.
+        auto& streamWindows = windows[content.getURI()];
+        if (!window->isHidden())
+            streamWindows.push_back({window->getDisplayCoordinates(),
+                                     ZoomHelper{*window}.getContentRect()});
+    }
+
+    const QMutexLocker lock(&_mutex);
+
+    // Forget the streams which are no longer in the group
+    auto it = _previousWindows.begin();
+    while (it != _previousWindows.end())
+    {
+        if (windows.count(it->first))
+            ++it;
+        else
+            it = _previousWindows.erase(it);
+    }
+
+    // Keep the last geometry of the windows which changed for the next frame
+    for (const auto& stream : windows)
+    {
+        auto current = _currentWindows.find(stream.first);
+        if (current == _currentWindows.end())
+            continue;
+        if (current->second != stream.second)
+            _previousWindows[stream.first] = std::move(current->second);
+    }
+    _currentWindows = std::move(windows);
+}
+
+void PixelStreamRouter::setBroadcastThreshold(const double threshold)
+{
+    const QMutexLocker lock(&_mutex);
+    _broadcastThreshold = threshold;
+}
+
+std::vector<deflect::FramePtr> PixelStreamRouter::split(
+    const deflect::Frame& frame)
+{
+    if (_processScreens.empty())
+        return {};
+
+    StreamWindows windows;
+    {
+        const QMutexLocker lock(&_mutex);
+        const auto it = _currentWindows.find(frame.uri);
+        const auto previous = _previousWindows.find(frame.uri);
+        if (previous != _previousWindows.end())
+        {
+            windows = std::move(previous->second);
+            _previousWindows.erase(previous);
+        }
+        if (it == _currentWindows.end() || _coversMostOfTheWall(it->second))
+            return {};
+        windows.insert(windows.end(), it->second.begin(), it->second.end());
+    }
+
+    const auto areas = _getVisibleAreas(windows, frame.computeDimensions());
+
+    std::vector<deflect::FramePtr> frames;
+    frames.reserve(areas.size());
+    for (const auto& area : areas)
+    {
+        auto processFrame = std::make_shared<deflect::Frame>();
+        processFrame->uri = frame.uri;
+        processFrame->segments.reserve(frame.segments.size());
+        for (const auto& segment : frame.segments)
+        {
+            processFrame->segments.push_back(segment);
+            if (!area.intersects(_toRect(segment.parameters)))
+                processFrame->segments.back().imageData = QByteArray();
+        }
+        frames.push_back(processFrame);
+    }
+    return frames;
+}
+
+bool PixelStreamRouter::_coversMostOfTheWall(
+    const StreamWindows& windows) const
+{
+    if (_wallArea <= 0.0)
+        return true;
+
+    qreal coveredArea = 0.0;
+    for (const auto& window : windows)
+        coveredArea += window.coordinates.width() * window.coordinates.height();
+
+    return coveredArea / _wallArea >= _broadcastThreshold;
+}
+
+std::vector<QRectF> PixelStreamRouter::_getVisibleAreas(
+    const StreamWindows& windows, const QSize& frameSize) const
+{
+    std::vector<QRectF> areas(_processScreens.size());
+    if (frameSize.isEmpty())
+        return areas;
+
+    for (size_t i = 0; i < _processScreens.size(); ++i)
+    {
+        QRectF area;
+        for (const auto& window : windows)
+        {
+            if (window.contentRect.isEmpty())
+                continue;
+
+            for (const auto& screen : _processScreens[i])
+            {
+                const auto visible = window.coordinates.intersected(screen);
+                if (visible.isEmpty())
+                    continue;
+
+                const auto windowArea = visible.translated(
+                    -window.coordinates.x(), -window.coordinates.y());
+                area |= _toFrameArea(windowArea, window.contentRect, frameSize);
+            }
+        }
+        areas[i] = _alignToTiles(area);
+    }
+    return areas;
+}
@@ -0,0 +1,123 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef PIXELSTREAMROUTER_H
+#define PIXELSTREAMROUTER_H
+
+#include "types.h"
+
+#include <QMutex>
+#include <QRectF>
+
+#include <map>
+
+/**
+ * Route pixel stream frames to the wall processes that display them.
+ *
+ * The router keeps a copy of the geometry of the windows showing each stream
+ * and splits incoming frames into one frame per wall process. The frame of a
+ * process keeps the parameters of all the segments, so that it can still
+ * compute the full frame layout, but only the image data of the segments that
+ * are visible on its screens.
+ *
+ * The previous geometry of the windows of a stream is also taken into account
+ * for its next frame, so that wall processes still rendering a previous
+ * DisplayGroup receive all the segments that they need.
+ *
+ * The methods of this class are thread-safe.
+ */
+class PixelStreamRouter
+{
+public:
+    /**
+     * Create a router for the wall processes defined in the configuration.
+     * @param config the configuration, for the screens of each process.
+     */
+    explicit PixelStreamRouter(const Configuration& config);
+
+    /**
+     * Update the geometry of the pixel stream windows.
+     * @param group the current display group.
+     */
+    void updateGeometry(const DisplayGroup& group);
+
+    /**
+     * Set the fraction of the wall above which frames are broadcast.
+     * @param threshold wall coverage in the range [0;1], defaults to 0.5.
+     */
+    void setBroadcastThreshold(double threshold);
+
+    /**
+     * Split a frame into one frame per wall process.
+     * @param frame the frame to split.
+     * @return the frames indexed from 0 for the wall process of rank 1, or an
+     *         empty list if the frame should be broadcast to all processes
+     *         (unknown stream or windows covering most of the wall).
+     */
+    std::vector<deflect::FramePtr> split(const deflect::Frame& frame);
+
+private:
+    struct StreamWindow
+    {
+        QRectF coordinates;
+        QRectF contentRect;
+
+        bool operator==(const StreamWindow& other) const
+        {
+            return coordinates == other.coordinates &&
+                   contentRect == other.contentRect;
+        }
+    };
+    using StreamWindows = std::vector<StreamWindow>;
+
+    std::vector<std::vector<QRect>> _processScreens;
+    double _wallArea = 0.0;
+    double _broadcastThreshold = 0.5;
+
+    QMutex _mutex;
+    std::map<QString, StreamWindows> _currentWindows;
+    std::map<QString, StreamWindows> _previousWindows;
+
+    bool _coversMostOfTheWall(const StreamWindows& windows) const;
+    std::vector<QRectF> _getVisibleAreas(const StreamWindows& windows,
+                                         const QSize& frameSize) const;
+};
+
+#endif
@@ -13,6 +13,9 @@ var timer;
 var wallWidth;
 var wallHeight;
 var windowList = [];
+var windowsByUuid = {};
+var windowsVersion = 0;
+var windowsRequest;
 var zoomScale;
 var output = [];
 var filters = [];
@@ -37,10 +40,15 @@ function autoRefresh() {
   if (timer > 0) {
     clearInterval(timer);
     timer = 0;
+    if (windowsRequest) {
+      windowsRequest.abort();
+      windowsRequest = null;
+    }
     $("#autoRefreshButton").removeClass("buttonPressed");
   }
   else {
-    timer = setInterval(updateWall, refreshInterval);
+    timer = setInterval(updateStatus, refreshInterval);
+    watchWindows();
     $("#autoRefreshButton").addClass("buttonPressed");
   }
 }
@@ -1068,95 +1076,14 @@ function updateTile(tile) {
 }
 
 function updateWall() {
-  enableHandles();
-  fullscreen = false;
-  focus = false;
   var xhr = new XMLHttpRequest();
-  xhr.open("GET", restUrl + "windows", true);
+  xhr.open("GET", restUrl + "windows?version=" + windowsVersion, true);
   xhr.onload = function () {
+    // Status 304: the windows did not change since the last update
     if (xhr.status === 200) {
-      var jsonList = JSON.parse(xhr.responseText)["windows"];
-
-      // Check if a window has been removed on the wall
-      checkForRemoved();
-
-      var jsonUuidList = jsonList.map(function (element) {
-        return element.uuid;
-      });
-      var windowUuidList = windowList.map(function (element) {
-        return element.uuid;
-      });
-
-      // Loop through data from rest api to add new windows and modify exisiting if different
-      for (var i = 0; i < jsonUuidList.length; i++) {
-        if (jsonList[i].mode == modeFocus)
-          focus = true;
-        if (jsonList[i].mode == modeFullscreen)
-          fullscreen = true;
-
-        //Window missing. Create it.
-        if (windowUuidList.indexOf(jsonUuidList[i]) === -1)
-          createWindow(jsonList[i]);
-
-        else {
-          var tile = windowList[windowUuidList.indexOf(jsonUuidList[i])];
-          //If window has been updated, modify its properties
-          if (!checkIfEqual(jsonList[i], tile)) {
-
-            copy(jsonList[i], tile);
-            updateTile(tile);
-
-            if (tile.mode === modeFocus)
-              disableHandles();
-            if (tile.mode === modeFullscreen)
-              disableHandlesForFullscreen(tile);
-
-            if (tile.selected)
-              markAsSelected(tile);
-            else
-              markAsUnselected(tile);
-
-            if (tile.focus)
-              markAsFocused(tile);
-
-            if (tile.fullscreen)
-              markAsFullscreen(tile);
-            else
-              enableControls(tile);
-          }
-        }
-      }
-    }
-
-    function checkForRemoved() {
-      var json = jsonList.map(function (element) {
-        return element.uuid;
-      });
-      var list = windowList.map(function (element) {
-        return element.uuid;
-      });
-      for (var i = 0; i < list.length; i++) {
-        if (json.indexOf(list[i]) === -1) {
-          windowList.splice(windowList.findIndex(function (element) {
-            return element.uuid === list[i];
-          }), 1);
-          $('#' + list[i]).remove();
-        }
-      }
-    }
-
-    if (fullscreen)
-      setCurtain(fullscreenCurtain);
-    else
-      removeCurtain(fullscreenCurtain);
-
-    if (focus)
-      setCurtain(focusCurtain);
-    else
-      removeCurtain(focusCurtain);
-
-    if (locked) {
-      disableHandles();
+      var changes = JSON.parse(xhr.responseText);
+      changes["full"] = true;
+      updateWindows(changes);
     }
   };
   xhr.send(null);
@@ -1164,6 +1091,10 @@ function updateWall() {
     alertPopup("Something went wrong.", "Tide REST interface not accessible at: " + restUrl);
   };
 
+  updateStatus();
+}
+
+function updateStatus() {
   var lockCheck = new XMLHttpRequest();
   lockCheck.open("GET", restUrl + "lock", true);
   lockCheck.onload = function () {
@@ -1208,6 +1139,134 @@ function updateWall() {
   screenCheck.send(null);
 }
 
+function updateWindows(changes) {
+  if (changes["full"])
+    windowsByUuid = {};
+  changes["windows"].forEach(function (element) {
+    windowsByUuid[element.uuid] = element;
+  });
+  (changes["removed"] || []).forEach(function (uuid) {
+    delete windowsByUuid[uuid];
+  });
+  windowsVersion = changes["version"];
+
+  var jsonList = Object.keys(windowsByUuid).map(function (uuid) {
+    return windowsByUuid[uuid];
+  });
+  jsonList.sort(function (a, b) {
+    return a.z - b.z;
+  });
+  showWindows(jsonList);
+}
+
+function showWindows(jsonList) {
+  enableHandles();
+  fullscreen = false;
+  focus = false;
+
+  // Check if a window has been removed on the wall
+  checkForRemoved();
+
+  var jsonUuidList = jsonList.map(function (element) {
+    return element.uuid;
+  });
+  var windowUuidList = windowList.map(function (element) {
+    return element.uuid;
+  });
+
+  // Loop through data from rest api to add new windows and modify exisiting if different
+  for (var i = 0; i < jsonUuidList.length; i++) {
+    if (jsonList[i].mode == modeFocus)
+      focus = true;
+    if (jsonList[i].mode == modeFullscreen)
+      fullscreen = true;
+
+    //Window missing. Create it.
+    if (windowUuidList.indexOf(jsonUuidList[i]) === -1)
+      createWindow(jsonList[i]);
+
+    else {
+      var tile = windowList[windowUuidList.indexOf(jsonUuidList[i])];
+      //If window has been updated, modify its properties
+      if (!checkIfEqual(jsonList[i], tile)) {
+
+        copy(jsonList[i], tile);
+        updateTile(tile);
+
+        if (tile.mode === modeFocus)
+          disableHandles();
+        if (tile.mode === modeFullscreen)
+          disableHandlesForFullscreen(tile);
+
+        if (tile.selected)
+          markAsSelected(tile);
+        else
+          markAsUnselected(tile);
+
+        if (tile.focus)
+          markAsFocused(tile);
+
+        if (tile.fullscreen)
+          markAsFullscreen(tile);
+        else
+          enableControls(tile);
+      }
+    }
+  }
+
+  function checkForRemoved() {
+    var json = jsonList.map(function (element) {
+      return element.uuid;
+    });
+    var list = windowList.map(function (element) {
+      return element.uuid;
+    });
+    for (var i = 0; i < list.length; i++) {
+      if (json.indexOf(list[i]) === -1) {
+        windowList.splice(windowList.findIndex(function (element) {
+          return element.uuid === list[i];
+        }), 1);
+        $('#' + list[i]).remove();
+      }
+    }
+  }
+
+  if (fullscreen)
+    setCurtain(fullscreenCurtain);
+  else
+    removeCurtain(fullscreenCurtain);
+
+  if (focus)
+    setCurtain(focusCurtain);
+  else
+    removeCurtain(focusCurtain);
+
+  if (locked) {
+    disableHandles();
+  }
+}
+
+function watchWindows() {
+  // Only one request at a time, even if auto-refresh was toggled meanwhile
+  if (!timer || windowsRequest)
+    return;
+  var xhr = new XMLHttpRequest();
+  windowsRequest = xhr;
+  xhr.open("GET", restUrl + "windows/changes?since=" + windowsVersion, true);
+  xhr.onload = function () {
+    windowsRequest = null;
+    // Status 304: nothing changed before the server timeout, ask again
+    if (xhr.status === 200)
+      updateWindows(JSON.parse(xhr.responseText));
+    watchWindows();
+  };
+  xhr.onerror = function () {
+    windowsRequest = null;
+    setTimeout(watchWindows, refreshInterval);
+  };
+  xhr.send(null);
+}
+
 function uploadFiles(files, coords) {
   var url = "upload";
   var requests = [];
@@ -48,6 +48,7 @@
 #include "SceneController.h"
 #include "ScreenLock.h"
 #include "ThumbnailCache.h"
+#include "WindowChangeFeed.h"
 #include "scene/ContentFactory.h"
 #include "serialization.h"
 
@@ -107,6 +108,7 @@ public:
         , options{options_}
         , size{config.getTotalSize()}
         , thumbnailCache{group}
+        , windowChangeFeed{group}
         , appController{config}
         , sceneController{group}
         , contentBrowser{config.getContentDir(),
@@ -117,10 +119,11 @@ public:
     {
     }
 
-    std::future<http::Response> getWindowInfo(
-        const http::Request& request) const
+    std::future<http::Response> getWindowInfo(const http::Request& request)
     {
         const auto path = QString::fromStdString(request.path);
+        if (path == "changes")
+            return windowChangeFeed.getChanges(request);
         if (path.endsWith("/thumbnail"))
         {
             const auto pathSplit = path.split("/");
@@ -134,6 +137,7 @@ public:
     OptionsPtr options;
     QSize size;
     ThumbnailCache thumbnailCache;
+    WindowChangeFeed windowChangeFeed;
     AppController appController;
     SceneController sceneController;
     FileBrowser contentBrowser;
@@ -164,7 +168,12 @@ RestInterface::RestInterface(const int port, OptionsPtr options,
     server.handleGET("tide/size", _impl->size);
     server.handleGET("tide/options", *_impl->options);
     server.handlePUT("tide/options", *_impl->options);
-    server.handleGET("tide/windows", group);
+    server.handle(http::Method::GET, "tide/windows",
+                  std::bind(&WindowChangeFeed::getWindows,
+                            &_impl->windowChangeFeed, _1));
+    QObject::connect(&_impl->windowChangeFeed,
+                     &WindowChangeFeed::responsesReady,
+                     [&server]() { server.processRequests(); });
 
     server.handle(http::Method::GET, "tide/windows/",
                   std::bind(&Impl::getWindowInfo, _impl.get(), _1));
@@ -80,13 +80,16 @@ void RestServer::unblock(const zeroeq::http::Method method)
     _blockedMethods.erase(method);
 }
 
+void RestServer::processRequests()
+{
+    while (receive(0 /* non-blocking receive*/))
+        ;
+}
+
 void RestServer::_init()
 {
     _socketNotifier.connect(&_socketNotifier, &QSocketNotifier::activated,
-                            [this]() {
-                                while (receive(0 /* non-blocking receive*/))
-                                    ;
-                            });
+                            [this]() { processRequests(); });
 }
 
 std::future<http::Response> RestServer::respondTo(
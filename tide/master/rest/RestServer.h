@@ -120,6 +120,14 @@ public:
      */
     void unblock(zeroeq::http::Method method);
 
+    /**
+     * Process the incoming requests and send the responses that are ready.
+     *
+     * Called automatically when data is received; call it after completing
+     * asynchronous responses to send them immediately.
+     */
+    void processRequests();
+
 protected:
     std::future<zeroeq::http::Response> respondTo(
         zeroeq::http::Request& request) const final;
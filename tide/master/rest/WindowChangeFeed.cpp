@@ -0,0 +1,265 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "WindowChangeFeed.h"
+
+#include "scene/DisplayGroup.h"
+#include "serialization.h"
+
+#include <QJsonArray>
+#include <QUrlQuery>
+
+using namespace zeroeq;
+
+namespace
+{
+// Maximum rate at which the long-poll clients are notified of changes
+const int PUBLISH_INTERVAL_MS = 100;
+// Below the usual 30s timeout of HTTP proxies
+const int LONG_POLL_TIMEOUT_MS = 25000;
+// Number of removed windows remembered to compute the changes
+const size_t MAX_REMOVED_WINDOWS = 256;
+
+bool _getQueryValue(const http::Request& request, const QString& key,
+                    uint64_t& value)
+{
+    const QUrlQuery query{QString::fromStdString(request.query)};
+    if (!query.hasQueryItem(key))
+        return false;
+    bool ok = false;
+    value = query.queryItemValue(key).toULongLong(&ok);
+    return ok;
+}
+
+bool _isLauncher(const ContentWindow& window)
+{
+    return window.getContent()->getURI() == "Launcher";
+}
+}
+
+WindowChangeFeed::WindowChangeFeed(const DisplayGroup& group)
+    : _group(group)
+{
+    _publishTimer.setSingleShot(true);
+    _publishTimer.setInterval(PUBLISH_INTERVAL_MS);
+    connect(&_publishTimer, &QTimer::timeout, this, &WindowChangeFeed::publish);
+
+    connect(&group, &DisplayGroup::modified, this, [this] {
+        _dirty = true;
+        if (!_pendingRequests.empty() && !_publishTimer.isActive())
+            _publishTimer.start();
+    });
+}
+
+std::future<http::Response> WindowChangeFeed::getWindows(
+    const http::Request& request)
+{
+    _update();
+
+    uint64_t version = 0;
+    if (_getQueryValue(request, "version", version) && version == _version)
+        return make_ready_response(http::Code::NOT_MODIFIED);
+
+    if (_windowsJson.empty())
+    {
+        QJsonArray windows;
+        for (const auto& id : _order)
+            windows.append(_windows.at(id).json);
+        _windowsJson = json::toString(
+            QJsonObject{{"version", double(_version)}, {"windows", windows}});
+    }
+    return make_ready_response(http::Code::OK, _windowsJson,
+                               "application/json");
+}
+
+std::future<http::Response> WindowChangeFeed::getChanges(
+    const http::Request& request)
+{
+    _update();
+
+    uint64_t since = 0;
+    if (!_getQueryValue(request, "since", since) || since != _version)
+        return make_ready_response(http::Code::OK, _getChanges(since),
+                                   "application/json");
+
+    const auto requestId = _nextRequestId++;
+    auto promise = std::make_shared<ResponsePromise>();
+    _pendingRequests[requestId] = PendingRequest{since, promise};
+
+    QTimer::singleShot(LONG_POLL_TIMEOUT_MS, this, [this, requestId] {
+        if (_respond(requestId, http::Response{http::Code::NOT_MODIFIED}))
+            emit responsesReady();
+    });
+    return promise->get_future();
+}
+
+uint64_t WindowChangeFeed::getVersion()
+{
+    _update();
+    return _version;
+}
+
+void WindowChangeFeed::publish()
+{
+    _update();
+
+    std::vector<uint64_t> outdated;
+    for (const auto& pending : _pendingRequests)
+    {
+        if (pending.second.since != _version)
+            outdated.push_back(pending.first);
+    }
+    if (outdated.empty())
+        return;
+
+    for (const auto requestId : outdated)
+    {
+        const auto since = _pendingRequests.at(requestId).since;
+        _respond(requestId, http::Response{http::Code::OK, _getChanges(since),
+                                           "application/json"});
+    }
+    emit responsesReady();
+}
+
+void WindowChangeFeed::_update()
+{
+    if (!_dirty)
+        return;
+    _dirty = false;
+
+    const auto version = _version + 1;
+    bool changed = false;
+
+    std::vector<QUuid> order;
+    std::map<QUuid, WindowState> windows;
+    int z = 0;
+    for (const auto& window : _group.getContentWindows())
+    {
+        const auto index = z++;
+        if (_isLauncher(*window))
+            continue;
+
+        const auto& id = window->getID();
+        order.push_back(id);
+
+        auto it = _windows.find(id);
+        if (it != _windows.end() &&
+            it->second.windowVersion == window->getVersion() &&
+            it->second.z == index)
+        {
+            windows[id] = std::move(it->second);
+            _windows.erase(it);
+            continue;
+        }
+        windows[id] = WindowState{window->getVersion(), index, version,
+                                  to_json_object(window, _group)};
+        _removed.erase(id); // the window was removed then added again
+        changed = true;
+    }
+
+    // The remaining windows have been removed
+    for (const auto& window : _windows)
+        _removed[window.first] = version;
+    changed = changed || !_windows.empty() || order != _order;
+
+    _order = std::move(order);
+    _windows = std::move(windows);
+
+    if (!changed)
+        return;
+
+    _version = version;
+    _windowsJson.clear();
+    _forgetRemovedWindows();
+}
+
+void WindowChangeFeed::_forgetRemovedWindows()
+{
+    while (_removed.size() > MAX_REMOVED_WINDOWS)
+    {
+        auto oldest = _removed.begin();
+        for (auto it = _removed.begin(); it != _removed.end(); ++it)
+        {
+            if (it->second < oldest->second)
+                oldest = it;
+        }
+        _horizon = std::max(_horizon, oldest->second);
+        _removed.erase(oldest);
+    }
+}
+
+std::string WindowChangeFeed::_getChanges(const uint64_t since) const
+{
+    const bool full = since < _horizon || since > _version;
+
+    QJsonArray windows;
+    for (const auto& id : _order)
+    {
+        const auto& window = _windows.at(id);
+        if (full || window.changed > since)
+            windows.append(window.json);
+    }
+
+    QJsonArray removed;
+    if (!full)
+    {
+        for (const auto& window : _removed)
+        {
+            if (window.second > since)
+                removed.append(url_encode(window.first));
+        }
+    }
+
+    return json::toString(QJsonObject{{"version", double(_version)},
+                                      {"full", full},
+                                      {"windows", windows},
+                                      {"removed", removed}});
+}
+
+bool WindowChangeFeed::_respond(const uint64_t requestId,
+                                http::Response response)
+{
+    const auto it = _pendingRequests.find(requestId);
+    if (it == _pendingRequests.end())
+        return false;
+    it->second.promise->set_value(std::move(response));
+    _pendingRequests.erase(it);
+    return true;
+}
@@ -0,0 +1,156 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef WINDOWCHANGEFEED_H
+#define WINDOWCHANGEFEED_H
+
+#include "types.h"
+
+#include <zeroeq/http/helpers.h>
+
+#include <QJsonObject>
+#include <QObject>
+#include <QTimer>
+#include <QUuid>
+
+#include <map>
+#include <memory>
+
+/**
+ * Versioned JSON view of the windows of a DisplayGroup for the REST interface.
+ *
+ * The JSON of each window is only regenerated when the window changes, and
+ * is shared by all the clients. Each change of the DisplayGroup increments
+ * the version number of the feed.
+ *
+ * Example client usage:
+ * GET /api/windows?version=12
+ * => 200 { "version": 13, "windows": [ {"title": "Title", ... } ] }
+ * => 304 if the version is still 12.
+ *
+ * GET /api/windows/changes?since=13
+ * => long-poll, answered as soon as the windows change:
+ *    200 { "version": 15, "full": false,
+ *          "windows": [ ...windows modified since 13... ],
+ *          "removed": [ ...uuids of windows removed since 13... ] }
+ * => 304 if nothing changed before the timeout.
+ *
+ * A "full" response lists all the windows, which happens when the history
+ * needed to compute the changes is no longer available.
+ */
+class WindowChangeFeed : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(WindowChangeFeed)
+
+public:
+    /**
+     * Construct a change feed for a DisplayGroup.
+     *
+     * @param group to monitor.
+     */
+    explicit WindowChangeFeed(const DisplayGroup& group);
+
+    /**
+     * Get all the windows.
+     *
+     * @param request with an optional "version" query parameter.
+     * @return the windows, or 304 if the given version is still current.
+     */
+    std::future<zeroeq::http::Response> getWindows(
+        const zeroeq::http::Request& request);
+
+    /**
+     * Get the changes of the windows since a given version (long-poll).
+     *
+     * @param request with a "since" query parameter.
+     * @return the changes when available, or 304 after a timeout.
+     */
+    std::future<zeroeq::http::Response> getChanges(
+        const zeroeq::http::Request& request);
+
+    /** @return the current version of the windows. */
+    uint64_t getVersion();
+
+public slots:
+    /** Update the windows and answer the pending long-poll requests. */
+    void publish();
+
+signals:
+    /** Emitted when pending responses have been completed. */
+    void responsesReady();
+
+private:
+    struct WindowState
+    {
+        size_t windowVersion;
+        int z;
+        uint64_t changed;
+        QJsonObject json;
+    };
+
+    using ResponsePromise = std::promise<zeroeq::http::Response>;
+    struct PendingRequest
+    {
+        uint64_t since;
+        std::shared_ptr<ResponsePromise> promise;
+    };
+
+    const DisplayGroup& _group;
+
+    uint64_t _version = 0;
+    bool _dirty = true;
+    std::vector<QUuid> _order;
+    std::map<QUuid, WindowState> _windows;
+    std::map<QUuid, uint64_t> _removed;
+    uint64_t _horizon = 0;
+    std::string _windowsJson;
+
+    std::map<uint64_t, PendingRequest> _pendingRequests;
+    uint64_t _nextRequestId = 0;
+    QTimer _publishTimer;
+
+    void _update();
+    void _forgetRemovedWindows();
+    std::string _getChanges(uint64_t since) const;
+    bool _respond(uint64_t requestId, zeroeq::http::Response response);
+};
+
+#endif
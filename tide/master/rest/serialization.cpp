@@ -68,6 +68,45 @@ QString to_qstring(const ScreenState state)
         return "UNDEF";
     }
 }
+
+QJsonObject _toJsonObject(const LatencyHistogram& histogram)
+{
+    QJsonArray buckets;
+    const auto& counts = histogram.getBuckets();
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        if (counts[i] == 0)
+            continue;
+        const auto limit = double(LatencyHistogram::getBucketLimitUs(i));
+        buckets.append(
+            QJsonObject{{"le_us", limit}, {"count", double(counts[i])}});
+    }
+    return QJsonObject{{"count", double(histogram.getCount())},
+                       {"mean_ms", histogram.getMeanMs()},
+                       {"max_ms", histogram.getMaxMs()},
+                       {"p50_ms", histogram.getPercentileMs(50.0)},
+                       {"p95_ms", histogram.getPercentileMs(95.0)},
+                       {"p99_ms", histogram.getPercentileMs(99.0)},
+                       {"histogram", buckets}};
+}
+
+QJsonObject _toJsonObject(const FrameTraceStatistics& statistics)
+{
+    QJsonObject stages;
+    for (size_t i = 0; i < size_t(TraceStage::count); ++i)
+    {
+        const auto stage = TraceStage(i);
+        if (statistics[stage].getCount() > 0)
+            stages[getStageName(stage)] = _toJsonObject(statistics[stage]);
+    }
+    return stages;
+}
+
+QJsonObject _toTileLoadsJsonObject(const FrameTraceStatistics& statistics)
+{
+    return QJsonObject{{"queued", double(statistics.getQueuedTileLoads())},
+                       {"running", double(statistics.getRunningTileLoads())}};
+}
 }
 
 QJsonObject to_json_object(ContentWindowPtr window, const DisplayGroup& group)
@@ -118,9 +157,38 @@ QJsonObject to_json_object(const LoggingUtility& logger)
     const QJsonObject screens{{"state", to_qstring(logger.getScreenState())},
                               {"last_change",
                                logger.getLastScreenStateChanged()}};
-    return QJsonObject{{"event", event},
+    const QJsonObject streams{
+        {"frame_count", int(logger.getStreamFrameCount())},
+        {"last_frame_bytes_saved",
+         double(logger.getLastStreamFrameBytesSaved())},
+        {"average_bytes_saved",
+         double(logger.getAverageStreamFrameBytesSaved())}};
+    const QJsonObject displayGroup{
+        {"sent_count", int(logger.getDisplayGroupSentCount())},
+        {"suppressed_count", int(logger.getDisplayGroupSuppressedCount())}};
+
+    QJsonObject nodes;
+    QJsonObject nodesTileLoads;
+    FrameTraceStatistics aggregate;
+    for (const auto& node : logger.getTraceStatistics())
+    {
+        nodes[node.first] = _toJsonObject(node.second);
+        nodesTileLoads[node.first] = _toTileLoadsJsonObject(node.second);
+        aggregate.merge(node.second);
+    }
+    const QJsonObject latency{{"nodes", nodes},
+                              {"aggregate", _toJsonObject(aggregate)}};
+    const QJsonObject tileLoads{{"nodes", nodesTileLoads},
+                                {"aggregate",
+                                 _toTileLoadsJsonObject(aggregate)}};
+
+    return QJsonObject{{"display_group", displayGroup},
+                       {"event", event},
                        {"window", window},
-                       {"screens", screens}};
+                       {"screens", screens},
+                       {"streams", streams},
+                       {"latency", latency},
+                       {"tile_loads", tileLoads}};
 }
 
 QJsonObject to_json_object(const MasterConfiguration& config)
@@ -39,27 +39,46 @@
 
 #include "CachedDataSource.h"
 
+#include "TileCache.h"
 #include "data/QtImage.h"
 
-ImagePtr CachedDataSource::getTileImage(const uint tileId, deflect::View) const
+namespace
 {
-    {
-        const QMutexLocker lock(&_mutex);
-        if (_cache.contains(tileId))
-            return std::make_shared<QtImage>(_cache[tileId]);
-    }
+const size_t defaultCacheSize = 1024 * 1024 * 1024;
+}
 
-    const QImage image = getCachableTileImage(tileId);
-    if (!image.isNull())
+CachedDataSource::~CachedDataSource()
+{
+    getTileCache().remove(this);
+}
+
+ImagePtr CachedDataSource::getTileImage(const uint tileId, deflect::View) const
+{
+    auto image = getTileCache().get(this, tileId);
+    if (image.isNull())
     {
-        const QMutexLocker lock(&_mutex);
-        _cache.insert(tileId, image);
+        image = getCachableTileImage(tileId);
+        if (!image.isNull())
+            getTileCache().insert(this, tileId, getTileLod(tileId), image);
     }
     return std::make_shared<QtImage>(image);
 }
 
 bool CachedDataSource::contains(const uint tileId) const
 {
-    const QMutexLocker lock(&_mutex);
-    return _cache.contains(tileId);
+    return getTileCache().contains(this, tileId);
+}
+
+void CachedDataSource::setVisibleTiles(const Indices& tiles) const
+{
+    std::set<uint> lods;
+    for (auto tile : tiles)
+        lods.insert(getTileLod(tile));
+    getTileCache().setVisibleTiles(this, tiles, lods);
+}
+
+TileCache& CachedDataSource::getTileCache()
+{
+    static TileCache cache{defaultCacheSize};
+    return cache;
 }
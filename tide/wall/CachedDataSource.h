@@ -43,28 +43,36 @@
 #include "DataSource.h"
 
 #include <QImage>
-#include <QMap>
-#include <QMutex>
+
+class TileCache;
 
 /**
- * A data source which maintains a cache of the requested tiles.
+ * A data source which stores the requested tiles in the process-wide cache.
  */
 class CachedDataSource : public DataSource
 {
 public:
+    /** Destructor, removes the tiles of this source from the cache. */
+    ~CachedDataSource();
+
     /** @copydoc DataSource::getTileImage threadsafe */
     ImagePtr getTileImage(uint tileId, deflect::View view) const override;
 
     /** Check if the cache contains an image for a tile. */
     bool contains(uint tileId) const;
 
+    /**
+     * Set the tiles currently visible, which are protected from eviction.
+     * @param tiles the union of the visible tiles of all the synchronizers
+     */
+    void setVisibleTiles(const Indices& tiles) const;
+
+    /** @return the tile cache shared by all the sources of the process. */
+    static TileCache& getTileCache();
+
 protected:
     /** Get a tile image which will be cached. threadsafe */
     virtual QImage getCachableTileImage(uint tileId) const = 0;
-
-private:
-    mutable QMutex _mutex;
-    mutable QMap<uint, QImage> _cache;
 };
 
 #endif
@@ -43,6 +43,7 @@
 #include "types.h"
 
 #include <QObject>
+#include <QRegion>
 
 /**
  * Interface for synchronizing QML content rendering.
@@ -64,9 +65,13 @@ public:
     /** Virtual destructor */
     virtual ~ContentSynchronizer() = default;
 
-    /** Update the Content. */
+    /**
+     * Update the Content.
+     * @param window the window displaying the content.
+     * @param visibleArea the visible parts of the window, in window coordinates.
+     */
     virtual void update(const ContentWindow& window,
-                        const QRectF& visibleArea) = 0;
+                        const QRegion& visibleArea) = 0;
 
     /** Update the tiles; call addTile and updateTile only in this method. */
     virtual void updateTiles() = 0;
@@ -81,6 +86,9 @@ public:
     /** @return true if tiles are ready to be swapped. */
     virtual bool canSwapTiles() const = 0;
 
+    /** @return the indices of the tiles currently visible. */
+    virtual Indices getVisibleTiles() const = 0;
+
     /** The total area covered by the tiles (may depend on current LOD). */
     virtual QSize getTilesArea() const = 0;
 
@@ -39,6 +39,8 @@
 
 #include "DataProvider.h"
 
+#include "FrameSync.h"
+#include "FrameTracer.h"
 #include "Tile.h"
 #include "config.h"
 #include "log.h"
@@ -46,7 +48,6 @@
 #include "scene/Content.h"
 #include "scene/DisplayGroup.h"
 
-#include "BasicSynchronizer.h"
 #include "LodSynchronizer.h"
 #include "PixelStreamSynchronizer.h"
 #include "PixelStreamUpdater.h"
@@ -63,10 +64,26 @@
 
 #include <deflect/Frame.h>
 
-#include <QtConcurrent>
+#include <QThread>
 
 namespace
 {
+// Leave some of the threads to the other sources when a content has many tiles
+const int maxLoadsPerSourceRatio = 2;
+const qint64 LOADER_STATISTICS_INTERVAL_MS = 5000;
+
+template <typename T>
+std::shared_ptr<T> _lock(const std::weak_ptr<T>& source)
+{
+    return source.lock();
+}
+
+template <typename T>
+std::shared_ptr<T> _lock(const std::shared_ptr<T>& source)
+{
+    return source;
+}
+
 template <typename Map>
 std::shared_ptr<typename Map::mapped_type::element_type> _get(
     Map& map, const ContentWindow& window)
@@ -74,7 +91,7 @@ std::shared_ptr<typename Map::mapped_type::element_type> _get(
     const auto& id = window.getID();
     std::shared_ptr<typename Map::mapped_type::element_type> source;
     if (map.count(id))
-        source = map[id].lock();
+        source = _lock(map[id]);
 
     if (!source)
     {
@@ -98,32 +115,93 @@ void _removeUnused(Map& map, const std::set<typename Map::key_type>& validKeys)
     }
 }
 
+// Sources owned by their synchronizers are no longer updated after an error
+template <typename Key, typename T>
+typename std::map<Key, std::weak_ptr<T>>::iterator _removeFailed(
+    std::map<Key, std::weak_ptr<T>>& map,
+    typename std::map<Key, std::weak_ptr<T>>::iterator it,
+    std::set<const DataSource*>&)
+{
+    return map.erase(it);
+}
+
+// Owned sources are synchronized by all processes, they are only removed
+// together with their window in updateDataSources(). Until then they are
+// skipped to report the error only once.
+template <typename Key, typename T>
+typename std::map<Key, std::shared_ptr<T>>::iterator _removeFailed(
+    std::map<Key, std::shared_ptr<T>>&,
+    typename std::map<Key, std::shared_ptr<T>>::iterator it,
+    std::set<const DataSource*>& failedSources)
+{
+    failedSources.insert(it->second.get());
+    return ++it;
+}
+
+template <typename Map>
+void _keepFailed(const Map& map, const std::set<const DataSource*>& failed,
+                 std::set<const DataSource*>& kept)
+{
+    for (const auto& entry : map)
+    {
+        if (failed.count(entry.second.get()))
+            kept.insert(entry.second.get());
+    }
+}
+
+Indices _getVisibleTiles(const DataSource& source)
+{
+    Indices visibleTiles;
+    for (auto synchronizer : source.synchronizers)
+    {
+        const auto tiles = synchronizer->getVisibleTiles();
+        visibleTiles.insert(tiles.begin(), tiles.end());
+    }
+    return visibleTiles;
+}
+
+void _setVisibleTiles(const CachedDataSource& source, const Indices& tiles)
+{
+    source.setVisibleTiles(tiles);
+}
+
+void _setVisibleTiles(const DataSource&, const Indices&)
+{
+    // Only CachedDataSource needs to know the visible tiles
+}
+
 template <typename Updater>
-void _synchronize(WallToWallChannel& channel, Updater& updater)
+void _synchronizeTilesSwap(FrameSync& frameSync,
+                           std::shared_ptr<Updater> updater)
 {
     bool swap = true;
-    for (auto synchronizer : updater.synchronizers)
+    for (auto synchronizer : updater->synchronizers)
         swap = swap && synchronizer->canSwapTiles();
 
-    if (channel.allReady(swap))
-    {
-        for (auto synchronizer : updater.synchronizers)
+    frameSync.addReady(swap, [updater](const bool allReady) {
+        if (!allReady)
+            return;
+        for (auto synchronizer : updater->synchronizers)
             synchronizer->swapTiles();
-        updater.getNextFrame();
-    }
-
-    updater.synchronizeFrameAdvance(channel);
+        updater->getNextFrame();
+    });
 }
 }
 
+DataProvider::DataProvider()
+{
+    const auto threads = QThread::idealThreadCount();
+    const auto maxLoadsPerSource = threads / maxLoadsPerSourceRatio;
+    _loader.reset(new TileLoader(
+        [this](const DataSource& source, const uint tileId,
+               const TileUpdateList& tiles) { _load(source, tileId, tiles); },
+        threads, maxLoadsPerSource));
+}
+
 DataProvider::~DataProvider()
 {
-    for (auto watcher : _watchers)
-    {
-        watcher->disconnect(this);
-        watcher->waitForFinished();
-        delete watcher;
-    }
+    // Wait for the running loads, which emit signals from this object
+    _loader.reset();
 }
 
 std::unique_ptr<ContentSynchronizer> DataProvider::createSynchronizer(
@@ -168,6 +246,7 @@ void DataProvider::updateDataSources(const DisplayGroup& group)
 #endif
         case CONTENT_TYPE_PIXEL_STREAM:
         case CONTENT_TYPE_WEBBROWSER:
+            _getStreamSource(*window);
             updatedStreams.insert(content.getURI());
             break;
         default:
@@ -175,25 +254,36 @@ void DataProvider::updateDataSources(const DisplayGroup& group)
         }
     }
 
-    // Streams and movies must be removed synchronously here. Otherwise, in
-    // synchronizeTilesSwap() locking the weak pointer may succeed on processes
-    // that are asynchronously getting a tile image but fail on the others,
-    // causing a deadlock.
+    // Streams and movies must be removed synchronously here, and only here.
+    // All processes must register the same ones in synchronizeTilesSwap(),
+    // whether or not their windows are visible on this process' screens.
     _removeUnused(_streamSources, updatedStreams);
 #if TIDE_ENABLE_MOVIE_SUPPORT
     _removeUnused(_movieSources, updatedMovies);
 #endif
+
+    // Forget the failed sources that were removed with their window
+    std::set<const DataSource*> failedSources;
+    failedSources.swap(_failedSources);
+    _keepFailed(_streamSources, failedSources, _failedSources);
+#if TIDE_ENABLE_MOVIE_SUPPORT
+    _keepFailed(_movieSources, failedSources, _failedSources);
+#endif
 }
 
 void DataProvider::synchronizeTilesSwap(WallToWallChannel& channel)
 {
-    for (auto stream : _streamSources)
-        _synchronize(channel, *stream.second.lock());
+    // Resolve the swap of all the streams and movies and the advance to the
+    // next frame of all the streams with a single collective operation.
+    FrameSync frameSync;
+    synchronizeTilesSwap(frameSync);
+    channel.synchronize(frameSync);
+
     _updateTiles(_streamSources);
 
 #if TIDE_ENABLE_MOVIE_SUPPORT
     for (auto movie : _movieSources)
-        _synchronize(channel, *movie.second.lock());
+        movie.second->synchronizeFrameAdvance(channel);
     _updateTiles(_movieSources);
 #endif
 
@@ -208,6 +298,23 @@ void DataProvider::synchronizeTilesSwap(WallToWallChannel& channel)
 #endif
 
     _updateTiles(_svgSources);
+
+    // Tiles which left the visible set have been destroyed by now
+    _loader->cancelExpired();
+    _updateLoaderStatistics();
+}
+
+void DataProvider::synchronizeTilesSwap(FrameSync& frameSync)
+{
+    for (auto stream : _streamSources)
+    {
+        _synchronizeTilesSwap(frameSync, stream.second);
+        stream.second->synchronizeFrameAdvance(frameSync);
+    }
+#if TIDE_ENABLE_MOVIE_SUPPORT
+    for (auto movie : _movieSources)
+        _synchronizeTilesSwap(frameSync, movie.second);
+#endif
 }
 
 void DataProvider::loadAsync(TilePtr tile, deflect::View view)
@@ -220,13 +327,9 @@ void DataProvider::loadAsync(TilePtr tile, deflect::View view)
 
 void DataProvider::setNewFrame(deflect::FramePtr frame)
 {
-    if (!_streamSources.count(frame->uri))
-        return;
-
-    if (auto updater = _streamSources[frame->uri].lock())
-        updater->updatePixelStream(frame);
-    else
-        _streamSources.erase(frame->uri);
+    const auto it = _streamSources.find(frame->uri);
+    if (it != _streamSources.end())
+        it->second->updatePixelStream(frame);
 }
 
 template <typename DataSources>
@@ -235,8 +338,14 @@ void DataProvider::_updateTiles(DataSources& dataSources)
     auto it = dataSources.begin();
     while (it != dataSources.end())
     {
-        if (auto source = it->second.lock())
+        if (auto source = _lock(it->second))
         {
+            if (_failedSources.count(source.get()))
+            {
+                ++it;
+                continue;
+            }
+
             // The following results in loadAsync() being called one or multiple
             // times, filling _tileImageRequests with the tiles from the
             // different WallWindows for this data source.
@@ -247,14 +356,19 @@ void DataProvider::_updateTiles(DataSources& dataSources)
             }
             catch (const std::exception& exc)
             {
+                // Drop the partial requests, they must not be charged to the
+                // next data source
+                _tileImageRequests.clear();
                 _handleError<decltype(source)>(it->first, exc);
-                it = dataSources.erase(it);
+                it = _removeFailed(dataSources, it, _failedSources);
                 continue;
             }
+            const auto visibleTiles = _getVisibleTiles(*source);
+            _setVisibleTiles(*source, visibleTiles);
 
             // Start the asynchronous loading of images for this data source
             // and clear the list of requests for the next data source.
-            _processTileImageRequests(source);
+            _processTileImageRequests(source, visibleTiles);
             ++it;
         }
         else
@@ -274,17 +388,19 @@ void DataProvider::_handleError<std::shared_ptr<PixelStreamUpdater>, QString>(
     emit closePixelStream(uri);
 }
 
-void DataProvider::_processTileImageRequests(DataSourcePtr source)
+void DataProvider::_processTileImageRequests(DataSourcePtr source,
+                                             const Indices& visibleTiles)
 {
     for (const auto& tileRequest : _tileImageRequests)
     {
-        auto watcher = new Watcher;
-        _watchers.append(watcher);
-        connect(watcher, &Watcher::finished, this,
-                &DataProvider::_handleFinished);
-        const auto& tilesToUpdate = tileRequest.second;
-        watcher->setFuture(QtConcurrent::run(
-            [this, source, tilesToUpdate] { _load(source, tilesToUpdate); }));
+        const auto tileId = tileRequest.first;
+
+        TileLoader::Priority priority;
+        priority.dynamic = source->isDynamic();
+        priority.visible = visibleTiles.count(tileId) > 0;
+        priority.lod = source->getTileLod(tileId);
+
+        _loader->request(source, tileId, tileRequest.second, priority);
     }
     _tileImageRequests.clear();
 }
@@ -293,27 +409,23 @@ std::shared_ptr<PixelStreamUpdater> DataProvider::_getStreamSource(
     const ContentWindow& window)
 {
     const auto& uri = window.getContent()->getURI();
-    std::shared_ptr<PixelStreamUpdater> updater;
-    if (_streamSources.count(uri))
-        updater = _streamSources[uri].lock();
-
+    auto& updater = _streamSources[uri];
     if (!updater)
     {
         updater = std::make_shared<PixelStreamUpdater>();
         connect(updater.get(), &PixelStreamUpdater::requestFrame, this,
                 &DataProvider::requestFrame);
-        _streamSources[uri] = updater;
 
         // Fix DISCL-382: New frames are requested after showing the current
         // one, but it's conditional to _streamSources[id] in setNewFrame(),
         // hence request a frame once we have a PixelStreamUpdater.
         emit requestFrame(uri);
     }
-
     return updater;
 }
 
-void DataProvider::_load(DataSourcePtr source, const TileUpdateList& tiles)
+void DataProvider::_load(const DataSource& source, const uint tileId,
+                         const TileUpdateList& tiles)
 {
     // Request image only once for each view
     std::map<deflect::View, ImagePtr> image;
@@ -323,39 +435,57 @@ void DataProvider::_load(DataSourcePtr source, const TileUpdateList& tiles)
         if (auto tile = it.first.lock())
         {
             const auto view = it.second;
-            const auto id = tile->getId();
             if (!image[view])
             {
                 try
                 {
-                    image[view] = source->getTileImage(id, view);
+                    image[view] = source.getTileImage(tileId, view);
                 }
                 catch (...)
                 {
-                    put_flog(LOG_ERROR, "An error occured with tile: %d", id);
+                    put_flog(LOG_ERROR, "An error occured with tile: %d",
+                             tileId);
                     return;
                 }
                 if (!image[view])
                 {
-                    put_flog(LOG_DEBUG, "Empty image for tile: %d", id);
+                    put_flog(LOG_DEBUG, "Empty image for tile: %d", tileId);
                     return;
                 }
                 emit imageLoaded(); // Keep RenderController active
             }
+            // Staging on this thread spares the copy to the render thread
             QMetaObject::invokeMethod(tile.get(), "updateBackTexture",
                                       Qt::QueuedConnection,
-                                      Q_ARG(ImagePtr, image[view]));
+                                      Q_ARG(ImagePtr,
+                                            tile->stage(image[view])));
         }
         else
             put_flog(LOG_DEBUG, "Tile expired");
     }
 }
 
-void DataProvider::_handleFinished()
+void DataProvider::_updateLoaderStatistics()
 {
-    auto watcher = static_cast<Watcher*>(sender());
-    _watchers.removeOne(watcher);
-    watcher->deleteLater();
+    if (!_loaderStatisticsTimer.isValid())
+        _loaderStatisticsTimer.start();
+
+    if (_loaderStatisticsTimer.elapsed() < LOADER_STATISTICS_INTERVAL_MS)
+        return;
+
+    const auto stats = _loader->takeStatistics();
+    FrameTracer::instance().setTileLoads(stats.queued, stats.running);
+    if (stats.started > 0 || stats.queued > 0)
+    {
+        put_flog(LOG_DEBUG,
+                 "tile loader: %lu queued, %lu running, %lu started, "
+                 "%lu merged, %lu cancelled, wait avg %.1f ms max %.1f ms",
+                 (unsigned long)stats.queued, (unsigned long)stats.running,
+                 (unsigned long)stats.started, (unsigned long)stats.merged,
+                 (unsigned long)stats.cancelled, stats.averageWaitMs,
+                 stats.maxWaitMs);
+    }
+    _loaderStatisticsTimer.restart();
 }
 
 std::unique_ptr<ContentSynchronizer> DataProvider::_makeSynchronizer(
@@ -390,7 +520,7 @@ std::unique_ptr<ContentSynchronizer> DataProvider::_makeSynchronizer(
     case CONTENT_TYPE_SVG:
         return make_unique<LodSynchronizer>(_get(_svgSources, window));
     case CONTENT_TYPE_TEXTURE:
-        return make_unique<BasicSynchronizer>(_get(_imageSources, window));
+        return make_unique<LodSynchronizer>(_get(_imageSources, window));
     default:
         throw std::runtime_error("No ContentSynchronizer for ContentType");
     }
@@ -52,9 +52,9 @@
 #include "PDFTiler.h"
 #endif
 #include "SVGTiler.h"
+#include "TileLoader.h"
 
-#include <QFutureWatcher>
-#include <QList>
+#include <QElapsedTimer>
 #include <QObject>
 
 /**
@@ -67,7 +67,7 @@ class DataProvider : public QObject
 
 public:
     /** Construct a data provider. */
-    DataProvider() = default;
+    DataProvider();
 
     /** Destructor. */
     ~DataProvider();
@@ -79,6 +79,10 @@ public:
     /**
      * Update the data sources with information from a new display group.
      *
+     * The streams and movies of all the windows of the group are kept, even
+     * the ones not visible on this process, so that all processes synchronize
+     * the same ones.
+     *
      * @param group containing updated information for the movies/pdfs/streams.
      */
     void updateDataSources(const DisplayGroup& group);
@@ -90,6 +94,14 @@ public:
      */
     void synchronizeTilesSwap(WallToWallChannel& channel);
 
+    /**
+     * Register the swap of the Tiles of all streams and movies.
+     *
+     * @param frameSync where to register the synchronization, which registers
+     *        the same entries on all processes.
+     */
+    void synchronizeTilesSwap(FrameSync& frameSync);
+
 public slots:
     /** Load an image asynchronously. */
     void loadAsync(TilePtr tile, deflect::View view);
@@ -108,33 +120,39 @@ signals:
     void imageLoaded();
 
 private:
-    using Watcher = QFutureWatcher<void>;
-    QList<Watcher*> _watchers;
+    std::unique_ptr<TileLoader> _loader;
+    QElapsedTimer _loaderStatisticsTimer;
 
     std::map<QUuid, std::weak_ptr<ImageSource>> _imageSources;
 #if TIDE_USE_TIFF
     std::map<QUuid, std::weak_ptr<ImagePyramidDataSource>> _imagePyrSources;
 #endif
-#if TIDE_ENABLE_MOVIE_SUPPORT
-    std::map<QUuid, std::weak_ptr<MovieUpdater>> _movieSources;
-#endif
 #if TIDE_ENABLE_PDF_SUPPORT
     std::map<QUuid, std::weak_ptr<PDFTiler>> _pdfSources;
 #endif
-    std::map<QString, std::weak_ptr<PixelStreamUpdater>> _streamSources;
+    // Owned here rather than by their synchronizers, which only exist for the
+    // windows visible on this process
+#if TIDE_ENABLE_MOVIE_SUPPORT
+    std::map<QUuid, std::shared_ptr<MovieUpdater>> _movieSources;
+#endif
+    std::map<QString, std::shared_ptr<PixelStreamUpdater>> _streamSources;
     std::map<QUuid, std::weak_ptr<SVGTiler>> _svgSources;
 
-    using TileUpdateInfo = std::pair<TileWeakPtr, deflect::View>;
-    using TileUpdateList = std::vector<TileUpdateInfo>;
+    // Owned sources which failed to update, until their window is removed
+    std::set<const DataSource*> _failedSources;
+
+    using TileUpdateList = TileLoader::TileUpdateList;
     std::map<uint, TileUpdateList> _tileImageRequests;
 
     using DataSourcePtr = std::shared_ptr<DataSource>;
-    void _processTileImageRequests(DataSourcePtr source);
+    void _processTileImageRequests(DataSourcePtr source,
+                                   const Indices& visibleTiles);
 
     std::shared_ptr<PixelStreamUpdater> _getStreamSource(
         const ContentWindow& window);
-    void _load(DataSourcePtr source, const TileUpdateList& tileList);
-    void _handleFinished();
+    void _load(const DataSource& source, uint tileId,
+               const TileUpdateList& tiles);
+    void _updateLoaderStatistics();
     std::unique_ptr<ContentSynchronizer> _makeSynchronizer(
         const ContentWindow& window, deflect::View view);
 
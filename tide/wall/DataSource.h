@@ -42,6 +42,8 @@
 
 #include "types.h"
 
+#include <algorithm>
+
 /**
  * Base interface for shared data sources.
  */
@@ -71,6 +73,21 @@ public:
     /** @return the max LOD level (top of pyramid, lowest resolution). */
     virtual uint getMaxLod() const = 0;
 
+    /** @return the LOD of a tile, used to prioritize and evict tiles. */
+    virtual uint getTileLod(uint tileId) const
+    {
+        Q_UNUSED(tileId);
+        return 0;
+    }
+
+    /** Unlink a synchronizer from this data source, which may outlive it. */
+    void removeSynchronizer(const ContentSynchronizer* synchronizer)
+    {
+        synchronizers.erase(std::remove(synchronizers.begin(),
+                                        synchronizers.end(), synchronizer),
+                            synchronizers.end());
+    }
+
     /** The synchronizers linked to this shared data source. */
     std::vector<ContentSynchronizer*> synchronizers;
 };
@@ -0,0 +1,194 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "DiskTileCache.h"
+
+#include "fileCache.h"
+#include "log.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace
+{
+const qint64 defaultMaxSize = qint64(8) * 1024 * 1024 * 1024;
+const char* tileFormat = "png";
+
+// Generating the tiles of a large image can take minutes, but the lock of a
+// process that crashed meanwhile must not block the others forever
+const int lockStaleTimeMs = 10 * 60 * 1000;
+// Loader threads must not wait for another process to generate all the tiles
+const int lockTimeoutMs = 500;
+
+DiskTileCache::Settings& _getSettings()
+{
+    static DiskTileCache::Settings settings{
+        QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+            "/tide/tiles",
+        defaultMaxSize};
+    return settings;
+}
+
+qint64 _getSize(const QDir& dir)
+{
+    qint64 size = 0;
+    for (const auto& file : dir.entryInfoList(QDir::Files))
+        size += file.size();
+    return size;
+}
+}
+
+void DiskTileCache::setSettings(const Settings& settings)
+{
+    _getSettings() = settings;
+}
+
+const DiskTileCache::Settings& DiskTileCache::getSettings()
+{
+    return _getSettings();
+}
+
+DiskTileCache::DiskTileCache(const QString& uri, const Settings& settings)
+    : _settings(settings)
+{
+    const auto imageId = fileCache::getKey(uri);
+    if (imageId.isEmpty())
+        return;
+
+    const auto directory = QDir{_settings.directory}.absoluteFilePath(imageId);
+    if (QDir{directory}.exists())
+    {
+        // The modification date orders the folders for eviction
+        fileCache::touch(directory);
+        _directory = directory;
+        return;
+    }
+
+    if (!QDir().mkpath(directory))
+    {
+        put_flog(LOG_WARN, "could not create tile cache folder: '%s'",
+                 directory.toLocal8Bit().constData());
+        return;
+    }
+    _directory = directory;
+    // Listing the whole cache is too slow for the rendering thread
+    _evictionPending = true;
+}
+
+QImage DiskTileCache::load(const uint tileId) const
+{
+    if (_directory.isEmpty())
+        return QImage();
+
+    const auto path = _getPath(tileId);
+    if (!QFileInfo::exists(path))
+        return QImage();
+    return QImage{path, tileFormat};
+}
+
+bool DiskTileCache::save(const uint tileId, const QImage& image) const
+{
+    if (_directory.isEmpty())
+        return false;
+
+    if (_evictionPending.exchange(false))
+        _evictLeastRecentlyUsed();
+
+    QSaveFile file{_getPath(tileId)};
+    if (file.open(QIODevice::WriteOnly) && image.save(&file, tileFormat) &&
+        file.commit())
+    {
+        return true;
+    }
+    put_flog(LOG_WARN, "could not store tile %d in: '%s'", tileId,
+             _directory.toLocal8Bit().constData());
+    return false;
+}
+
+std::unique_ptr<QLockFile> DiskTileCache::lock() const
+{
+    if (_directory.isEmpty())
+        return nullptr;
+
+    auto lockFile = make_unique<QLockFile>(_directory + "/.lock");
+    lockFile->setStaleLockTime(lockStaleTimeMs);
+    if (!lockFile->tryLock(lockTimeoutMs))
+    {
+        put_flog(LOG_WARN, "could not lock tile cache folder: '%s' (error %d)",
+                 _directory.toLocal8Bit().constData(), lockFile->error());
+        return nullptr;
+    }
+    return lockFile;
+}
+
+QString DiskTileCache::_getPath(const uint tileId) const
+{
+    return QString("%1/%2.%3").arg(_directory).arg(tileId).arg(tileFormat);
+}
+
+void DiskTileCache::_evictLeastRecentlyUsed() const
+{
+    const auto filter = QDir::Dirs | QDir::NoDotAndDotDot;
+    auto folders = QDir{_settings.directory}.entryInfoList(filter);
+    std::sort(folders.begin(), folders.end(),
+              [](const QFileInfo& a, const QFileInfo& b) {
+                  return a.lastModified() > b.lastModified();
+              });
+
+    // Keep the most recently used folders up to the maximum size
+    qint64 size = 0;
+    for (const auto& folder : folders)
+    {
+        const auto path = folder.absoluteFilePath();
+        const auto folderSize = _getSize(QDir{path});
+        if (size + folderSize <= _settings.maxSize || path == _directory)
+        {
+            size += folderSize;
+            continue;
+        }
+        put_flog(LOG_DEBUG, "removing tiles: '%s'",
+                 path.toLocal8Bit().constData());
+        QDir{path}.removeRecursively();
+    }
+}
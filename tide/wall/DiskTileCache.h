@@ -0,0 +1,110 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef DISKTILECACHE_H
+#define DISKTILECACHE_H
+
+#include "types.h"
+
+#include <QImage>
+#include <QLockFile>
+
+#include <atomic>
+
+/**
+ * A persistent on-disk cache for the tiles of an image file.
+ *
+ * The tiles are stored in a folder named after the path, modification date
+ * and size of the image, so that a modified image never gets outdated tiles.
+ * When a new folder is created, the folders of the least recently opened
+ * images are removed on the first save to keep the cache below its maximum
+ * size.
+ *
+ * Several processes can share the same cache. Use lock() to generate tiles
+ * only once.
+ */
+class DiskTileCache
+{
+public:
+    /** Settings shared by the caches of all images. */
+    struct Settings
+    {
+        QString directory;  /**< Parent folder of the tiles of all images. */
+        qint64 maxSize = 0; /**< Maximum size in bytes, 0 to disable. */
+    };
+
+    /** Set the settings of the caches opened afterwards. */
+    static void setSettings(const Settings& settings);
+
+    /** @return the current settings, 8 GB in the user cache by default. */
+    static const Settings& getSettings();
+
+    /**
+     * Open the cache for an image, creating its folder if needed.
+     * @param uri the image file.
+     * @param settings the folder and maximum size of the cache.
+     */
+    DiskTileCache(const QString& uri, const Settings& settings);
+
+    /** @return the image of a tile, or a null image if it is not cached. */
+    QImage load(uint tileId) const;
+
+    /** Store the image of a tile. @return true on success. */
+    bool save(uint tileId, const QImage& image) const;
+
+    /**
+     * Lock the cache of the image across processes.
+     *
+     * Only waits briefly if another process holds the lock.
+     * @return the acquired lock, released on destruction, or nullptr if it
+     *         could not be acquired.
+     */
+    std::unique_ptr<QLockFile> lock() const;
+
+private:
+    const Settings _settings;
+    QString _directory;
+    mutable std::atomic<bool> _evictionPending{false};
+
+    QString _getPath(uint tileId) const;
+    void _evictLeastRecentlyUsed() const;
+};
+
+#endif
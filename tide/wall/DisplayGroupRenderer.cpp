@@ -96,38 +96,51 @@ void DisplayGroupRenderer::setDisplayGroup(DisplayGroupPtr displayGroup)
     _engine.rootContext()->setContextProperty("displaygroup",
                                               displayGroup.get());
 
-    // Update windows, creating new ones if needed
-    QSet<QUuid> updatedWindows;
-    const QQuickItem* parentItem = nullptr;
+    // Update the windows visible on this process' screens, creating new ones
+    // if needed. Other windows are not rendered at all, but their streams and
+    // movies keep being synchronized by the DataProvider on all processes.
+    QSet<QUuid> visibleWindows;
+    std::vector<QUuid> stackingOrder;
     const VisibilityHelper helper(*displayGroup, _screenRect);
     for (const auto& window : displayGroup->getContentWindows())
     {
-        const auto& id = window->getID();
+        if (!helper.isInVisibleArea(*window))
+            continue;
 
-        updatedWindows.insert(id);
+        const auto& id = window->getID();
+        visibleWindows.insert(id);
+        stackingOrder.push_back(id);
 
         if (!_windowItems.contains(id))
             _createWindowQmlItem(window);
 
-        _windowItems[id]->update(window, helper.getVisibleArea(*window));
-
-        // Update stacking order
-        auto quickItem = _windowItems[id]->getQuickItem();
-        if (parentItem)
-            quickItem->stackAfter(parentItem);
-        parentItem = quickItem;
+        _windowItems[id]->update(window, helper.getVisibleRegion(*window));
     }
 
-    // Remove old windows
+    // Remove closed windows and windows which left the screens
     auto it = _windowItems.begin();
     while (it != _windowItems.end())
     {
-        if (updatedWindows.contains(it.key()))
+        if (visibleWindows.contains(it.key()))
             ++it;
         else
             it = _windowItems.erase(it);
     }
 
+    // Update stacking order
+    if (stackingOrder != _stackingOrder)
+    {
+        const QQuickItem* parentItem = nullptr;
+        for (const auto& id : stackingOrder)
+        {
+            auto quickItem = _windowItems[id]->getQuickItem();
+            if (parentItem)
+                quickItem->stackAfter(parentItem);
+            parentItem = quickItem;
+        }
+        _stackingOrder = std::move(stackingOrder);
+    }
+
     // Retain the new DisplayGroup
     _displayGroup = displayGroup;
 
@@ -223,5 +236,5 @@ void DisplayGroupRenderer::_setBackground(ContentPtr content)
 
     DisplayGroup emptyGroup(_screenRect.size());
     const VisibilityHelper helper(emptyGroup, _screenRect);
-    _backgroundWindowItem->update(window, helper.getVisibleArea(*window));
+    _backgroundWindowItem->update(window, helper.getVisibleRegion(*window));
 }
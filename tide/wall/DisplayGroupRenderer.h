@@ -48,10 +48,17 @@
 #include <QtCore/QObject>
 #include <QtCore/QUuid>
 
+#include <vector>
+
 class QQuickItem;
 
 /**
  * Renders a DisplayGroup.
+ *
+ * Only the windows which intersect the screens of this process have QML items
+ * and synchronizers. Windows which are unchanged since the previous
+ * DisplayGroup (shared by the DisplayGroupPatch) and whose visible area is
+ * unchanged are not updated.
  */
 class DisplayGroupRenderer : public QObject
 {
@@ -106,6 +113,7 @@ private:
     QQuickItem* _displayGroupItem = nullptr; // child of parent item
     using QmlWindowPtr = std::shared_ptr<QmlWindowRenderer>;
     QMap<QUuid, QmlWindowPtr> _windowItems;
+    std::vector<QUuid> _stackingOrder;
     QmlWindowPtr _backgroundWindowItem;
 
     void _createDisplayGroupQmlItem(QQuickItem& parentItem);
@@ -0,0 +1,85 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "FrameSync.h"
+
+#include <cassert>
+
+void FrameSync::addReady(const bool isReady, Callback callback)
+{
+    _entries.push_back(Entry{_values.size(), false, std::move(callback)});
+    _values.push_back(isReady ? 1 : 0);
+}
+
+void FrameSync::addVersion(const uint64_t version, Callback callback)
+{
+    // min(-version) == -max(version): the versions are all equal if the
+    // global minimum matches the global maximum.
+    _entries.push_back(Entry{_values.size(), true, std::move(callback)});
+    _values.push_back(int64_t(version));
+    _values.push_back(-int64_t(version));
+}
+
+std::size_t FrameSync::size() const
+{
+    return _entries.size();
+}
+
+void FrameSync::resolve(const GlobalMinFunction& globalMin)
+{
+    if (_entries.empty())
+        return;
+
+    const auto results = globalMin(_values);
+    assert(results.size() == _values.size());
+
+    const auto entries = std::move(_entries);
+    _entries.clear();
+    _values.clear();
+
+    for (const auto& entry : entries)
+    {
+        const auto i = entry.index;
+        const bool ok = entry.isVersion ? results[i] == -results[i + 1]
+                                        : results[i] == 1;
+        if (entry.callback)
+            entry.callback(ok);
+    }
+}
@@ -0,0 +1,106 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef FRAMESYNC_H
+#define FRAMESYNC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Collect the readiness flags and versions that need to be agreed upon by
+ * all processes before rendering a frame, and resolve them all at once.
+ *
+ * Each entry is encoded so that a single element-wise global minimum gives
+ * the result of all of them, which replaces one collective operation per
+ * entry by a single one per frame.
+ *
+ * All processes must register the same entries in the same order.
+ */
+class FrameSync
+{
+public:
+    /** Function called with the result of an entry after resolution. */
+    using Callback = std::function<void(bool)>;
+
+    /** Function computing the element-wise minimum across processes. */
+    using GlobalMinFunction =
+        std::function<std::vector<int64_t>(const std::vector<int64_t>&)>;
+
+    /**
+     * Add a readiness flag.
+     * @param isReady the local state of this process
+     * @param callback called with true if all processes are ready
+     */
+    void addReady(bool isReady, Callback callback);
+
+    /**
+     * Add an object version.
+     * @param version the local version of the object
+     * @param callback called with true if all processes have the same version
+     */
+    void addVersion(uint64_t version, Callback callback);
+
+    /** @return the number of registered entries. */
+    std::size_t size() const;
+
+    /**
+     * Resolve all entries and call their callbacks in order of registration.
+     *
+     * The entries are cleared before calling the callbacks, which allows them
+     * to register entries for a subsequent resolution.
+     * @param globalMin the function to reduce the entries across processes
+     */
+    void resolve(const GlobalMinFunction& globalMin);
+
+private:
+    struct Entry
+    {
+        std::size_t index;
+        bool isVersion;
+        Callback callback;
+    };
+    std::vector<int64_t> _values;
+    std::vector<Entry> _entries;
+};
+
+#endif
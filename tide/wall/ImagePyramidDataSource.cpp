@@ -41,9 +41,13 @@
 
 #include "data/TiffPyramidReader.h"
 
+#include <QThread>
+#include <QtConcurrent>
+
 namespace
 {
 const QSize previewSize{1920, 1920};
+const int readAheadThreads = 2;
 }
 
 std::pair<QSize, uint> _getLodParameters(const QString& uri)
@@ -59,29 +63,48 @@ ImagePyramidDataSource::ImagePyramidDataSource(const QString& uri)
     : LodTiler{_getLodParameters(uri)}
     , _uri{uri}
 {
+    const auto tif = _getReader();
+    _previewRect = QRect{QPoint(), tif->readSize(tif->findLevel(previewSize))};
+    _readAheadPool.setMaxThreadCount(readAheadThreads);
+}
+
+ImagePyramidDataSource::~ImagePyramidDataSource()
+{
+    _readAheadPool.clear();
+    _readAheadPool.waitForDone();
 }
 
 QRect ImagePyramidDataSource::getTileRect(const uint tileId) const
 {
     if (tileId == 0)
+        return _previewRect;
+    return LodTiler::getTileRect(tileId);
+}
+
+Indices ImagePyramidDataSource::computeVisibleSet(
+    const QRectF& visibleTilesArea, const uint lod) const
+{
+    const auto visibleSet = LodTiler::computeVisibleSet(visibleTilesArea, lod);
+    if (!visibleSet.empty())
     {
-        TiffPyramidReader tif{_uri};
-        return {QPoint(), tif.readSize(tif.findLevel(previewSize))};
+        const auto readAheadSet = _getReadAheadSet(visibleTilesArea, lod);
+        _readAhead(set_difference(readAheadSet, visibleSet));
     }
-    return LodTiler::getTileRect(tileId);
+    return visibleSet;
 }
 
 QImage ImagePyramidDataSource::getCachableTileImage(const uint tileId) const
 {
-    TiffPyramidReader tif{_uri};
+    const LoadingTile loading{*this, tileId};
+    const auto tif = _getReader();
 
     QImage image;
     if (tileId == 0)
-        image = tif.readImage(tif.findLevel(previewSize));
+        image = tif->readImage(tif->findLevel(previewSize));
     else
     {
         const auto index = _lodTool.getTileIndex(tileId);
-        image = tif.readTile(index.x, index.y, index.lod);
+        image = tif->readTile(index.x, index.y, index.lod);
     }
 
     // TIFF tiles all have a fixed size. Those at the top of the pyramid
@@ -96,3 +119,99 @@ QImage ImagePyramidDataSource::getCachableTileImage(const uint tileId) const
         image = image.convertToFormat(QImage::Format_RGB32);
     return image;
 }
+
+ImagePyramidDataSource::LoadingTile::LoadingTile(
+    const ImagePyramidDataSource& source_, const uint tileId_)
+    : source(source_)
+    , tileId(tileId_)
+{
+    const QMutexLocker lock(&source._readAheadMutex);
+    source._loadingTiles.insert(tileId);
+}
+
+ImagePyramidDataSource::LoadingTile::~LoadingTile()
+{
+    const QMutexLocker lock(&source._readAheadMutex);
+    source._loadingTiles.erase(source._loadingTiles.find(tileId));
+}
+
+ImagePyramidDataSource::ReaderPtr ImagePyramidDataSource::_getReader() const
+{
+    // Opening the file and parsing its directories is expensive, so readers
+    // are reused. libtiff handles are not threadsafe, each reader is used by
+    // one thread at a time and returned to the idle readers afterwards.
+    std::unique_ptr<TiffPyramidReader> reader;
+    {
+        const QMutexLocker lock(&_readersMutex);
+        if (!_idleReaders.empty())
+        {
+            reader = std::move(_idleReaders.back());
+            _idleReaders.pop_back();
+        }
+    }
+    if (!reader)
+        reader = make_unique<TiffPyramidReader>(_uri);
+
+    return ReaderPtr(reader.release(), [this](TiffPyramidReader* released) {
+        std::unique_ptr<TiffPyramidReader> idle{released};
+        const QMutexLocker lock(&_readersMutex);
+        if (_idleReaders.size() < size_t(QThread::idealThreadCount()))
+            _idleReaders.push_back(std::move(idle));
+    });
+}
+
+Indices ImagePyramidDataSource::_getReadAheadSet(const QRectF& visibleTilesArea,
+                                                 const uint lod) const
+{
+    // Ring of tiles around the visible ones at the current lod
+    const auto tileSize = LodTiler::getTileRect(_lodTool.getFirstTileId(lod));
+    const auto margin = std::max(tileSize.width(), tileSize.height());
+    const auto ring =
+        visibleTilesArea.adjusted(-margin, -margin, margin, margin);
+    auto tiles = LodTiler::computeVisibleSet(ring, lod);
+
+    // Visible tiles at the adjacent levels of detail
+    const auto lodArea = QSizeF(getTilesArea(lod));
+    const auto addLod = [&](const uint otherLod) {
+        const auto otherArea = QSizeF(getTilesArea(otherLod));
+        const auto t =
+            QTransform::fromScale(otherArea.width() / lodArea.width(),
+                                  otherArea.height() / lodArea.height());
+        const auto other =
+            LodTiler::computeVisibleSet(t.mapRect(visibleTilesArea), otherLod);
+        tiles.insert(other.begin(), other.end());
+    };
+    if (lod > 0)
+        addLod(lod - 1);
+    if (lod < getMaxLod())
+        addLod(lod + 1);
+
+    return tiles;
+}
+
+void ImagePyramidDataSource::_readAhead(const Indices& tiles) const
+{
+    const QMutexLocker lock(&_readAheadMutex);
+    for (auto tileId : tiles)
+    {
+        if (tileId == 0 || contains(tileId) || _pendingReadAhead.count(tileId) ||
+            _loadingTiles.count(tileId))
+        {
+            continue;
+        }
+
+        _pendingReadAhead.insert(tileId);
+        QtConcurrent::run(&_readAheadPool, [this, tileId] {
+            try
+            {
+                getTileImage(tileId, deflect::View::mono);
+            }
+            catch (...)
+            {
+                // Ignore errors, the tile will be read again if requested
+            }
+            const QMutexLocker pendingLock(&_readAheadMutex);
+            _pendingReadAhead.erase(tileId);
+        });
+    }
+}
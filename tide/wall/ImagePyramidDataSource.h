@@ -42,8 +42,18 @@
 
 #include "LodTiler.h"
 
+#include <QMutex>
+#include <QThreadPool>
+
+class TiffPyramidReader;
+
 /**
  * A data source for tiled image pyramids.
+ *
+ * The TIFF file is kept open for the lifetime of the data source, by a pool
+ * of readers which are reused by the loading threads. The tiles surrounding
+ * the visible ones and those of the adjacent levels of detail are read ahead
+ * into the tile cache, unless they are already being loaded.
  */
 class ImagePyramidDataSource : public LodTiler
 {
@@ -51,13 +61,48 @@ public:
     /** Constructor. */
     explicit ImagePyramidDataSource(const QString& uri);
 
+    /** Destructor, waits for pending read-ahead of tiles. */
+    ~ImagePyramidDataSource();
+
     /** @copydoc DataSource::getTileRect */
     QRect getTileRect(uint tileId) const final;
 
+    /**
+     * @copydoc DataSource::computeVisibleSet
+     * Also starts reading ahead the tiles likely to be requested next.
+     */
+    Indices computeVisibleSet(const QRectF& visibleTilesArea,
+                              uint lod) const final;
+
 private:
     const QString _uri;
+    QRect _previewRect;
+
+    mutable QMutex _readersMutex;
+    mutable std::vector<std::unique_ptr<TiffPyramidReader>> _idleReaders;
+
+    mutable QThreadPool _readAheadPool;
+    mutable QMutex _readAheadMutex; // protects the members below
+    mutable Indices _pendingReadAhead;
+    mutable std::multiset<uint> _loadingTiles;
+
+    /** Register a tile being loaded for the duration of its scope. */
+    struct LoadingTile
+    {
+        LoadingTile(const ImagePyramidDataSource& source, uint tileId);
+        ~LoadingTile();
+        const ImagePyramidDataSource& source;
+        const uint tileId;
+    };
 
     QImage getCachableTileImage(uint tileId) const final; // threadsafe
+
+    using ReaderPtr =
+        std::unique_ptr<TiffPyramidReader,
+                        std::function<void(TiffPyramidReader*)>>;
+    ReaderPtr _getReader() const;
+    Indices _getReadAheadSet(const QRectF& visibleTilesArea, uint lod) const;
+    void _readAhead(const Indices& tiles) const;
 };
 
 #endif
@@ -39,52 +39,139 @@
 
 #include "ImageSource.h"
 
+#include "DiskTileCache.h"
 #include "data/QtImage.h"
+#include "log.h"
 
 #include <QImageReader>
 
-ImageSource::ImageSource(const QString& uri)
-    : _uri(uri)
-    , _imageSize(QImageReader(_uri).size())
+namespace
+{
+const uint tileSize = 1024;
+// Formats that Qt decodes by region and at reduced resolution (DCT scaling)
+const QList<QByteArray> regionDecodeFormats{"jpeg", "jpg"};
+
+QSize _getImageSize(const QString& uri)
 {
+    const auto size = QImageReader(uri).size();
+    return size.isValid() ? size : QSize(0, 0);
 }
 
-QRect ImageSource::getTileRect(const uint tileIndex) const
+bool _canDecodeRegion(const QString& uri)
 {
-    Q_UNUSED(tileIndex);
-    return QRect(QPoint(0, 0), _imageSize);
+    return regionDecodeFormats.contains(QImageReader(uri).format().toLower());
+}
 }
 
-QSize ImageSource::getTilesArea(const uint lod) const
+ImageSource::ImageSource(const QString& uri)
+    : LodTiler{_getImageSize(uri), tileSize}
+    , _uri(uri)
+    , _regionDecode{_canDecodeRegion(uri)}
 {
-    Q_UNUSED(lod);
-    return _imageSize;
+    const auto& settings = DiskTileCache::getSettings();
+    if (getMaxLod() > 0 && settings.maxSize > 0)
+        _diskCache = make_unique<DiskTileCache>(uri, settings);
 }
 
-QImage ImageSource::getCachableTileImage(const uint tileIndex) const
+ImageSource::~ImageSource()
 {
-    Q_UNUSED(tileIndex);
+}
+
+QImage ImageSource::getCachableTileImage(const uint tileId) const
+{
+    QImage image;
+    if (getMaxLod() == 0) // the image fits in a single tile
+        image = QImage(_uri);
+    else
+    {
+        if (_diskCache)
+            image = _diskCache->load(tileId);
+        if (image.isNull())
+            image = _loadTile(tileId);
+    }
 
     // Make sure image format is 32-bits per pixel as required by the GL texture
-    QImage image(_uri);
-    if (!QtImage::is32Bits(image))
+    if (!image.isNull() && !QtImage::is32Bits(image))
         image = image.convertToFormat(QImage::Format_ARGB32);
 
     return image;
 }
 
-Indices ImageSource::computeVisibleSet(const QRectF& visibleTilesArea,
-                                       const uint lod) const
+QImage ImageSource::_loadTile(const uint tileId) const
 {
-    Q_UNUSED(lod);
+    if (_regionDecode)
+    {
+        auto image = _decodeTile(tileId);
+        if (_diskCache && !image.isNull())
+            _diskCache->save(tileId, image);
+        return image;
+    }
+
+    // Other formats are decoded entirely, by one thread / process at a time
+    const QMutexLocker lock(&_decodeMutex);
 
-    if (visibleTilesArea.isEmpty())
-        return Indices();
+    if (_diskCache && !_diskCacheFailed)
+    {
+        if (auto diskLock = _diskCache->lock())
+        {
+            // The tiles may have been generated while waiting for the lock
+            const auto tile = _diskCache->load(tileId);
+            return tile.isNull() ? _generateTiles(tileId) : tile;
+        }
+    }
 
-    return {0};
+    // Without a disk cache, decode the full image again for each tile rather
+    // than keeping all of them in memory.
+    return _decodeTile(tileId);
 }
 
-uint ImageSource::getMaxLod() const
+QImage ImageSource::_decodeTile(const uint tileId) const
 {
-    return 0;
+    const auto lod = _lodTool.getTileIndex(tileId).lod;
+    const auto tileRect = getTileRect(tileId);
+    const auto clipRect = tileRect & QRect(QPoint(), getTilesArea(lod));
+
+    QImageReader reader(_uri);
+    if (lod > 0)
+    {
+        reader.setScaledSize(getTilesArea(lod));
+        reader.setScaledClipRect(clipRect);
+    }
+    else
+        reader.setClipRect(clipRect);
+
+    auto image = reader.read();
+    if (image.isNull())
+        return image;
+
+    // Border tiles are padded to the tile size, like the generated ones
+    if (image.size() != tileRect.size())
+        image = image.copy(QRect(QPoint(), tileRect.size()));
+    return image;
+}
+
+QImage ImageSource::_generateTiles(const uint tileId) const
+{
+    QImage tile;
+    auto image = QImage(_uri);
+    for (uint lod = 0; lod <= getMaxLod() && !image.isNull(); ++lod)
+    {
+        if (lod > 0)
+            image = image.scaled(getTilesArea(lod), Qt::IgnoreAspectRatio,
+                                 Qt::SmoothTransformation);
+
+        for (const auto& info : _lodTool.getAllTileInfos(lod))
+        {
+            const auto tileImage = image.copy(info.coord);
+            if (info.id == tileId)
+                tile = tileImage;
+            if (!_diskCacheFailed && !_diskCache->save(info.id, tileImage))
+            {
+                put_flog(LOG_WARN, "decoding the tiles of '%s' one by one",
+                         _uri.toLocal8Bit().constData());
+                _diskCacheFailed = true;
+            }
+        }
+    }
+    return tile;
 }
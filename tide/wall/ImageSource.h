@@ -40,16 +40,24 @@
 #ifndef IMAGESOURCE_H
 #define IMAGESOURCE_H
 
-#include "types.h"
+#include "LodTiler.h"
 
-#include "CachedDataSource.h"
+#include <QMutex>
+
+class DiskTileCache;
 
 /**
- * Cached data source for regular images.
+ * A data source for regular images.
  *
- * Used by ImageSynchronizer.
+ * Large images are divided in tiles with multiple levels of detail, so that
+ * each process only loads the tiles that it displays. Formats that support it
+ * (JPEG) are decoded by region and at reduced resolution. Other formats are
+ * decoded entirely once to generate all the tiles. In both cases the tiles
+ * are kept in a DiskTileCache for the next requests. If the DiskTileCache is
+ * disabled or can't store them, the other formats are decoded entirely for
+ * each tile instead.
  */
-class ImageSource : public CachedDataSource
+class ImageSource : public LodTiler
 {
 public:
     /**
@@ -59,24 +67,22 @@ public:
      */
     explicit ImageSource(const QString& uri);
 
-    /** @copydoc DataSource::getTileRect */
-    QRect getTileRect(uint tileIndex) const final;
-
-    /** @copydoc DataSource::getTilesArea */
-    QSize getTilesArea(uint lod) const final;
-
-    /** @copydoc DataSource::computeVisibleSet */
-    Indices computeVisibleSet(const QRectF& visibleTilesArea,
-                              uint lod) const final;
-
-    /** @copydoc DataSource::getMaxLod */
-    uint getMaxLod() const final;
+    /** Destructor. */
+    ~ImageSource();
 
 private:
     const QString _uri;
-    const QSize _imageSize;
+    const bool _regionDecode;
+    std::unique_ptr<DiskTileCache> _diskCache;
+
+    mutable QMutex _decodeMutex; // protects the member below
+    mutable bool _diskCacheFailed = false;
+
+    QImage getCachableTileImage(uint tileId) const final; // threadsafe
 
-    QImage getCachableTileImage(uint tileId) const final;
+    QImage _loadTile(uint tileId) const;
+    QImage _decodeTile(uint tileId) const;
+    QImage _generateTiles(uint tileId) const;
 };
 
 #endif
@@ -39,8 +39,10 @@
 
 #include "LodSynchronizer.h"
 
+#include "CachedDataSource.h"
 #include "DataSource.h"
 #include "Tile.h"
+#include "TileCache.h"
 #include "ZoomHelper.h"
 #include "scene/ContentWindow.h"
 
@@ -53,8 +55,13 @@ LodSynchronizer::LodSynchronizer(std::shared_ptr<DataSource> source)
     _source->synchronizers.push_back(this);
 }
 
+LodSynchronizer::~LodSynchronizer()
+{
+    _source->removeSynchronizer(this);
+}
+
 void LodSynchronizer::update(const ContentWindow& window,
-                             const QRectF& visibleArea)
+                             const QRegion& visibleArea)
 {
     update(window, visibleArea, false, 0);
 }
@@ -66,6 +73,7 @@ void LodSynchronizer::updateTiles()
         _setBackgroundTile(_backgroundTileId);
         TiledSynchronizer::updateTiles();
         _tilesDirty = false;
+        emit statisticsChanged(); // refresh the tile cache statistics
     }
 }
 
@@ -81,6 +89,13 @@ QString LodSynchronizer::getStatistics() const
     stream << "LOD:  " << _lod << "/" << getDataSource().getMaxLod();
     const QSize& area = getTilesArea();
     stream << "  res: " << area.width() << "x" << area.height();
+
+    const auto& cache = CachedDataSource::getTileCache();
+    const auto megabyte = 1024 * 1024;
+    stream << "  cache: " << cache.getSize() / megabyte << "/"
+           << cache.getMaxSize() / megabyte << " MB";
+    stream << "  hits: " << cache.getHits() << " misses: " << cache.getMisses()
+           << " evictions: " << cache.getEvictions();
     return stats;
 }
 
@@ -91,19 +106,18 @@ TilePtr LodSynchronizer::getZoomContextTile() const
 }
 
 void LodSynchronizer::update(const ContentWindow& window,
-                             const QRectF& visibleArea, const bool forceUpdate,
+                             const QRegion& visibleArea, const bool forceUpdate,
                              const int backgroundTileId)
 {
     const ZoomHelper helper(window);
     const auto lod = _getLod(helper.getContentRect().size().toSize());
     const auto tilesSurface = getDataSource().getTilesArea(lod);
-    const auto visibleTilesArea = helper.toTilesArea(visibleArea, tilesSurface);
+    const auto areaChanged =
+        updateVisibleTilesArea(window, visibleArea, tilesSurface);
 
-    if (!forceUpdate && visibleTilesArea == _visibleTilesArea && lod == _lod)
+    if (!forceUpdate && !areaChanged && lod == _lod)
         return;
 
-    _visibleTilesArea = visibleTilesArea;
-
     if (lod != _lod)
     {
         _lod = lod;
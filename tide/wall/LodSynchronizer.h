@@ -54,9 +54,12 @@ public:
     /** Constructor. */
     LodSynchronizer(std::shared_ptr<DataSource> source);
 
+    /** Destructor. */
+    ~LodSynchronizer();
+
     /** @copydoc ContentSynchronizer::update */
     void update(const ContentWindow& window,
-                const QRectF& visibleArea) override;
+                const QRegion& visibleArea) override;
 
     /** @copydoc ContentSynchronizer::updateTiles */
     void updateTiles() override;
@@ -79,7 +82,7 @@ protected:
      * @param forceUpdate the tiles, e.g. if the source has changed (pdf page).
      * @param backgroundTileId to use as background tile to smooth LOD change.
      */
-    void update(const ContentWindow& window, const QRectF& visibleArea,
+    void update(const ContentWindow& window, const QRegion& visibleArea,
                 bool forceUpdate, int backgroundTileId);
 
     /** @copydoc ContentSynchronizer::getDataSource */
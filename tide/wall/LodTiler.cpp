@@ -70,6 +70,11 @@ uint LodTiler::getMaxLod() const
     return _lodTool.getMaxLod();
 }
 
+uint LodTiler::getTileLod(const uint tileId) const
+{
+    return _lodTool.getTileIndex(tileId).lod;
+}
+
 QRectF LodTiler::getNormalizedTileRect(const uint tileId) const
 {
     const QRectF tile(getTileRect(tileId));
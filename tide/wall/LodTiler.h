@@ -75,6 +75,9 @@ protected:
     LodTiler(const QSize& contentSize, uint tileSize);
     LodTiler(std::pair<QSize, uint> args);
 
+    /** @copydoc DataSource::getTileLod */
+    uint getTileLod(uint tileId) const override;
+
     LodTools _lodTool;
 };
 
@@ -0,0 +1,255 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "MovieDecoder.h"
+
+#include "data/FFMPEGMovie.h"
+#include "data/FFMPEGFrame.h"
+
+#include <algorithm>
+
+namespace
+{
+// Same threshold as FFMPEGMovie::getFrame for seeking instead of decoding
+const double MIN_SEEK_DELTA_SEC = 0.5;
+
+MovieDecoder::DecodeFunc _makeDecodeFunc(FFMPEGMovie& movie)
+{
+    return [&movie](const double position, double& decodedPosition) {
+        auto frame = movie.getDecodedFrame(position);
+        decodedPosition = movie.getPosition();
+        return frame;
+    };
+}
+}
+
+MovieDecoder::MovieDecoder(FFMPEGMovie& movie, const size_t queueSize)
+    : MovieDecoder(_makeDecodeFunc(movie), movie.getFrameDuration(),
+                   movie.getDuration(), queueSize)
+{
+}
+
+MovieDecoder::MovieDecoder(DecodeFunc decode, const double frameDuration,
+                           const double duration, const size_t queueSize)
+    : _decode(std::move(decode))
+    , _queueSize(std::max(queueSize, size_t(1)))
+    , _frameDuration(frameDuration)
+    , _duration(duration)
+    , _thread(&MovieDecoder::_run, this)
+{
+}
+
+MovieDecoder::~MovieDecoder()
+{
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _condition.notify_all();
+    _thread.join();
+}
+
+void MovieDecoder::setLoop(const bool loop)
+{
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if (_loop == loop)
+            return;
+        _loop = loop;
+    }
+    _condition.notify_all();
+}
+
+MovieDecoder::Frame MovieDecoder::getFrame(double timestamp)
+{
+    timestamp = std::max(0.0, std::min(timestamp, _duration));
+    const auto tolerance = _frameDuration / 2;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (_needSeek(timestamp))
+        _seek(timestamp);
+
+    Frame frame;
+    while (true)
+    {
+        while (!_queue.empty() && _queue.front().decoded &&
+               _queue.front().position + tolerance < timestamp)
+        {
+            _pop();
+        }
+
+        if (_queue.empty())
+        {
+            // Keep showing the previous frame instead of blocking the caller
+            if (_seekPending && _lastFrame && !frame.loopedBack)
+            {
+                frame.decoded = _lastFrame;
+                frame.position = timestamp;
+                return frame;
+            }
+            _condition.wait(lock, [this] {
+                return _stopping || !_queue.empty() || !_canDecode();
+            });
+            // Nothing will be decoded anymore, don't wait forever
+            if (_queue.empty())
+            {
+                frame.position = _consumedPosition;
+                return frame;
+            }
+            continue;
+        }
+
+        const auto next = _queue.front();
+        if (!next.decoded) // end of movie
+        {
+            // A second end in a row means the movie can't be decoded again
+            if (!_loop || frame.loopedBack)
+            {
+                frame.position = _consumedPosition;
+                return frame;
+            }
+            _pop();
+            frame.loopedBack = true;
+            timestamp = 0.0;
+            continue;
+        }
+
+        _pop();
+        _consumedPosition = next.position;
+        _lastFrame = next.decoded;
+        frame.decoded = next.decoded;
+        frame.position = next.position;
+        return frame;
+    }
+}
+
+size_t MovieDecoder::getQueuedFrames() const
+{
+    const std::lock_guard<std::mutex> lock(_mutex);
+    return _queue.size();
+}
+
+void MovieDecoder::_run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        _condition.wait(lock, [this] { return _stopping || _canDecode(); });
+        if (_stopping)
+            return;
+
+        const auto position = _seekRequested ? _seekPosition : _nextPosition;
+        const auto generation = _generation;
+        _seekRequested = false;
+
+        lock.unlock();
+        auto decodedPosition = position;
+        const auto decoded = _decode(position, decodedPosition);
+        lock.lock();
+
+        if (generation != _generation)
+            continue; // the queue was flushed by a seek while decoding
+
+        _queue.push_back({decoded, decodedPosition});
+        _seekPending = false;
+        if (decoded)
+        {
+            _decodedPosition = decodedPosition;
+            _nextPosition = decodedPosition + _frameDuration;
+            _endOfMovie = false;
+        }
+        else
+        {
+            _endOfMovie = true;
+            _endQueued = true;
+            _nextPosition = 0.0;
+        }
+        _condition.notify_all();
+    }
+}
+
+bool MovieDecoder::_canDecode() const
+{
+    return _seekRequested ||
+           (_queue.size() < _queueSize && (_loop || !_endOfMovie));
+}
+
+bool MovieDecoder::_needSeek(const double timestamp) const
+{
+    const auto tolerance = _frameDuration / 2;
+    if (timestamp + tolerance < _consumedPosition)
+        return true;
+
+    // Once the end is queued, the decoder is already looping back
+    return !_endQueued && timestamp > _decodedPosition + MIN_SEEK_DELTA_SEC;
+}
+
+void MovieDecoder::_seek(const double timestamp)
+{
+    _queue.clear();
+    _seekRequested = true;
+    _seekPending = true;
+    _seekPosition = timestamp;
+    _decodedPosition = timestamp;
+    _consumedPosition = timestamp;
+    _endOfMovie = false;
+    _endQueued = false;
+    ++_generation;
+    _condition.notify_all();
+}
+
+void MovieDecoder::_pop()
+{
+    const bool isEnd = !_queue.front().decoded;
+    _queue.pop_front();
+
+    // Once the end is consumed, decoding can resume even if looping gets
+    // disabled before the beginning of the movie is decoded again
+    if (isEnd)
+    {
+        _endQueued = std::any_of(_queue.begin(), _queue.end(),
+                                 [](const QueuedFrame& frame) {
+                                     return !frame.decoded;
+                                 });
+        _endOfMovie = _endQueued;
+    }
+    _condition.notify_all();
+}
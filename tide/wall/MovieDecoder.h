@@ -0,0 +1,161 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef MOVIEDECODER_H
+#define MOVIEDECODER_H
+
+#include "types.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Decode the frames of a movie ahead of time in a background thread.
+ *
+ * The decoded frames are kept in a bounded queue, in decoding order. They are
+ * not converted, so that the consumer can convert only the regions it needs
+ * using an FFMPEGVideoFrameConverter. The consumer picks the frame for a given
+ * timestamp with getFrame(), which drops the outdated frames and only waits if
+ * the frame has not been decoded yet.
+ * Seeks (backward or too far forward) flush the queue and restart decoding at
+ * the new position; the end of the movie is queued so that looping continues
+ * decoding from the beginning without interruption.
+ */
+class MovieDecoder
+{
+public:
+    /** A frame returned by getFrame(). */
+    struct Frame
+    {
+        FFMPEGFramePtr decoded; // nullptr at the end of a non-looping movie
+        double position = 0.0;
+        bool loopedBack = false;
+    };
+
+    /**
+     * Start decoding a movie.
+     * @param movie the movie to decode, must outlive the decoder and not be
+     *        accessed by other threads.
+     * @param queueSize the maximum number of frames decoded in advance.
+     */
+    MovieDecoder(FFMPEGMovie& movie, size_t queueSize);
+
+    /**
+     * Decode a frame at the given position.
+     * @param position the requested position in seconds.
+     * @param decodedPosition the actual position of the decoded frame.
+     * @return the decoded frame, or nullptr at the end of the movie.
+     */
+    using DecodeFunc =
+        std::function<FFMPEGFramePtr(double position, double& decodedPosition)>;
+
+    /**
+     * Start decoding frames using a custom decoding function.
+     * @param decode the function called from the decoding thread.
+     * @param frameDuration the duration of a frame in seconds.
+     * @param duration the duration of the movie in seconds.
+     * @param queueSize the maximum number of frames decoded in advance.
+     */
+    MovieDecoder(DecodeFunc decode, double frameDuration, double duration,
+                 size_t queueSize);
+
+    /** Stop the decoding thread. */
+    ~MovieDecoder();
+
+    /** Enable or disable looping at the end of the movie. */
+    void setLoop(bool loop);
+
+    /**
+     * Get the first frame at or after the given timestamp.
+     *
+     * Blocks until the frame is decoded if it was not available yet, except
+     * after a seek where the previous frame is returned until the first frame
+     * at the new position is decoded.
+     * @param timestamp the position of the frame in seconds.
+     * @return the frame, or a frame with no decoded data at the end of the
+     *         movie when not looping or if no more frames can be decoded.
+     */
+    Frame getFrame(double timestamp);
+
+    /** @return the number of frames currently decoded in advance. */
+    size_t getQueuedFrames() const;
+
+private:
+    struct QueuedFrame
+    {
+        FFMPEGFramePtr decoded; // nullptr marks the end of the movie
+        double position;
+    };
+
+    const DecodeFunc _decode;
+    const size_t _queueSize;
+    const double _frameDuration;
+    const double _duration;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<QueuedFrame> _queue;
+
+    bool _stopping = false;
+    bool _loop = true;
+    bool _endOfMovie = false;
+    bool _endQueued = false;
+    bool _seekRequested = false;
+    bool _seekPending = false; // until the first frame after a seek
+    double _seekPosition = 0.0;
+    double _nextPosition = 0.0;
+    double _decodedPosition = 0.0;
+    double _consumedPosition = 0.0;
+    uint _generation = 0;
+    FFMPEGFramePtr _lastFrame;
+
+    std::thread _thread;
+
+    void _run();
+    bool _canDecode() const;
+    bool _needSeek(double timestamp) const;
+    void _seek(double timestamp);
+    void _pop();
+};
+
+#endif
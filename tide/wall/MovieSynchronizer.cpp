@@ -41,7 +41,6 @@
 
 #include "MovieUpdater.h"
 #include "Tile.h"
-#include "ZoomHelper.h"
 #include "scene/ContentWindow.h"
 
 MovieSynchronizer::MovieSynchronizer(std::shared_ptr<MovieUpdater> updater,
@@ -56,8 +55,13 @@ MovieSynchronizer::MovieSynchronizer(std::shared_ptr<MovieUpdater> updater,
             &MovieSynchronizer::_onPictureUpdated);
 }
 
+MovieSynchronizer::~MovieSynchronizer()
+{
+    _updater->removeSynchronizer(this);
+}
+
 void MovieSynchronizer::update(const ContentWindow& window,
-                               const QRectF& visibleArea)
+                               const QRegion& visibleArea)
 {
     if (_updater->isSkipping())
         emit sliderPositionChanged();
@@ -65,14 +69,8 @@ void MovieSynchronizer::update(const ContentWindow& window,
     // Tiles area corresponds to Content dimensions for Movies
     const auto tilesSurface = window.getContent()->getDimensions();
 
-    const auto visibleTilesArea =
-        ZoomHelper{window}.toTilesArea(visibleArea, tilesSurface);
-
-    if (_visibleTilesArea == visibleTilesArea)
-        return;
-
-    _visibleTilesArea = visibleTilesArea;
-    _tilesDirty = true;
+    if (updateVisibleTilesArea(window, visibleArea, tilesSurface))
+        _tilesDirty = true;
 }
 
 void MovieSynchronizer::updateTiles()
@@ -105,7 +103,8 @@ QSize MovieSynchronizer::getTilesArea() const
 QString MovieSynchronizer::getStatistics() const
 {
     return QString("%1 / %2").arg(_fpsCounter.toString(),
-                                  _updater->getStatistics());
+                                  _updater->getStatistics()) +
+           getMipmapStatistics();
 }
 
 deflect::View MovieSynchronizer::getView() const
@@ -63,8 +63,11 @@ public:
     MovieSynchronizer(std::shared_ptr<MovieUpdater> updater,
                       deflect::View view);
 
+    /** Destructor. */
+    ~MovieSynchronizer();
+
     /** @copydoc ContentSynchronizer::update */
-    void update(const ContentWindow& window, const QRectF& visibleArea) final;
+    void update(const ContentWindow& window, const QRegion& visibleArea) final;
 
     /** @copydoc ContentSynchronizer::updateTiles */
     void updateTiles() final;
@@ -42,40 +42,22 @@
 #include "data/FFMPEGFrame.h"
 #include "data/FFMPEGMovie.h"
 #include "data/FFMPEGPicture.h"
+#include "data/FFMPEGVideoFrameConverter.h"
 #include "log.h"
 #include "network/WallToWallChannel.h"
 #include "scene/MovieContent.h"
 
+#include <QThread>
+
 #include <cmath>
 
 namespace
 {
-void _splitSideBySide(const FFMPEGPicture& image, PicturePtr& left,
-                      PicturePtr& right)
-{
-    const auto width = image.getWidth() / 2;
-    const auto height = image.getHeight();
-    const auto format = image.getFormat();
+// Decoded frames kept ahead of the shared timestamp (200ms at 30 fps)
+const size_t DECODE_QUEUE_SIZE = 6;
 
-    left = std::make_shared<FFMPEGPicture>(width, height, format);
-    right = std::make_shared<FFMPEGPicture>(width, height, format);
-
-    const uint numTextures = (format == TextureFormat::rgba) ? 1 : 3 /*YUV*/;
-    for (uint texture = 0; texture < numTextures; ++texture)
-    {
-        const auto uvSize = image.getTextureSize(texture);
-        const size_t lineWidth = uvSize.width();
-        const size_t targetWidth = lineWidth / 2;
-        for (size_t y = 0; y < size_t(uvSize.height()); ++y)
-        {
-            const auto input = image.getData(texture) + y * lineWidth;
-            const auto outLeft = left->getData(texture) + y * targetWidth;
-            const auto outRight = right->getData(texture) + y * targetWidth;
-            std::copy(input, input + targetWidth, outLeft);
-            std::copy(input + targetWidth, input + lineWidth, outRight);
-        }
-    }
-}
+// Movies are converted and uploaded in tiles of this size, like pixel streams
+const int MOVIE_TILE_SIZE = 512;
 }
 
 MovieUpdater::MovieUpdater(const QString& uri)
@@ -88,10 +70,14 @@ MovieUpdater::MovieUpdater(const QString& uri)
     if (!_ffmpegMovie->isValid())
         put_flog(LOG_WARN, "Movie is invalid: %s",
                  uri.toLocal8Bit().constData());
+    else
+        _decoder = make_unique<MovieDecoder>(*_ffmpegMovie, DECODE_QUEUE_SIZE);
 }
 
 MovieUpdater::~MovieUpdater()
 {
+    // stop decoding before the movie is destroyed
+    _decoder.reset();
 }
 
 void MovieUpdater::update(const MovieContent& movie)
@@ -100,67 +86,39 @@ void MovieUpdater::update(const MovieContent& movie)
     _loop = movie.getControlState() & STATE_LOOP;
     _skipping = movie.isSkipping();
     _skipPosition = movie.getPosition();
+
+    if (_decoder)
+        _decoder->setLoop(_loop);
 }
 
 QRect MovieUpdater::getTileRect(const uint tileIndex) const
 {
-    Q_UNUSED(tileIndex);
-    return QRect(0, 0, _ffmpegMovie->getWidth(), _ffmpegMovie->getHeight());
+    const auto area = getTilesArea(0);
+    const int x = (tileIndex % _getTilesX()) * MOVIE_TILE_SIZE;
+    const int y = (tileIndex / _getTilesX()) * MOVIE_TILE_SIZE;
+    return QRect(x, y, std::min(MOVIE_TILE_SIZE, area.width() - x),
+                 std::min(MOVIE_TILE_SIZE, area.height() - y));
 }
 
 QSize MovieUpdater::getTilesArea(const uint lod) const
 {
     Q_UNUSED(lod);
-    return getTileRect(0).size();
+    return QSize(_ffmpegMovie->getWidth(), _ffmpegMovie->getHeight());
 }
 
 ImagePtr MovieUpdater::getTileImage(const uint tileIndex,
                                     const deflect::View view) const
 {
-    Q_UNUSED(tileIndex);
-
-    // WAR bug: concurrent calls to this function may occur when the movie was
-    // obstruced by another window and becomes visible again, resulting in a
-    // segfault in: FFMPEGMovie::getFrame() ->
-    // FFMPEGVideoStream::decodePictureForLastPacket() -> sws_scale().
-    const QMutexLocker lockGetImage(&_getImageMutex);
+    const auto frame = _getCurrentFrame();
+    if (!frame)
+        return ImagePtr();
 
-    if (_ffmpegMovie->isStereo() && _pictureLeftOrMono && _pictureRight)
-    {
-        return view == deflect::View::right_eye ? _pictureRight
-                                                : _pictureLeftOrMono;
-    }
-    else if (_pictureLeftOrMono)
-        return _pictureLeftOrMono;
+    auto region = getTileRect(tileIndex);
+    // The right eye is the right half of side-by-side stereo frames
+    if (_ffmpegMovie->isStereo() && view == deflect::View::right_eye)
+        region.translate(_ffmpegMovie->getWidth(), 0);
 
-    double timestamp;
-    {
-        const QMutexLocker lock(&_mutex);
-        timestamp = _sharedTimestamp;
-    }
-
-    auto image = _ffmpegMovie->getFrame(timestamp);
-
-    const bool loopBack = _loop && !image;
-    if (loopBack)
-        image = _ffmpegMovie->getFrame(0.0);
-
-    {
-        const QMutexLocker lock(&_mutex);
-        _currentPosition = _ffmpegMovie->getPosition();
-        // stay inSync for start != 0.0 and loop conditions
-        _sharedTimestamp = _currentPosition;
-        // WAR a risk of deadlock when skipping movies with incorrect duration
-        _loopedBack = loopBack;
-    }
-    if (_ffmpegMovie->isStereo())
-    {
-        _splitSideBySide(*image, _pictureLeftOrMono, _pictureRight);
-        return view == deflect::View::right_eye ? _pictureRight
-                                                : _pictureLeftOrMono;
-    }
-    _pictureLeftOrMono = image;
-    return image;
+    return _getConverter()->convert(frame, _ffmpegMovie->getFormat(), region);
 }
 
 Indices MovieUpdater::computeVisibleSet(const QRectF& visibleTilesArea,
@@ -168,10 +126,23 @@ Indices MovieUpdater::computeVisibleSet(const QRectF& visibleTilesArea,
 {
     Q_UNUSED(lod);
 
-    if (visibleTilesArea.isEmpty())
+    const auto area = getTilesArea(0);
+    const auto visibleArea =
+        visibleTilesArea.intersected(QRectF(QPointF(), area));
+    if (visibleArea.isEmpty())
         return Indices();
 
-    return {0};
+    const auto tileSize = qreal(MOVIE_TILE_SIZE);
+    const uint firstX = std::floor(visibleArea.left() / tileSize);
+    const uint firstY = std::floor(visibleArea.top() / tileSize);
+    const uint lastX = std::ceil(visibleArea.right() / tileSize) - 1;
+    const uint lastY = std::ceil(visibleArea.bottom() / tileSize) - 1;
+
+    Indices visibleSet;
+    for (uint y = firstY; y <= lastY; ++y)
+        for (uint x = firstX; x <= lastX; ++x)
+            visibleSet.insert(y * _getTilesX() + x);
+    return visibleSet;
 }
 
 uint MovieUpdater::getMaxLod() const
@@ -189,7 +160,9 @@ QString MovieUpdater::getStatistics() const
     const auto frameDuration = _ffmpegMovie->getFrameDuration();
     const auto fps = QString::number(1.0 / frameDuration, 'g', 3);
     const auto progress = QString::number(getPosition() * 100.0, 'g', 3);
-    return QString("%2 fps %3 %").arg(fps, progress);
+    const auto queued = _decoder ? _decoder->getQueuedFrames() : 0;
+    return QString("%2 fps %3 % (%4 decoded ahead)")
+        .arg(fps, progress, QString::number(queued));
 }
 
 qreal MovieUpdater::getPosition() const
@@ -283,11 +256,74 @@ void MovieUpdater::synchronizeFrameAdvance(WallToWallChannel& channel)
 void MovieUpdater::_triggerFrameUpdate()
 {
     _readyForNextFrame = false;
-    _pictureLeftOrMono.reset();
-    _pictureRight.reset();
+    _currentFrame.reset();
     emit pictureUpdated();
 }
 
+FFMPEGFramePtr MovieUpdater::_getCurrentFrame() const
+{
+    // All the tiles of all the views show the same frame, only the first
+    // call for a new frame gets it from the decoder.
+    const QMutexLocker lockGetImage(&_getImageMutex);
+
+    if (_currentFrame || !_decoder)
+        return _currentFrame;
+
+    double timestamp;
+    {
+        const QMutexLocker lock(&_mutex);
+        timestamp = _sharedTimestamp;
+    }
+
+    // Usually decoded in advance, the previous frame is kept while seeking
+    const auto frame = _decoder->getFrame(timestamp);
+    {
+        const QMutexLocker lock(&_mutex);
+        _currentPosition = frame.position;
+        // stay inSync for start != 0.0 and loop conditions
+        _sharedTimestamp = _currentPosition;
+        // WAR a risk of deadlock when skipping movies with incorrect duration
+        _loopedBack = frame.loopedBack;
+    }
+    _currentFrame = frame.decoded;
+    return _currentFrame;
+}
+
+MovieUpdater::ConverterPtr MovieUpdater::_getConverter() const
+{
+    // sws contexts are not threadsafe, each converter is used by one loading
+    // thread at a time and returned to the idle converters afterwards.
+    std::unique_ptr<FFMPEGVideoFrameConverter> converter;
+    {
+        const QMutexLocker lock(&_convertersMutex);
+        if (!_idleConverters.empty())
+        {
+            converter = std::move(_idleConverters.back());
+            _idleConverters.pop_back();
+        }
+    }
+    if (!converter)
+        converter = make_unique<FFMPEGVideoFrameConverter>();
+
+    return ConverterPtr(converter.release(),
+                        [this](FFMPEGVideoFrameConverter* released) {
+                            _releaseConverter(released);
+                        });
+}
+
+void MovieUpdater::_releaseConverter(FFMPEGVideoFrameConverter* released) const
+{
+    std::unique_ptr<FFMPEGVideoFrameConverter> converter{released};
+    const QMutexLocker lock(&_convertersMutex);
+    if (_idleConverters.size() < size_t(QThread::idealThreadCount()))
+        _idleConverters.push_back(std::move(converter));
+}
+
+uint MovieUpdater::_getTilesX() const
+{
+    return std::ceil(float(_ffmpegMovie->getWidth()) / MOVIE_TILE_SIZE);
+}
+
 void MovieUpdater::_exchangeSharedTimestamp(WallToWallChannel& channel,
                                             const bool isCandidate)
 {
@@ -43,16 +43,20 @@
 #include "DataSource.h"
 #include "ElapsedTimer.h"
 #include "FpsCounter.h"
+#include "MovieDecoder.h"
 #include "MovieSynchronizer.h"
 #include "types.h"
 
 #include <QMutex>
 
+#include <vector>
+
 /**
  * Updates Movies synchronously across different processes.
  *
  * A single movie is designed to provide images to multiple windows on each
- * process.
+ * process. Movies are split in tiles so that each process only converts and
+ * uploads the regions of the frames that are visible on its screens.
  */
 class MovieUpdater : public QObject, public DataSource
 {
@@ -117,6 +121,7 @@ signals:
 
 private:
     std::unique_ptr<FFMPEGMovie> _ffmpegMovie;
+    std::unique_ptr<MovieDecoder> _decoder;
 
     bool _paused = false;
     bool _loop = true;
@@ -133,12 +138,21 @@ private:
     mutable double _currentPosition = -1.0;
     mutable bool _loopedBack = false;
 
-    mutable PicturePtr _pictureLeftOrMono;
-    mutable PicturePtr _pictureRight;
-
+    mutable FFMPEGFramePtr _currentFrame;
     mutable QMutex _getImageMutex;
 
+    mutable std::vector<std::unique_ptr<FFMPEGVideoFrameConverter>>
+        _idleConverters;
+    mutable QMutex _convertersMutex;
+
     void _triggerFrameUpdate();
+    FFMPEGFramePtr _getCurrentFrame() const;
+    using ConverterPtr =
+        std::unique_ptr<FFMPEGVideoFrameConverter,
+                        std::function<void(FFMPEGVideoFrameConverter*)>>;
+    ConverterPtr _getConverter() const;
+    void _releaseConverter(FFMPEGVideoFrameConverter* converter) const;
+    uint _getTilesX() const;
     void _exchangeSharedTimestamp(WallToWallChannel& channel, bool isCandidate);
 };
 
@@ -50,7 +50,7 @@ PDFSynchronizer::PDFSynchronizer(std::shared_ptr<PDFTiler> source)
 }
 
 void PDFSynchronizer::update(const ContentWindow& window,
-                             const QRectF& visibleArea)
+                             const QRegion& visibleArea)
 {
     LodSynchronizer::update(window, visibleArea, _pageChanged,
                             _source->getPreviewTileId());
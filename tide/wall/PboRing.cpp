@@ -0,0 +1,400 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "PboRing.h"
+
+#include "FrameTracer.h"
+#include "StagedImage.h"
+#include "log.h"
+#include "textureUtils.h"
+
+#include <QElapsedTimer>
+#include <QOpenGLBuffer>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+
+#include <algorithm>
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace
+{
+const GLbitfield mapFlags =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+uint _getPlaneCount(const TextureFormat format)
+{
+    return format == TextureFormat::rgba ? 1 : 3;
+}
+
+bool _supportsPersistentMapping(const QOpenGLContext& context)
+{
+    const auto version = context.format().version();
+    return (version >= qMakePair(4, 4) ||
+            context.hasExtension("GL_ARB_buffer_storage")) &&
+           (version >= qMakePair(3, 2) || context.hasExtension("GL_ARB_sync"));
+}
+}
+
+/**
+ * GL entry points that are not exposed by QOpenGLFunctions in Qt 5.
+ */
+struct PboRing::GLSyncFunctions
+{
+    using BufferStorage = void(QOPENGLF_APIENTRYP)(GLenum, GLsizeiptr,
+                                                   const void*, GLbitfield);
+    using FenceSync = GLsync(QOPENGLF_APIENTRYP)(GLenum, GLbitfield);
+    using ClientWaitSync = GLenum(QOPENGLF_APIENTRYP)(GLsync, GLbitfield,
+                                                      GLuint64);
+    using DeleteSync = void(QOPENGLF_APIENTRYP)(GLsync);
+
+    BufferStorage bufferStorage = nullptr;
+    FenceSync fenceSync = nullptr;
+    ClientWaitSync clientWaitSync = nullptr;
+    DeleteSync deleteSync = nullptr;
+
+    static std::unique_ptr<GLSyncFunctions> resolve(QOpenGLContext& context)
+    {
+        if (!_supportsPersistentMapping(context))
+            return nullptr;
+
+        auto gl = make_unique<GLSyncFunctions>();
+        gl->bufferStorage = reinterpret_cast<BufferStorage>(
+            context.getProcAddress("glBufferStorage"));
+        gl->fenceSync =
+            reinterpret_cast<FenceSync>(context.getProcAddress("glFenceSync"));
+        gl->clientWaitSync = reinterpret_cast<ClientWaitSync>(
+            context.getProcAddress("glClientWaitSync"));
+        gl->deleteSync = reinterpret_cast<DeleteSync>(
+            context.getProcAddress("glDeleteSync"));
+
+        if (!gl->bufferStorage || !gl->fenceSync || !gl->clientWaitSync ||
+            !gl->deleteSync)
+        {
+            return nullptr;
+        }
+        return gl;
+    }
+
+    bool isSignaled(void* fence) const
+    {
+        const auto status =
+            clientWaitSync(static_cast<GLsync>(fence), 0, 0 /*timeout*/);
+        return status == GL_ALREADY_SIGNALED ||
+               status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED;
+    }
+
+    void wait(void* fence) const
+    {
+        while (clientWaitSync(static_cast<GLsync>(fence),
+                              GL_SYNC_FLUSH_COMMANDS_BIT,
+                              1000000 /*ns*/) == GL_TIMEOUT_EXPIRED)
+        {
+        }
+    }
+};
+
+PboRing::Slot::Slot(std::shared_ptr<PboRing> ring, const uint first,
+                    const uint count, const size_t size)
+    : _ring{std::move(ring)}
+    , _first{first}
+    , _count{count}
+    , _size{size}
+{
+}
+
+PboRing::Slot::~Slot()
+{
+    _ring->_free(*this);
+}
+
+size_t PboRing::Slot::getOffset() const
+{
+    return _first * _ring->_blockSize;
+}
+
+PboRing::PboRing(const uint blockCount, const size_t blockSize)
+    : _blockCount{blockCount}
+    , _blockSize{blockSize}
+    , _blocks(blockCount, BlockState::free)
+{
+}
+
+PboRing::~PboRing() = default;
+
+bool PboRing::init()
+{
+    QWriteLocker lock(&_mappingLock);
+
+    if (_context) // only try once
+        return _mapped != nullptr;
+
+    _context = QOpenGLContext::currentContext();
+    if (!_context)
+        return false;
+
+    _gl = GLSyncFunctions::resolve(*_context);
+    if (!_gl)
+    {
+        put_flog(LOG_INFO,
+                 "persistent buffer mapping not supported, using regular "
+                 "texture uploads");
+        return false;
+    }
+
+    const size_t size = _blockCount * _blockSize;
+    _buffer = make_unique<QOpenGLBuffer>(QOpenGLBuffer::PixelUnpackBuffer);
+    _buffer->create();
+    _buffer->bind();
+    _gl->bufferStorage(GL_PIXEL_UNPACK_BUFFER, size, nullptr, mapFlags);
+    const auto access = QOpenGLBuffer::RangeAccessFlags(QFlag(int(mapFlags)));
+    _mapped = static_cast<uint8_t*>(_buffer->mapRange(0, int(size), access));
+    _buffer->release();
+
+    if (!_mapped)
+    {
+        put_flog(LOG_WARN, "could not map %lu bytes for texture uploads",
+                 (unsigned long)size);
+        _buffer.reset();
+        return false;
+    }
+    return true;
+}
+
+bool PboRing::isInitialized() const
+{
+    QReadLocker lock(&_mappingLock);
+    return _mapped != nullptr;
+}
+
+void PboRing::release()
+{
+    QWriteLocker lock(&_mappingLock);
+
+    if (!_mapped)
+        return;
+
+    _mapped = nullptr;
+    if (QOpenGLContext::currentContext() != _context)
+    {
+        put_flog(LOG_WARN, "PBO ring released without its GL context");
+        return;
+    }
+
+    for (const auto& pending : _pendingCopies)
+    {
+        _gl->wait(pending.fence);
+        _gl->deleteSync(static_cast<GLsync>(pending.fence));
+    }
+
+    QMutexLocker blocksLock(&_mutex);
+    for (const auto& pending : _pendingCopies)
+        _setState(pending.first, pending.count, BlockState::free);
+    _pendingCopies.clear();
+
+    _buffer->bind();
+    _buffer->unmap();
+    _buffer->release();
+    _buffer.reset();
+}
+
+void PboRing::recycle()
+{
+    if (!_gl)
+        return;
+
+    // Copies are fenced in order, so they also complete in order
+    while (!_pendingCopies.empty() &&
+           _gl->isSignaled(_pendingCopies.front().fence))
+    {
+        const auto pending = _pendingCopies.front();
+        _pendingCopies.pop_front();
+        _gl->deleteSync(static_cast<GLsync>(pending.fence));
+
+        QMutexLocker lock(&_mutex);
+        _setState(pending.first, pending.count, BlockState::free);
+    }
+}
+
+void PboRing::copy(Slot& slot, QSGTexture& texture, const uint glTexFormat)
+{
+    if (!_buffer)
+        return;
+
+    {
+        QMutexLocker lock(&_mutex);
+        if (slot._consumed)
+            throw std::logic_error("PBO ring slot already copied");
+        slot._consumed = true;
+        _setState(slot._first, slot._count, BlockState::inFlight);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    textureUtils::copy(*_buffer, texture, glTexFormat, slot.getOffset());
+    auto fence = _gl->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _pendingCopies.push_back({fence, slot._first, slot._count});
+
+    addUpload(slot.getSize(), timer.nsecsElapsed());
+    ++_stagedCount;
+}
+
+ImagePtr PboRing::stage(ImagePtr image)
+{
+    if (!image || image->isGpuImage())
+        return image;
+
+    const FrameTracer::Scope trace(TraceStage::pboCopy);
+    const auto planes = _getPlaneCount(image->getFormat());
+    std::vector<SlotPtr> slots;
+    slots.reserve(planes);
+    for (uint i = 0; i < planes; ++i)
+    {
+        auto slot = _write(*image, i);
+        if (!slot)
+            return image; // already reserved slots are freed by ~Slot
+        slots.push_back(std::move(slot));
+    }
+    return std::make_shared<StagedImage>(image, std::move(slots));
+}
+
+PboRing::SlotPtr PboRing::getSlot(const Image& image,
+                                  const uint texture) const
+{
+    const auto staged = dynamic_cast<const StagedImage*>(&image);
+    if (!staged || !isInitialized())
+        return SlotPtr();
+
+    auto slot = staged->getSlot(texture);
+    return slot && slot->_ring.get() == this ? slot : SlotPtr();
+}
+
+void PboRing::addUpload(const size_t bytes, const qint64 nsecs)
+{
+    _uploadedBytes += bytes;
+    _uploadTime += nsecs;
+}
+
+size_t PboRing::getUploadedBytes() const
+{
+    return _uploadedBytes;
+}
+
+qint64 PboRing::getUploadTime() const
+{
+    return _uploadTime;
+}
+
+size_t PboRing::getStagedCount() const
+{
+    return _stagedCount;
+}
+
+void PboRing::resetCounters()
+{
+    _uploadedBytes = 0;
+    _uploadTime = 0;
+    _stagedCount = 0;
+}
+
+PboRing::SlotPtr PboRing::_write(const Image& image, const uint texture)
+{
+    QReadLocker lock(&_mappingLock);
+
+    const auto size = image.getDataSize(texture);
+    if (!_mapped || !image.getData(texture) || size == 0)
+        return SlotPtr();
+
+    const uint count = (size + _blockSize - 1) / _blockSize;
+    uint first = 0;
+    {
+        QMutexLocker blocksLock(&_mutex);
+        if (!_reserve(count, first))
+            return SlotPtr();
+    }
+
+    textureUtils::copyPixels(image, texture, _mapped + first * _blockSize);
+    return SlotPtr{new Slot{shared_from_this(), first, count, size}};
+}
+
+bool PboRing::_reserve(const uint count, uint& first)
+{
+    if (count > _blockCount)
+        return false;
+
+    for (uint i = 0; i < _blockCount; ++i)
+    {
+        const auto start = (_next + i) % _blockCount;
+        if (start + count > _blockCount)
+            continue;
+
+        const auto begin = _blocks.begin() + start;
+        const auto end = begin + count;
+        if (std::all_of(begin, end, [](const BlockState state) {
+                return state == BlockState::free;
+            }))
+        {
+            _setState(start, count, BlockState::reserved);
+            _next = (start + count) % _blockCount;
+            first = start;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PboRing::_setState(const uint first, const uint count,
+                        const BlockState state)
+{
+    std::fill(_blocks.begin() + first, _blocks.begin() + first + count, state);
+}
+
+void PboRing::_free(const Slot& slot)
+{
+    QMutexLocker lock(&_mutex);
+    if (!slot._consumed)
+        _setState(slot._first, slot._count, BlockState::free);
+}
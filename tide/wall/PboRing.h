@@ -0,0 +1,217 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef PBORING_H
+#define PBORING_H
+
+#include "types.h"
+
+#include <QMutex>
+#include <QReadWriteLock>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+class QOpenGLBuffer;
+class QOpenGLContext;
+class QSGTexture;
+
+/**
+ * A ring of persistently mapped pixel buffers for asynchronous texture upload.
+ *
+ * A single GL buffer is allocated with glBufferStorage and mapped once for the
+ * lifetime of the ring. It is divided into fixed-size blocks; images are
+ * staged into contiguous blocks directly by the threads which produce them, so
+ * that the render thread only has to issue glTexSubImage2D from the buffer.
+ * Each copy is followed by a fence, and the blocks are recycled once the GPU
+ * has signaled that it is done reading them.
+ *
+ * Methods documented as "render thread" must be called with the window's GL
+ * context current; all the others are thread-safe. If persistent mapping is
+ * not supported by the GL implementation, the ring stays uninitialized and
+ * stage() returns images unchanged so that callers fall back to the regular
+ * PBO path.
+ */
+class PboRing : public std::enable_shared_from_this<PboRing>
+{
+public:
+    /** A contiguous range of blocks reserved in the ring for one plane. */
+    class Slot
+    {
+    public:
+        ~Slot();
+
+        /** @return the offset of the slot in the ring buffer, in bytes. */
+        size_t getOffset() const;
+
+        /** @return the number of bytes written to the slot. */
+        size_t getSize() const { return _size; }
+
+    private:
+        friend class PboRing;
+
+        Slot(std::shared_ptr<PboRing> ring, uint first, uint count,
+             size_t size);
+
+        std::shared_ptr<PboRing> _ring;
+        const uint _first;
+        const uint _count;
+        const size_t _size;
+        bool _consumed = false; // protected by PboRing::_mutex
+    };
+    using SlotPtr = std::shared_ptr<Slot>;
+
+    /**
+     * Create an uninitialized ring.
+     * @param blockCount the number of blocks in the ring.
+     * @param blockSize the size of each block in bytes.
+     */
+    PboRing(uint blockCount, size_t blockSize);
+    ~PboRing();
+
+    /**
+     * Allocate and map the buffer (render thread).
+     * @return true if the ring is usable, false if the GL implementation does
+     *         not support persistent mapping.
+     */
+    bool init();
+
+    /** @return true if the ring has been successfully initialized. */
+    bool isInitialized() const;
+
+    /** Wait for pending copies, unmap and delete the buffer (render thread). */
+    void release();
+
+    /** Free the blocks of all copies completed by the GPU (render thread). */
+    void recycle();
+
+    /**
+     * Copy a slot to a texture and insert a fence behind it (render thread).
+     *
+     * The slot is consumed and can not be copied again.
+     * @param slot the source slot.
+     * @param texture the target texture, of the size of the staged plane.
+     * @param glTexFormat the GL pixel format of the staged plane.
+     */
+    void copy(Slot& slot, QSGTexture& texture, uint glTexFormat);
+
+    /**
+     * Stage all planes of an image into the ring.
+     *
+     * @param image the image to stage.
+     * @return a StagedImage if there was enough space in the ring, otherwise
+     *         the original image.
+     */
+    ImagePtr stage(ImagePtr image);
+
+    /**
+     * Get the slot of an image plane staged in this ring.
+     *
+     * @param image the image to upload.
+     * @param texture the texture plane.
+     * @return the slot, or nullptr if the image was not staged in this ring or
+     *         if the ring has been released.
+     */
+    SlotPtr getSlot(const Image& image, uint texture) const;
+
+    /**
+     * Record an upload done outside of the ring (render thread).
+     * @param bytes the number of bytes uploaded.
+     * @param nsecs the time spent on the render thread.
+     */
+    void addUpload(size_t bytes, qint64 nsecs);
+
+    /** @return the number of bytes uploaded since the last reset. */
+    size_t getUploadedBytes() const;
+
+    /** @return the render thread upload time since the last reset [ns]. */
+    qint64 getUploadTime() const;
+
+    /** @return the number of planes copied from the ring since last reset. */
+    size_t getStagedCount() const;
+
+    /** Reset the upload counters. */
+    void resetCounters();
+
+private:
+    enum class BlockState
+    {
+        free,
+        reserved,
+        inFlight
+    };
+
+    struct Copy
+    {
+        void* fence;
+        uint first;
+        uint count;
+    };
+
+    struct GLSyncFunctions;
+
+    const uint _blockCount;
+    const size_t _blockSize;
+
+    std::unique_ptr<QOpenGLBuffer> _buffer;
+    std::unique_ptr<GLSyncFunctions> _gl;
+    QOpenGLContext* _context = nullptr;
+    uint8_t* _mapped = nullptr;
+    mutable QReadWriteLock _mappingLock;
+
+    std::vector<BlockState> _blocks;
+    uint _next = 0;
+    mutable QMutex _mutex;
+
+    std::deque<Copy> _pendingCopies;
+
+    std::atomic<size_t> _uploadedBytes{0};
+    std::atomic<qint64> _uploadTime{0};
+    std::atomic<size_t> _stagedCount{0};
+
+    SlotPtr _write(const Image& image, uint texture);
+    bool _reserve(uint count, uint& first);
+    void _setState(uint first, uint count, BlockState state);
+    void _free(const Slot& slot);
+};
+
+#endif
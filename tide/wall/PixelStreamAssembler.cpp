@@ -41,14 +41,16 @@
 
 #include "StreamImage.h"
 #include "log.h"
+#include "scene/PixelStreamContent.h"
 
 #include <deflect/SegmentDecoder.h>
 
+#include <algorithm>
 #include <cmath> //std::ceil
 
 namespace
 {
-const uint32_t targetTileSize = 512;
+const uint32_t targetTileSize = PixelStreamContent::getAssembledTileSize();
 
 bool _isValidSize(const uint32_t size)
 {
@@ -101,12 +103,22 @@ Indices PixelStreamAssembler::computeVisibleSet(
     const QRectF& visibleTilesArea) const
 {
     Indices visibleSet;
-    const auto tilesCount = _getTilesX() * _getTilesY();
-    for (uint tileIndex = 0; tileIndex < tilesCount; ++tileIndex)
-    {
-        if (visibleTilesArea.intersects(getTileRect(tileIndex)))
-            visibleSet.insert(tileIndex);
-    }
+    const auto frameArea = QRectF{QPointF(), _frameSize};
+    const auto area = visibleTilesArea.intersected(frameArea);
+    if (area.isEmpty())
+        return visibleSet;
+
+    // Target tiles form a regular grid, only visit the ones in the area
+    const qreal size = targetTileSize;
+    const uint left = std::floor(area.left() / size);
+    const uint top = std::floor(area.top() / size);
+    const uint right = std::min(uint(std::ceil(area.right() / size)),
+                                _getTilesX());
+    const uint bottom = std::min(uint(std::ceil(area.bottom() / size)),
+                                 _getTilesY());
+    for (uint y = top; y < bottom; ++y)
+        for (uint x = left; x < right; ++x)
+            visibleSet.insert(y * _getTilesX() + x);
     return visibleSet;
 }
 
@@ -212,12 +224,8 @@ void PixelStreamAssembler::_decodeSourceTiles(const Indices& indices,
     {
         auto& segment = _frame->segments.at(i);
 
-        if (segment.parameters.dataType == deflect::DataType::jpeg)
-#ifndef DEFLECT_USE_LEGACY_LIBJPEGTURBO
-            decoder.decodeToYUV(segment);
-#else
-            decoder.decode(segment);
-#endif
+        if (!segment.imageData.isEmpty())
+            decode(segment, decoder);
     }
 }
 
@@ -228,14 +236,32 @@ void PixelStreamAssembler::_assembleTargetTile(const uint tileIndex,
     if (!target.imageData.isEmpty())
         return;
 
-    const auto type = _frame->segments[*indices.begin()].parameters.dataType;
+    // Segments outside of the visible area are not sent by the master
+    Indices received;
+    for (auto i : indices)
+    {
+        if (!_frame->segments[i].imageData.isEmpty())
+            received.insert(i);
+    }
+    if (received.empty())
+    {
+        makeBlank(_assembledFrame, tileIndex, getDecodedType());
+        return;
+    }
+
+    const auto type = _frame->segments[*received.begin()].parameters.dataType;
 
     StreamImage image{_assembledFrame, tileIndex};
-    target.parameters.dataType = type;
-    const auto dataSize =
-        image.getDataSize(0) + image.getDataSize(1) + image.getDataSize(2);
-    target.imageData.resize(dataSize);
-    for (auto i : indices)
+    if (received.size() == indices.size())
+    {
+        target.parameters.dataType = type;
+        const auto dataSize =
+            image.getDataSize(0) + image.getDataSize(1) + image.getDataSize(2);
+        target.imageData.resize(dataSize);
+    }
+    else
+        makeBlank(_assembledFrame, tileIndex, type);
+    for (auto i : received)
     {
         const auto tile = StreamImage{_frame, (uint)i};
         image.copy(tile, tile.getPosition() - image.getPosition());
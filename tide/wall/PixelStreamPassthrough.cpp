@@ -44,23 +44,30 @@
 #include <deflect/Frame.h>
 #include <deflect/SegmentDecoder.h>
 
-PixelStreamPassthrough::PixelStreamPassthrough(deflect::FramePtr frame)
+PixelStreamPassthrough::PixelStreamPassthrough(
+    deflect::FramePtr frame, std::shared_ptr<const TileGrid> grid)
     : _frame(frame)
 {
+    std::vector<QRect> segments;
+    segments.reserve(_frame->segments.size());
+    for (const auto& segment : _frame->segments)
+        segments.push_back(toRect(segment.parameters));
+
+    // Streams rarely change their segmentation, rebuild only when they do
+    if (grid && grid->getTiles() == segments)
+        _grid = std::move(grid);
+    else
+        _grid = std::make_shared<TileGrid>(std::move(segments));
 }
 
 ImagePtr PixelStreamPassthrough::getTileImage(const uint tileIndex,
                                               deflect::SegmentDecoder& decoder)
 {
     auto& segment = _frame->segments.at(tileIndex);
-    if (segment.parameters.dataType == deflect::DataType::jpeg)
-    {
-#ifndef DEFLECT_USE_LEGACY_LIBJPEGTURBO
-        decoder.decodeToYUV(segment);
-#else
-        decoder.decode(segment);
-#endif
-    }
+    if (segment.imageData.isEmpty())
+        makeBlank(_frame, tileIndex, getDecodedType());
+    else
+        decode(segment, decoder);
     return std::make_shared<StreamImage>(_frame, tileIndex);
 }
 
@@ -72,12 +79,10 @@ QRect PixelStreamPassthrough::getTileRect(const uint tileIndex) const
 Indices PixelStreamPassthrough::computeVisibleSet(
     const QRectF& visibleTilesArea) const
 {
-    Indices visibleSet;
-    for (size_t i = 0; i < _frame->segments.size(); ++i)
-    {
-        const auto segmentRect = toRect(_frame->segments[i].parameters);
-        if (visibleTilesArea.intersects(segmentRect))
-            visibleSet.insert(i);
-    }
-    return visibleSet;
+    return _grid->computeVisibleSet(visibleTilesArea);
+}
+
+std::shared_ptr<const TileGrid> PixelStreamPassthrough::getTileGrid() const
+{
+    return _grid;
 }
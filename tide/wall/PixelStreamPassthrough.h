@@ -42,6 +42,8 @@
 
 #include "PixelStreamProcessor.h"
 
+#include "TileGrid.h"
+
 /**
  * Pass tiles without modification for rendering.
  */
@@ -51,8 +53,11 @@ public:
     /**
      * Construct a processor that does not modify the pixel stream.
      * @param frame to decode and expose.
+     * @param grid index of a previous frame, reused if its segments have the
+     *        same layout.
      */
-    PixelStreamPassthrough(deflect::FramePtr frame);
+    PixelStreamPassthrough(deflect::FramePtr frame,
+                           std::shared_ptr<const TileGrid> grid = nullptr);
 
     /** @copydoc PixelStreamProcessor::getTileImage */
     ImagePtr getTileImage(uint tileIndex,
@@ -64,8 +69,12 @@ public:
     /** @copydoc PixelStreamProcessor::computeVisibleSet */
     Indices computeVisibleSet(const QRectF& visibleTilesArea) const final;
 
+    /** @return the index of the segments, to reuse for the next frame. */
+    std::shared_ptr<const TileGrid> getTileGrid() const;
+
 private:
     deflect::FramePtr _frame;
+    std::shared_ptr<const TileGrid> _grid;
 };
 
 #endif
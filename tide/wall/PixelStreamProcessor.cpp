@@ -39,7 +39,18 @@
 
 #include "PixelStreamProcessor.h"
 
-#include <deflect/SegmentParameters.h>
+#include "StreamImage.h"
+
+#include <deflect/Frame.h>
+#include <deflect/SegmentDecoder.h>
+
+#include <algorithm>
+
+namespace
+{
+// Neutral chroma, zero would render black YUV pixels as green
+const char yuvBlackChroma = char(128);
+}
 
 PixelStreamProcessor::~PixelStreamProcessor()
 {
@@ -50,3 +61,37 @@ QRect PixelStreamProcessor::toRect(
 {
     return QRect(params.x, params.y, params.width, params.height);
 }
+
+void PixelStreamProcessor::decode(deflect::Segment& segment,
+                                  deflect::SegmentDecoder& decoder)
+{
+    if (segment.parameters.dataType == deflect::DataType::jpeg)
+    {
+#ifndef DEFLECT_USE_LEGACY_LIBJPEGTURBO
+        decoder.decodeToYUV(segment);
+#else
+        decoder.decode(segment);
+#endif
+    }
+    _decodedType = segment.parameters.dataType;
+}
+
+deflect::DataType PixelStreamProcessor::getDecodedType() const
+{
+    return _decodedType;
+}
+
+void PixelStreamProcessor::makeBlank(deflect::FramePtr frame,
+                                     const uint tileIndex,
+                                     const deflect::DataType type) const
+{
+    auto& segment = frame->segments.at(tileIndex);
+    segment.parameters.dataType = type;
+
+    const StreamImage image{frame, tileIndex};
+    const auto ySize = image.getDataSize(0);
+    const auto uvSize = image.getDataSize(1) + image.getDataSize(2);
+    segment.imageData.fill(0, ySize + uvSize);
+    std::fill(segment.imageData.begin() + ySize, segment.imageData.end(),
+              yuvBlackChroma);
+}
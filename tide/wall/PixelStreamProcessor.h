@@ -42,6 +42,10 @@
 
 #include "types.h"
 
+#include <deflect/SegmentParameters.h>
+
+#include <atomic>
+
 /**
  * Abstract class for processing pixel stream frames before rendering.
  */
@@ -71,6 +75,31 @@ public:
 protected:
     /** @return the coordinates of the segment as a QRect. */
     QRect toRect(const deflect::SegmentParameters& params) const;
+
+    /**
+     * Decode a jpeg segment in place, to YUV if supported.
+     *
+     * The resulting format is kept for the blank tiles, see getDecodedType().
+     * @throw std::runtime_error on segment decoding error.
+     */
+    void decode(deflect::Segment& segment, deflect::SegmentDecoder& decoder);
+
+    /**
+     * @return the format of the last decoded segment, to render the blank
+     *         tiles with the same texture format as the others.
+     */
+    deflect::DataType getDecodedType() const;
+
+    /**
+     * Replace the data of a tile that was not sent to this process by the
+     * master (outside of the visible area) with a blank image: black for the
+     * YUV formats, transparent for rgba.
+     */
+    void makeBlank(deflect::FramePtr frame, uint tileIndex,
+                   deflect::DataType type) const;
+
+private:
+    std::atomic<deflect::DataType> _decodedType{deflect::DataType::rgba};
 };
 
 #endif
@@ -41,7 +41,6 @@
 
 #include "PixelStreamUpdater.h"
 #include "Tile.h"
-#include "ZoomHelper.h"
 #include "scene/ContentWindow.h"
 
 PixelStreamSynchronizer::PixelStreamSynchronizer(
@@ -56,20 +55,19 @@ PixelStreamSynchronizer::PixelStreamSynchronizer(
             &PixelStreamSynchronizer::_onPictureUpdated);
 }
 
+PixelStreamSynchronizer::~PixelStreamSynchronizer()
+{
+    _updater->removeSynchronizer(this);
+}
+
 void PixelStreamSynchronizer::update(const ContentWindow& window,
-                                     const QRectF& visibleArea)
+                                     const QRegion& visibleArea)
 {
     // Tiles area corresponds to Content dimensions for PixelStreams
     const auto tilesSurface = window.getContent()->getDimensions();
 
-    const auto visibleTilesArea =
-        ZoomHelper{window}.toTilesArea(visibleArea, tilesSurface);
-
-    if (_visibleTilesArea == visibleTilesArea)
-        return;
-
-    _visibleTilesArea = visibleTilesArea;
-    _tilesDirty = true;
+    if (updateVisibleTilesArea(window, visibleArea, tilesSurface))
+        _tilesDirty = true;
 }
 
 void PixelStreamSynchronizer::updateTiles()
@@ -100,7 +98,7 @@ QSize PixelStreamSynchronizer::getTilesArea() const
 
 QString PixelStreamSynchronizer::getStatistics() const
 {
-    return _fpsCounter.toString() + " fps";
+    return _fpsCounter.toString() + " fps" + getMipmapStatistics();
 }
 
 deflect::View PixelStreamSynchronizer::getView() const
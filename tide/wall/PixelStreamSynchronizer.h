@@ -63,9 +63,12 @@ public:
     PixelStreamSynchronizer(std::shared_ptr<PixelStreamUpdater> updater,
                             deflect::View view);
 
+    /** Destructor. */
+    ~PixelStreamSynchronizer();
+
     /** @copydoc ContentSynchronizer::update */
     void update(const ContentWindow& window,
-                const QRectF& visibleArea) override;
+                const QRegion& visibleArea) override;
 
     /** @copydoc ContentSynchronizer::updateTiles */
     void updateTiles() final;
@@ -39,11 +39,12 @@
 
 #include "PixelStreamUpdater.h"
 
+#include "FrameSync.h"
+#include "FrameTracer.h"
 #include "PixelStreamAssembler.h"
 #include "PixelStreamPassthrough.h"
 #include "StreamImage.h"
 #include "log.h"
-#include "network/WallToWallChannel.h"
 
 #include <deflect/Frame.h>
 #include <deflect/SegmentDecoder.h>
@@ -87,14 +88,14 @@ PixelStreamUpdater::~PixelStreamUpdater()
 {
 }
 
-void PixelStreamUpdater::synchronizeFrameAdvance(WallToWallChannel& channel)
+void PixelStreamUpdater::synchronizeFrameAdvance(FrameSync& frameSync)
 {
-    if (!_readyToSwap)
-        return;
-
-    const auto versionCheckFunc = std::bind(&WallToWallChannel::checkVersion,
-                                            &channel, std::placeholders::_1);
-    _swapSyncFrame.sync(versionCheckFunc);
+    frameSync.addVersion(_swapSyncFrame.getVersion(), [this](const bool same) {
+        // Evaluated after the swap of the tiles registered before, which
+        // may have allowed to advance to the next frame.
+        if (_readyToSwap)
+            _swapSyncFrame.sync([same](const uint64_t) { return same; });
+    });
 }
 
 QRect PixelStreamUpdater::getTileRect(const uint tileIndex) const
@@ -131,6 +132,7 @@ ImagePtr PixelStreamUpdater::getTileImage(const uint tileIndex,
     static QThreadStorage<deflect::SegmentDecoder> segmentDecoders;
     try
     {
+        const FrameTracer::Scope trace(TraceStage::decode);
         return processor->getTileImage(tileIndex, segmentDecoders.localData());
     }
     catch (const std::runtime_error& e)
@@ -204,7 +206,10 @@ void PixelStreamUpdater::_createFrameProcessors()
     }
     catch (const std::runtime_error&)
     {
-        _processorLeft.reset(new PixelStreamPassthrough(_frameLeftOrMono));
-        _processRight.reset(new PixelStreamPassthrough(_frameRight));
+        auto left = new PixelStreamPassthrough(_frameLeftOrMono, _segmentGrid);
+        _segmentGrid = left->getTileGrid();
+        _processorLeft.reset(left);
+        _processRight.reset(
+            new PixelStreamPassthrough(_frameRight, _segmentGrid));
     }
 }
@@ -49,6 +49,7 @@
 #include <QReadWriteLock>
 
 class PixelStreamProcessor;
+class TileGrid;
 
 /**
  * Synchronize the update of PixelStreams and send new frame requests.
@@ -86,8 +87,12 @@ public:
     /** @copydoc DataSource::getMaxLod */
     uint getMaxLod() const final;
 
-    /** Synchronize the advance to the next frame of the stream. */
-    void synchronizeFrameAdvance(WallToWallChannel& channel);
+    /**
+     * Synchronize the advance to the next frame of the stream.
+     * @param frameSync where to register the synchronization, to be
+     *        resolved after the one of the tiles swap.
+     */
+    void synchronizeFrameAdvance(FrameSync& frameSync);
 
     /** Allow advancing to the next frame of the stream (flow control). */
     void getNextFrame();
@@ -110,6 +115,7 @@ private:
     std::unique_ptr<deflect::SegmentDecoder> _headerDecoder;
     std::unique_ptr<PixelStreamProcessor> _processorLeft;
     std::unique_ptr<PixelStreamProcessor> _processRight;
+    std::shared_ptr<const TileGrid> _segmentGrid;
     mutable QReadWriteLock _frameMutex;
     bool _readyToSwap = true;
 
@@ -98,8 +98,17 @@ QmlWindowRenderer::~QmlWindowRenderer()
 }
 
 void QmlWindowRenderer::update(ContentWindowPtr contentWindow,
-                               const QRectF& visibleArea)
+                               const QRegion& visibleArea)
 {
+    // Unchanged windows are shared between successive DisplayGroups
+    if (_updated && contentWindow == _contentWindow &&
+        visibleArea == _visibleArea)
+    {
+        return;
+    }
+    _updated = true;
+    _visibleArea = visibleArea;
+
     if (contentWindow->getVersion() != _contentWindow->getVersion())
     {
         _windowContext->setContextProperty("contentwindow",
@@ -45,6 +45,7 @@
 #include <QQmlContext>
 #include <QQmlEngine>
 #include <QQuickItem>
+#include <QRegion>
 
 /**
  * Provide a Qml representation of a ContentWindow on the Wall.
@@ -62,8 +63,12 @@ public:
     /** Destructor. */
     ~QmlWindowRenderer();
 
-    /** Update the qml object with a new data model. */
-    void update(ContentWindowPtr contentWindow, const QRectF& visibleArea);
+    /**
+     * Update the qml object with a new data model.
+     *
+     * Does nothing if both the window and its visible area are unchanged.
+     */
+    void update(ContentWindowPtr contentWindow, const QRegion& visibleArea);
 
     /** Get the QML item. */
     QQuickItem* getQuickItem();
@@ -71,6 +76,8 @@ public:
 private:
     ContentSynchronizerSharedPtr _synchronizer;
     ContentWindowPtr _contentWindow;
+    QRegion _visibleArea;
+    bool _updated = false;
     std::unique_ptr<QQmlContext> _windowContext;
     std::unique_ptr<QQuickItem> _windowItem;
 
@@ -41,11 +41,15 @@
 
 #include "DataProvider.h"
 #include "DisplayGroupRenderer.h"
+#include "FrameSync.h"
+#include "FrameTracer.h"
 #include "InactivityTimer.h"
 #include "ScreenLock.h"
 #include "WallWindow.h"
+#include "log.h"
 #include "network/WallToWallChannel.h"
 #include "scene/DisplayGroup.h"
+#include "scene/DisplayGroupPatch.h"
 #include "scene/Options.h"
 
 RenderController::RenderController(std::vector<WallWindow*> windows,
@@ -135,9 +139,14 @@ void RenderController::requestRender()
 
 void RenderController::_syncAndRender()
 {
-    auto versionCheckFunc = std::bind(&WallToWallChannel::checkVersion,
-                                      &_wallChannel, std::placeholders::_1);
-    _syncQuit.sync(versionCheckFunc);
+    {
+        const FrameTracer::Scope trace(TraceStage::sync);
+        FrameSync frameSync;
+        _syncQuit.sync(frameSync);
+        _synchronizeObjects(frameSync);
+        _wallChannel.synchronize(frameSync);
+    }
+
     if (_syncQuit.get())
     {
         killTimer(_renderTimer);
@@ -147,8 +156,6 @@ void RenderController::_syncAndRender()
         return;
     }
 
-    _synchronizeObjects(versionCheckFunc);
-
     const bool grab = _syncScreenshot.get();
     if (grab)
         _syncScreenshot = SwapSyncObject<bool>{false};
@@ -166,6 +173,8 @@ void RenderController::_syncAndRender()
 
 bool RenderController::_syncAndRenderWindows(const bool grab)
 {
+    const FrameTracer::Scope trace(TraceStage::render);
+
     _wallChannel.synchronizeClock();
 
     _provider.synchronizeTilesSwap(_wallChannel);
@@ -181,9 +190,29 @@ bool RenderController::_syncAndRenderWindows(const bool grab)
     return _wallChannel.allReady(!_needRedraw);
 }
 
-void RenderController::updateDisplayGroup(DisplayGroupPtr displayGroup)
+void RenderController::updateDisplayGroup(DisplayGroupPatchPtr patch)
 {
-    _syncDisplayGroup.update(displayGroup);
+    if (_waitingForSnapshot && !patch->isSnapshot())
+        return;
+
+    const auto isNext = patch->getSequence() == _displayGroupSequence + 1;
+    auto group = patch->isSnapshot() || isNext
+                     ? patch->apply(_replicatedGroup.get())
+                     : DisplayGroupPtr();
+    if (!group)
+    {
+        put_flog(LOG_WARN, "DisplayGroup update %lu could not be applied, "
+                           "requesting a snapshot",
+                 (unsigned long)patch->getSequence());
+        _waitingForSnapshot = true;
+        emit requestDisplayGroupSnapshot();
+        return;
+    }
+
+    _waitingForSnapshot = false;
+    _displayGroupSequence = patch->getSequence();
+    _replicatedGroup = group;
+    _syncDisplayGroup.update(group);
     requestRender();
 }
 
@@ -223,12 +252,12 @@ void RenderController::updateQuit()
     requestRender();
 }
 
-void RenderController::_synchronizeObjects(const SyncFunction& versionCheckFunc)
+void RenderController::_synchronizeObjects(FrameSync& frameSync)
 {
-    _syncScreenshot.sync(versionCheckFunc);
-    _syncDisplayGroup.sync(versionCheckFunc);
-    _syncMarkers.sync(versionCheckFunc);
-    _syncOptions.sync(versionCheckFunc);
-    _syncInactivityTimer.sync(versionCheckFunc);
-    _syncLock.sync(versionCheckFunc);
+    _syncScreenshot.sync(frameSync);
+    _syncDisplayGroup.sync(frameSync);
+    _syncMarkers.sync(frameSync);
+    _syncOptions.sync(frameSync);
+    _syncInactivityTimer.sync(frameSync);
+    _syncLock.sync(frameSync);
 }
@@ -63,7 +63,7 @@ public:
 public slots:
     void requestRender();
 
-    void updateDisplayGroup(DisplayGroupPtr displayGroup);
+    void updateDisplayGroup(DisplayGroupPatchPtr patch);
     void updateInactivityTimer(InactivityTimerPtr timer);
     void updateLock(ScreenLockPtr lock);
     void updateMarkers(MarkersPtr markers);
@@ -74,12 +74,19 @@ public slots:
 signals:
     void screenshotRendered(QImage image, QPoint index);
 
+    /** Emitted when a DisplayGroup update could not be applied. */
+    void requestDisplayGroupSnapshot();
+
 private:
     std::vector<WallWindow*> _windows; // deleteLater from syncQuit
     DataProvider& _provider;
     WallToWallChannel& _wallChannel;
     std::unique_ptr<SwapSynchronizer> _swapSynchronizer;
 
+    DisplayGroupPtr _replicatedGroup;
+    uint64_t _displayGroupSequence = 0;
+    bool _waitingForSnapshot = false;
+
     SwapSyncObject<DisplayGroupPtr> _syncDisplayGroup;
     SwapSyncObject<InactivityTimerPtr> _syncInactivityTimer;
     SwapSyncObject<ScreenLockPtr> _syncLock;
@@ -100,7 +107,7 @@ private:
     /** Update and synchronize scene objects before rendering a frame. */
     void _syncAndRender();
     bool _syncAndRenderWindows(bool grab);
-    void _synchronizeObjects(const SyncFunction& versionCheckFunc);
+    void _synchronizeObjects(FrameSync& frameSync);
 };
 
 #endif
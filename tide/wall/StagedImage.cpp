@@ -1,6 +1,6 @@
 /*********************************************************************/
-/* Copyright (c) 2015-2017, EPFL/Blue Brain Project                  */
-/*                          Raphael Dumusc <raphael.dumusc@epfl.ch>  */
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
 /* All rights reserved.                                              */
 /*                                                                   */
 /* Redistribution and use in source and binary forms, with or        */
@@ -37,76 +37,56 @@
 /* or implied, of Ecole polytechnique federale de Lausanne.          */
 /*********************************************************************/
 
-#include "BasicSynchronizer.h"
 
-#include "DataSource.h"
-#include "Tile.h"
+#include "StagedImage.h"
 
-BasicSynchronizer::BasicSynchronizer(std::shared_ptr<DataSource> source)
-    : _dataSource(std::move(source))
+StagedImage::StagedImage(ImagePtr image, std::vector<PboRing::SlotPtr>&& slots)
+    : _image{std::move(image)}
+    , _slots{std::move(slots)}
 {
-    _dataSource->synchronizers.push_back(this);
 }
 
-void BasicSynchronizer::update(const ContentWindow& /*window*/,
-                               const QRectF& visibleArea)
+PboRing::SlotPtr StagedImage::getSlot(const uint texture) const
 {
-    if (!_tileAdded && !visibleArea.isEmpty())
-        _addTile = true;
+    return texture < _slots.size() ? _slots[texture] : PboRing::SlotPtr();
 }
 
-void BasicSynchronizer::updateTiles()
+int StagedImage::getWidth() const
 {
-    if (_addTile)
-        _createTile();
+    return _image->getWidth();
 }
 
-bool BasicSynchronizer::canSwapTiles() const
+int StagedImage::getHeight() const
 {
-    return false;
+    return _image->getHeight();
 }
 
-void BasicSynchronizer::swapTiles()
+QSize StagedImage::getTextureSize(const uint texture) const
 {
-    // Swap not synchronized, done directly in onSwapReady()
+    return _image->getTextureSize(texture);
 }
 
-QSize BasicSynchronizer::getTilesArea() const
+const uint8_t* StagedImage::getData(const uint texture) const
 {
-    return getDataSource().getTilesArea(0);
+    return _image->getData(texture);
 }
 
-QString BasicSynchronizer::getStatistics() const
+size_t StagedImage::getDataSize(const uint texture) const
 {
-    QString stats;
-    QTextStream stream(&stats);
-    const auto area = getTilesArea();
-    stream << "  res: " << area.width() << "x" << area.height();
-    return stats;
+    return _image->getDataSize(texture);
 }
 
-void BasicSynchronizer::onSwapReady(TilePtr tile)
+int StagedImage::getLineSize(const uint texture) const
 {
-    tile->swapImage();
+    return _image->getLineSize(texture);
 }
 
-TilePtr BasicSynchronizer::getZoomContextTile() const
+TextureFormat StagedImage::getFormat() const
 {
-    return Tile::create(0, getDataSource().getTileRect(0));
+    return _image->getFormat();
 }
 
-void BasicSynchronizer::_createTile()
+uint StagedImage::getGLPixelFormat() const
 {
-    if (_tileAdded)
-        return;
-
-    _tileAdded = true;
-    _addTile = false;
-    emit addTile(Tile::create(0, QRect(QPoint(), getTilesArea())));
-    emit tilesAreaChanged();
-}
-
-const DataSource& BasicSynchronizer::getDataSource() const
-{
-    return *_dataSource;
+    return _image->getGLPixelFormat();
 }
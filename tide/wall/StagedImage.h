@@ -0,0 +1,80 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef STAGEDIMAGE_H
+#define STAGEDIMAGE_H
+
+#include "PboRing.h"
+#include "data/Image.h"
+
+/**
+ * An image whose planes have been staged in a PboRing.
+ *
+ * It forwards all properties to the original image, which is kept alive so
+ * that the regular upload path can still be used if the ring is released.
+ */
+class StagedImage : public Image
+{
+public:
+    /**
+     * Create a staged image.
+     * @param image the original image.
+     * @param slots the ring slots holding each texture plane of the image.
+     */
+    StagedImage(ImagePtr image, std::vector<PboRing::SlotPtr>&& slots);
+
+    /** @return the ring slot holding the given texture plane. */
+    PboRing::SlotPtr getSlot(uint texture) const;
+
+    int getWidth() const final;
+    int getHeight() const final;
+    QSize getTextureSize(uint texture) const final;
+    const uint8_t* getData(uint texture) const final;
+    size_t getDataSize(uint texture) const final;
+    int getLineSize(uint texture) const final;
+    TextureFormat getFormat() const final;
+    uint getGLPixelFormat() const final;
+
+private:
+    ImagePtr _image;
+    std::vector<PboRing::SlotPtr> _slots;
+};
+
+#endif
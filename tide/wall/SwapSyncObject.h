@@ -40,6 +40,8 @@
 #ifndef SWAPSYNCOBJECT_H
 #define SWAPSYNCOBJECT_H
 
+#include "FrameSync.h"
+
 #include <functional>
 
 /** Function to be used to synchronize the swapping. */
@@ -95,6 +97,21 @@ public:
         return false;
     }
 
+    /**
+     * Register the synchronization of the object in a FrameSync.
+     *
+     * The object is swapped when the frameSync is resolved.
+     */
+    void sync(FrameSync& frameSync)
+    {
+        frameSync.addVersion(_version, [this](const bool sameVersion) {
+            sync([sameVersion](const uint64_t) { return sameVersion; });
+        });
+    }
+
+    /** @return the version of the back object. */
+    uint64_t getVersion() const { return _version; }
+
     /** Set an optional function to call after swapping. */
     void setCallback(const SyncCallbackFunction& callback)
     {
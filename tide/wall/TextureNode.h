@@ -61,6 +61,20 @@ public:
 
     /** Swap the PBOs and update the texture with the back PBO's contents. */
     virtual void swap() = 0;
+
+    /**
+     * Enable or disable mipmaps.
+     *
+     * When enabled, mipmaps of the front texture are generated immediately and
+     * then after each swap(). Dynamic textures have them disabled by default.
+     */
+    virtual void setMipmaps(bool enabled) = 0;
+
+    /**
+     * @return the number of texels swapped without generating mipmaps since
+     *         the previous call.
+     */
+    virtual size_t takeSkippedMipmapTexels() = 0;
 };
 
 #endif
@@ -49,20 +49,22 @@ std::unique_ptr<TextureNode> TextureNodeFactoryImpl::create(
     switch (format)
     {
     case TextureFormat::rgba:
-        return make_unique<TextureNodeRGBA>(_window, dynamic);
+        return make_unique<TextureNodeRGBA>(_window, dynamic, _pboRing);
     case TextureFormat::yuv444:
     case TextureFormat::yuv422:
     case TextureFormat::yuv420:
-        return make_unique<TextureNodeYUV>(_window, dynamic);
+        return make_unique<TextureNodeYUV>(_window, dynamic, _pboRing);
     default:
         throw std::runtime_error("unsupported texture format");
     }
 }
 
 TextureNodeFactoryImpl::TextureNodeFactoryImpl(QQuickWindow& window,
-                                               const TextureType type)
+                                               const TextureType type,
+                                               PboRing* pboRing)
     : _window{window}
     , _type{type}
+    , _pboRing{pboRing}
 {
 }
 
@@ -42,6 +42,7 @@
 
 #include "TextureNode.h"
 
+class PboRing;
 class QQuickWindow;
 
 /**
@@ -69,13 +70,15 @@ public:
 class TextureNodeFactoryImpl : public TextureNodeFactory
 {
 public:
-    TextureNodeFactoryImpl(QQuickWindow& _window, TextureType _type);
+    TextureNodeFactoryImpl(QQuickWindow& _window, TextureType _type,
+                           PboRing* pboRing = nullptr);
     std::unique_ptr<TextureNode> create(TextureFormat format) final;
     bool needToChangeNodeType(TextureFormat a, TextureFormat b) const final;
 
 private:
     QQuickWindow& _window;
     TextureType _type = TextureType::Static;
+    PboRing* _pboRing = nullptr;
 };
 
 #endif
@@ -42,17 +42,21 @@
 #include "data/Image.h"
 #include "textureUtils.h"
 
+#include <QElapsedTimer>
 #include <QQuickWindow>
 
-TextureNodeRGBA::TextureNodeRGBA(QQuickWindow& window, const bool dynamic)
+TextureNodeRGBA::TextureNodeRGBA(QQuickWindow& window, const bool dynamic,
+                                 PboRing* pboRing)
     : _window(window)
     , _dynamicTexture(dynamic)
     , _texture(window.createTextureFromId(0, QSize(1, 1)))
+    , _pboRing(pboRing)
+    , _mipmaps(!dynamic)
 {
     if (_texture) // needed for null texture in unit tests without a scene graph
         setTexture(_texture.get());
     setFiltering(QSGTexture::Linear);
-    setMipmapFiltering(QSGTexture::Linear);
+    setMipmapFiltering(_mipmaps ? QSGTexture::Linear : QSGTexture::None);
 }
 
 void TextureNodeRGBA::setMipmapFiltering(const QSGTexture::Filtering filtering_)
@@ -69,10 +73,18 @@ void TextureNodeRGBA::uploadTexture(const Image& image)
     if (!image.getTextureSize().isValid())
         throw std::runtime_error("image texture has invalid size");
 
-    if (!_pbo)
-        _pbo = textureUtils::createPbo(_dynamicTexture);
+    _nextSlot = _pboRing ? _pboRing->getSlot(image, 0) : nullptr;
+    if (!_nextSlot)
+    {
+        if (!_pbo)
+            _pbo = textureUtils::createPbo(_dynamicTexture);
 
-    textureUtils::upload(image, 0, *_pbo);
+        QElapsedTimer timer;
+        timer.start();
+        textureUtils::upload(image, 0, *_pbo);
+        if (_pboRing)
+            _pboRing->addUpload(image.getDataSize(0), timer.nsecsElapsed());
+    }
 
     _nextTextureSize = image.getTextureSize();
     _glImageFormat = image.getGLPixelFormat();
@@ -83,10 +95,50 @@ void TextureNodeRGBA::swap()
     if (_texture->textureSize() != _nextTextureSize)
         _texture = textureUtils::createTextureRgba(_nextTextureSize, _window);
 
-    textureUtils::copy(*_pbo, *_texture, _glImageFormat);
+    if (_nextSlot)
+    {
+        _pboRing->copy(*_nextSlot, *_texture, _glImageFormat);
+        _nextSlot.reset();
+    }
+    else
+    {
+        QElapsedTimer timer;
+        timer.start();
+        textureUtils::copy(*_pbo, *_texture, _glImageFormat);
+        if (_pboRing)
+            _pboRing->addUpload(0, timer.nsecsElapsed());
+    }
+
+    if (_mipmaps)
+        textureUtils::generateMipmaps(*_texture);
+    else
+        _skippedMipmapTexels += _nextTextureSize.width() *
+                                _nextTextureSize.height();
+
     setTexture(_texture.get());
     markDirty(DirtyMaterial);
 
     if (!_dynamicTexture)
         _pbo.reset();
 }
+
+void TextureNodeRGBA::setMipmaps(const bool enabled)
+{
+    if (_mipmaps == enabled)
+        return;
+
+    _mipmaps = enabled;
+    // The front texture was last updated without mipmaps
+    if (_mipmaps && _texture && _texture->textureId() != 0)
+        textureUtils::generateMipmaps(*_texture);
+
+    setMipmapFiltering(_mipmaps ? QSGTexture::Linear : QSGTexture::None);
+    markDirty(DirtyMaterial);
+}
+
+size_t TextureNodeRGBA::takeSkippedMipmapTexels()
+{
+    const auto texels = _skippedMipmapTexels;
+    _skippedMipmapTexels = 0;
+    return texels;
+}
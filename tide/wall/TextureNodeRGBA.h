@@ -40,6 +40,7 @@
 #ifndef TEXTURENODERGBA_H
 #define TEXTURENODERGBA_H
 
+#include "PboRing.h"
 #include "TextureNode.h"
 
 #include <QOpenGLBuffer>
@@ -59,6 +60,9 @@ class QQuickWindow;
  * * In the dynamic case, two PBOs are used for real-time texture updates.
  * * In the static case, a single PBO is used for the initial texture upload and
  *   then released in the first call to swap() so that no memory is wasted.
+ *
+ * Images already staged in the window's PboRing are copied from the ring
+ * instead, skipping the upload to the node's own PBO.
  */
 class TextureNodeRGBA : public QSGSimpleTextureNode, public TextureNode
 {
@@ -67,8 +71,10 @@ public:
      * Create a textured rectangle for rendering RGBA images on the GPU.
      * @param window a reference to the quick window for generating textures.
      * @param dynamic true if the texture is going to be updated more than once.
+     * @param pboRing optional ring of staging buffers of the window.
      */
-    TextureNodeRGBA(QQuickWindow& window, bool dynamic);
+    TextureNodeRGBA(QQuickWindow& window, bool dynamic,
+                    PboRing* pboRing = nullptr);
 
     /** @sa QSGOpaqueTextureMaterial::setMipmapFiltering */
     void setMipmapFiltering(QSGTexture::Filtering filtering);
@@ -77,6 +83,8 @@ public:
     void setCoord(const QRectF& coord) final { setRect(coord); }
     void uploadTexture(const Image& image) final;
     void swap() final;
+    void setMipmaps(bool enabled) final;
+    size_t takeSkippedMipmapTexels() final;
 
 private:
     QQuickWindow& _window;
@@ -84,9 +92,14 @@ private:
 
     std::unique_ptr<QSGTexture> _texture;
     std::unique_ptr<QOpenGLBuffer> _pbo;
+    PboRing* _pboRing = nullptr;
+    PboRing::SlotPtr _nextSlot;
 
     QSize _nextTextureSize;
     uint _glImageFormat = 0;
+
+    bool _mipmaps = true;
+    size_t _skippedMipmapTexels = 0;
 };
 
 #endif
@@ -43,6 +43,7 @@
 #include "textureUtils.h"
 #include "yuv.h"
 
+#include <QElapsedTimer>
 #include <QOpenGLBuffer>
 #include <QOpenGLContext>
 #include <QOpenGLFunctions>
@@ -159,9 +160,12 @@ const YUVState* _getMaterialState(const QSGGeometryNode& node)
     return static_cast<const YUVShaderMaterial*>(node.material())->state();
 }
 
-TextureNodeYUV::TextureNodeYUV(QQuickWindow& window, const bool dynamic)
+TextureNodeYUV::TextureNodeYUV(QQuickWindow& window, const bool dynamic,
+                               PboRing* pboRing)
     : _window(window)
     , _dynamicTexture(dynamic)
+    , _pboRing(pboRing)
+    , _mipmaps(!dynamic)
 {
     // Set up geometry, actual vertices will be initialized in updatePaintNode
     const auto& attr = QSGGeometry::defaultAttributes_TexturedPoint2D();
@@ -202,11 +206,22 @@ void TextureNodeYUV::uploadTexture(const Image& image)
     if (image.getGLPixelFormat() != GL_RED)
         throw std::runtime_error("TextureNodeYUV image format must be GL_RED");
 
-    auto state = _getMaterialState(_node);
-    if (!state->pboY)
-        _createPbos();
-
-    _uploadToPbos(image);
+    if (!_getStagedSlots(image))
+    {
+        auto state = _getMaterialState(_node);
+        if (!state->pboY)
+            _createPbos();
+
+        QElapsedTimer timer;
+        timer.start();
+        _uploadToPbos(image);
+        if (_pboRing)
+        {
+            const auto bytes = image.getDataSize(0) + image.getDataSize(1) +
+                               image.getDataSize(2);
+            _pboRing->addUpload(bytes, timer.nsecsElapsed());
+        }
+    }
 
     _nextTextureSize = image.getTextureSize();
     _nextFormat = image.getFormat();
@@ -217,13 +232,50 @@ void TextureNodeYUV::swap()
     if (_needTextureChange())
         _createTextures(_nextTextureSize, _nextFormat);
 
-    _copyPbosToTextures();
+    if (_nextSlots[0])
+        _copySlotsToTextures();
+    else
+    {
+        QElapsedTimer timer;
+        timer.start();
+        _copyPbosToTextures();
+        if (_pboRing)
+            _pboRing->addUpload(0, timer.nsecsElapsed());
+    }
+    _updateMipmaps();
     markDirty(DirtyMaterial);
 
     if (!_dynamicTexture)
         _deletePbos();
 }
 
+void TextureNodeYUV::setMipmaps(const bool enabled)
+{
+    if (_mipmaps == enabled)
+        return;
+
+    _mipmaps = enabled;
+
+    auto state = _getMaterialState(_node);
+    const auto filtering = _mipmaps ? QSGTexture::Linear : QSGTexture::None;
+    for (auto texture : {state->textureY.get(), state->textureU.get(),
+                         state->textureV.get()})
+    {
+        // The front textures were last updated without mipmaps
+        if (_mipmaps && texture->textureId() != 0)
+            textureUtils::generateMipmaps(*texture);
+        texture->setMipmapFiltering(filtering);
+    }
+    markDirty(DirtyMaterial);
+}
+
+size_t TextureNodeYUV::takeSkippedMipmapTexels()
+{
+    const auto texels = _skippedMipmapTexels;
+    _skippedMipmapTexels = 0;
+    return texels;
+}
+
 bool TextureNodeYUV::_needTextureChange() const
 {
     auto state = _getMaterialState(_node);
@@ -247,7 +299,8 @@ std::unique_ptr<QSGTexture> TextureNodeYUV::_createTexture(
 {
     auto texture = textureUtils::createTexture(size, _window);
     texture->setFiltering(QSGTexture::Linear);
-    texture->setMipmapFiltering(QSGTexture::Linear);
+    texture->setMipmapFiltering(_mipmaps ? QSGTexture::Linear
+                                         : QSGTexture::None);
     return texture;
 }
 
@@ -282,3 +335,40 @@ void TextureNodeYUV::_copyPbosToTextures()
     textureUtils::copy(*state->pboU, *state->textureU, GL_RED);
     textureUtils::copy(*state->pboV, *state->textureV, GL_RED);
 }
+
+bool TextureNodeYUV::_getStagedSlots(const Image& image)
+{
+    for (uint i = 0; i < _nextSlots.size(); ++i)
+        _nextSlots[i] = _pboRing ? _pboRing->getSlot(image, i) : nullptr;
+
+    if (_nextSlots[0] && _nextSlots[1] && _nextSlots[2])
+        return true;
+
+    _nextSlots.fill(nullptr);
+    return false;
+}
+
+void TextureNodeYUV::_copySlotsToTextures()
+{
+    auto state = _getMaterialState(_node);
+    _pboRing->copy(*_nextSlots[0], *state->textureY, GL_RED);
+    _pboRing->copy(*_nextSlots[1], *state->textureU, GL_RED);
+    _pboRing->copy(*_nextSlots[2], *state->textureV, GL_RED);
+    _nextSlots.fill(nullptr);
+}
+
+void TextureNodeYUV::_updateMipmaps()
+{
+    auto state = _getMaterialState(_node);
+    for (auto texture : {state->textureY.get(), state->textureU.get(),
+                         state->textureV.get()})
+    {
+        if (_mipmaps)
+            textureUtils::generateMipmaps(*texture);
+        else
+        {
+            const auto size = texture->textureSize();
+            _skippedMipmapTexels += size.width() * size.height();
+        }
+    }
+}
@@ -40,9 +40,11 @@
 #ifndef TEXTURENODEYUV_H
 #define TEXTURENODEYUV_H
 
+#include "PboRing.h"
 #include "TextureNode.h"
 
 #include <QSGNode>
+#include <array>
 
 class QQuickWindow;
 class QSGTexture;
@@ -58,6 +60,9 @@ class QSGTexture;
  * * In the dynamic case, two PBOs are used for real-time texture updates.
  * * In the static case, a single PBO is used for the initial texture upload and
  *   then released in the first call to swap() so that no memory is wasted.
+ *
+ * Images already staged in the window's PboRing are copied from the ring
+ * instead, skipping the upload to the node's own PBOs.
  */
 class TextureNodeYUV : public QSGNode, public TextureNode
 {
@@ -66,13 +71,17 @@ public:
      * Create a textured rectangle for rendering YUV images on the GPU.
      * @param window a reference to the quick window for generating textures.
      * @param dynamic true if the texture is going to be updated more than once.
+     * @param pboRing optional ring of staging buffers of the window.
      */
-    TextureNodeYUV(QQuickWindow& window, bool dynamic);
+    TextureNodeYUV(QQuickWindow& window, bool dynamic,
+                   PboRing* pboRing = nullptr);
 
     QRectF getCoord() const final;
     void setCoord(const QRectF& rect) final;
     void uploadTexture(const Image& image) final;
     void swap() final;
+    void setMipmaps(bool enabled) final;
+    size_t takeSkippedMipmapTexels() final;
 
 private:
     QQuickWindow& _window;
@@ -81,9 +90,15 @@ private:
     QRectF _rect;
     QSGGeometryNode _node;
 
+    PboRing* _pboRing = nullptr;
+    std::array<PboRing::SlotPtr, 3> _nextSlots;
+
     QSize _nextTextureSize;
     TextureFormat _nextFormat;
 
+    bool _mipmaps = true;
+    size_t _skippedMipmapTexels = 0;
+
     bool _needTextureChange() const;
     void _createTextures(const QSize& size, TextureFormat format);
     std::unique_ptr<QSGTexture> _createTexture(const QSize& size) const;
@@ -91,6 +106,9 @@ private:
     void _deletePbos();
     void _uploadToPbos(const Image& image);
     void _copyPbosToTextures();
+    bool _getStagedSlots(const Image& image);
+    void _copySlotsToTextures();
+    void _updateMipmaps();
     void _swapPbos();
 };
 
@@ -39,8 +39,11 @@
 
 #include "Tile.h"
 
+#include "PboRing.h"
 #include "TextureNodeFactory.h"
+#include "WallWindow.h"
 #include "log.h"
+#include "textureUtils.h"
 
 #include <QSGNode>
 
@@ -55,6 +58,7 @@ Tile::Tile(const uint id, const QRect& rect, const TextureType type)
     : _tileId(id)
     , _type(type)
     , _nextCoord(rect)
+    , _mipmapPolicy(textureUtils::getMipmapPolicy(type))
 {
     setFlag(ItemHasContents, true);
     setVisible(false);
@@ -121,6 +125,27 @@ void Tile::setSizePolicy(const SizePolicy policy)
     _policy = policy;
 }
 
+ImagePtr Tile::stage(ImagePtr image) const
+{
+    std::shared_ptr<PboRing> pboRing;
+    {
+        QMutexLocker lock(&_pboRingMutex);
+        pboRing = _pboRing;
+    }
+    return pboRing ? pboRing->stage(image) : image;
+}
+
+void Tile::setMipmapPolicy(const MipmapPolicy policy)
+{
+    _mipmapPolicy = policy;
+    QQuickItem::update();
+}
+
+size_t Tile::takeSkippedMipmapTexels()
+{
+    return _skippedMipmapTexels.exchange(0);
+}
+
 void Tile::swapImage()
 {
     _textureSwitcher.requestSwap();
@@ -142,11 +167,27 @@ QSGNode* Tile::updatePaintNode(QSGNode* node, QQuickItem::UpdatePaintNodeData*)
     auto textureNode =
         std::unique_ptr<TextureNode>(dynamic_cast<TextureNode*>(node));
 
-    TextureNodeFactoryImpl factory{*window(), _type};
+    auto wallWindow = qobject_cast<WallWindow*>(window());
+    auto pboRing = wallWindow ? wallWindow->getPboRing() : nullptr;
+    if (pboRing != _pboRing)
+    {
+        QMutexLocker lock(&_pboRingMutex);
+        _pboRing = pboRing;
+    }
+
+    const auto mipmaps =
+        textureUtils::needMipmaps(_mipmapPolicy, _getDisplayScale());
+    if (textureNode)
+        textureNode->setMipmaps(mipmaps);
+
+    TextureNodeFactoryImpl factory{*window(), _type, _pboRing.get()};
     _textureSwitcher.update(textureNode, factory);
     if (!textureNode)
         return nullptr;
 
+    textureNode->setMipmaps(mipmaps); // in case it was just created
+    _skippedMipmapTexels += textureNode->takeSkippedMipmapTexels();
+
     textureNode->setCoord(boundingRect());
 
     _textureSwitcher.updateBorderNode(*textureNode);
@@ -154,6 +195,17 @@ QSGNode* Tile::updatePaintNode(QSGNode* node, QQuickItem::UpdatePaintNodeData*)
     return dynamic_cast<QSGNode*>(textureNode.release());
 }
 
+qreal Tile::_getDisplayScale() const
+{
+    if (_nextCoord.isEmpty())
+        return 1.0;
+
+    // The nominal tile size is the size of its texture
+    const auto displaySize = mapRectToScene(boundingRect()).size();
+    return std::min(displaySize.width() / _nextCoord.width(),
+                    displaySize.height() / _nextCoord.height());
+}
+
 void Tile::_onParentChanged(QQuickItem* newParent)
 {
     if (!newParent)
@@ -44,8 +44,10 @@
 
 #include "TextureBorderSwitcher.h"
 
+#include <QMutex>
 #include <QQuickItem> // parent
-#include <memory>     // std::enable_shared_from_this
+#include <atomic>
+#include <memory> // std::enable_shared_from_this
 
 /**
  * Qml item to render an image tile with texture double-buffering.
@@ -93,6 +95,30 @@ public:
      */
     void setSizePolicy(SizePolicy policy);
 
+    /**
+     * Stage an image for upload in the PBO ring of the tile's window.
+     *
+     * Thread-safe, meant to be called by the thread which produced the image
+     * so that the render thread does not have to copy it.
+     * @param image the image to stage.
+     * @return the staged image, or the original image if the tile has not
+     *         been rendered yet or the window's ring is full.
+     */
+    ImagePtr stage(ImagePtr image) const;
+
+    /**
+     * Set the mipmap policy, which defaults to the one of the texture type.
+     * @param policy the new policy, applied on the next rendered frame.
+     */
+    void setMipmapPolicy(MipmapPolicy policy);
+
+    /**
+     * Thread-safe.
+     * @return the number of texels updated without generating mipmaps since
+     *         the previous call.
+     */
+    size_t takeSkippedMipmapTexels();
+
 public slots:
     /** Upload the given image to the back texture. */
     void updateBackTexture(ImagePtr image);
@@ -127,11 +153,18 @@ private:
     QRect _nextCoord;
     TextureBorderSwitcher _textureSwitcher;
 
+    std::shared_ptr<PboRing> _pboRing;
+    mutable QMutex _pboRingMutex;
+
+    MipmapPolicy _mipmapPolicy = MipmapPolicy::always;
+    std::atomic<size_t> _skippedMipmapTexels{0};
+
     Tile(uint id, const QRect& rect, TextureType type);
 
     /** Called on the render thread to update the scene graph. */
     QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*) final;
     void _onParentChanged(QQuickItem* newParent);
+    qreal _getDisplayScale() const;
 
     QMetaObject::Connection _widthConn;
     QMetaObject::Connection _heightConn;
@@ -0,0 +1,235 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "TileCache.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+size_t _getSize(const QImage& image)
+{
+    return size_t(image.bytesPerLine()) * size_t(image.height());
+}
+}
+
+TileCache::TileCache(const size_t maxSize)
+    : _maxSize{maxSize}
+{
+}
+
+void TileCache::setMaxSize(const size_t maxSize)
+{
+    const QMutexLocker lock(&_mutex);
+    _maxSize = maxSize;
+    _evict(nullptr);
+}
+
+size_t TileCache::getMaxSize() const
+{
+    const QMutexLocker lock(&_mutex);
+    return _maxSize;
+}
+
+size_t TileCache::getSize() const
+{
+    const QMutexLocker lock(&_mutex);
+    return _size;
+}
+
+size_t TileCache::getTilesCount() const
+{
+    const QMutexLocker lock(&_mutex);
+    return _entries.size();
+}
+
+size_t TileCache::getHits() const
+{
+    const QMutexLocker lock(&_mutex);
+    return _hits;
+}
+
+size_t TileCache::getMisses() const
+{
+    const QMutexLocker lock(&_mutex);
+    return _misses;
+}
+
+size_t TileCache::getEvictions() const
+{
+    const QMutexLocker lock(&_mutex);
+    return _evictions;
+}
+
+QImage TileCache::get(const SourceId source, const uint tileId)
+{
+    const QMutexLocker lock(&_mutex);
+
+    const auto it = _entries.find(Key{source, tileId});
+    if (it == _entries.end())
+    {
+        ++_misses;
+        return QImage();
+    }
+    ++_hits;
+    _lru.splice(_lru.begin(), _lru, it->second.lru);
+    return it->second.image;
+}
+
+bool TileCache::contains(const SourceId source, const uint tileId) const
+{
+    const QMutexLocker lock(&_mutex);
+    return _entries.count(Key{source, tileId});
+}
+
+void TileCache::insert(const SourceId source, const uint tileId,
+                       const uint lod, const QImage& image)
+{
+    const auto size = _getSize(image);
+
+    const QMutexLocker lock(&_mutex);
+
+    if (size > _maxSize)
+        return;
+
+    const auto key = Key{source, tileId};
+    auto it = _entries.find(key);
+    if (it == _entries.end())
+    {
+        _lru.push_front(key);
+        _entries.emplace(key, Entry{image, lod, _lru.begin()});
+    }
+    else
+    {
+        _size -= _getSize(it->second.image);
+        it->second.image = image;
+        it->second.lod = lod;
+        _lru.splice(_lru.begin(), _lru, it->second.lru);
+    }
+    _size += size;
+
+    _evict(&key);
+}
+
+void TileCache::setVisibleTiles(const SourceId source, const Indices& tiles,
+                                const std::set<uint>& lods)
+{
+    const QMutexLocker lock(&_mutex);
+    if (tiles.empty())
+        _visibility.erase(source);
+    else
+        _visibility[source] = Visibility{tiles, lods};
+}
+
+void TileCache::remove(const SourceId source)
+{
+    const QMutexLocker lock(&_mutex);
+
+    _visibility.erase(source);
+
+    const auto begin = _entries.lower_bound(Key{source, 0});
+    auto end = begin;
+    while (end != _entries.end() && end->first.first == source)
+    {
+        _size -= _getSize(end->second.image);
+        _lru.erase(end->second.lru);
+        ++end;
+    }
+    _entries.erase(begin, end);
+}
+
+bool TileCache::_isVisible(const Key& key) const
+{
+    const auto it = _visibility.find(key.first);
+    return it != _visibility.end() && it->second.tiles.count(key.second);
+}
+
+uint TileCache::_getLodDistance(const Key& key, const Entry& entry) const
+{
+    const auto it = _visibility.find(key.first);
+    if (it == _visibility.end() || it->second.lods.empty())
+        return std::numeric_limits<uint>::max();
+
+    uint distance = std::numeric_limits<uint>::max();
+    for (auto lod : it->second.lods)
+    {
+        const auto diff = lod > entry.lod ? lod - entry.lod : entry.lod - lod;
+        distance = std::min(distance, diff);
+    }
+    return distance;
+}
+
+void TileCache::_evict(const Key* keep)
+{
+    // Walk from the least recently used tile, first evicting the tiles at the
+    // furthest distance from the visible LODs, then at the next one, etc.
+    auto maxDistance = std::numeric_limits<uint>::max();
+    while (_size > _maxSize)
+    {
+        bool hasCandidates = false;
+        uint nextMaxDistance = 0;
+
+        auto lru = _lru.end();
+        while (lru != _lru.begin() && _size > _maxSize)
+        {
+            --lru;
+            const auto& key = *lru;
+            if ((keep && key == *keep) || _isVisible(key))
+                continue;
+
+            const auto it = _entries.find(key);
+            const auto distance = _getLodDistance(key, it->second);
+            if (distance < maxDistance)
+            {
+                hasCandidates = true;
+                nextMaxDistance = std::max(nextMaxDistance, distance);
+                continue;
+            }
+            _size -= _getSize(it->second.image);
+            _entries.erase(it);
+            lru = _lru.erase(lru);
+            ++_evictions;
+        }
+        if (!hasCandidates)
+            return;
+        maxDistance = nextMaxDistance;
+    }
+}
@@ -0,0 +1,160 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include "types.h"
+
+#include <QImage>
+#include <QMutex>
+
+#include <list>
+#include <map>
+
+/**
+ * A memory-bounded cache of tile images shared by multiple data sources.
+ *
+ * When the cache exceeds its maximum size, tiles are evicted in the
+ * following order:
+ * - tiles of sources which currently have no visible tiles;
+ * - tiles at the LODs furthest away from the visible ones;
+ * - least recently used tiles.
+ * Visible tiles are never evicted, the cache may temporarily exceed its size
+ * if they do not fit.
+ *
+ * This class is threadsafe.
+ */
+class TileCache
+{
+public:
+    /** Identifier of the data source owning the tiles. */
+    using SourceId = const void*;
+
+    /**
+     * Constructor.
+     * @param maxSize the maximum size of the cached images in bytes
+     */
+    explicit TileCache(size_t maxSize);
+
+    /** Set the maximum size in bytes, evicting tiles if needed. */
+    void setMaxSize(size_t maxSize);
+
+    /** @return the maximum size in bytes. */
+    size_t getMaxSize() const;
+
+    /** @return the current size of the cached images in bytes. */
+    size_t getSize() const;
+
+    /** @return the number of cached tiles. */
+    size_t getTilesCount() const;
+
+    /** @return the number of get() which found a tile. */
+    size_t getHits() const;
+
+    /** @return the number of get() which did not find a tile. */
+    size_t getMisses() const;
+
+    /** @return the number of tiles evicted to respect the maximum size. */
+    size_t getEvictions() const;
+
+    /**
+     * Get a tile image, marking it as recently used.
+     * @return the image, or a null image if it is not in the cache
+     */
+    QImage get(SourceId source, uint tileId);
+
+    /** Check if a tile is in the cache, without affecting the statistics. */
+    bool contains(SourceId source, uint tileId) const;
+
+    /**
+     * Add a tile image to the cache.
+     *
+     * Images larger than the maximum size of the cache are not stored.
+     * @param source the data source owning the tile
+     * @param tileId the identifier of the tile in the source
+     * @param lod the level of detail of the tile
+     * @param image the image to store
+     */
+    void insert(SourceId source, uint tileId, uint lod, const QImage& image);
+
+    /**
+     * Set the tiles of a source which are currently visible.
+     * @param source the data source owning the tiles
+     * @param tiles the visible tiles, which are protected from eviction
+     * @param lods the levels of detail of the visible tiles
+     */
+    void setVisibleTiles(SourceId source, const Indices& tiles,
+                         const std::set<uint>& lods);
+
+    /** Remove all the tiles of a source. */
+    void remove(SourceId source);
+
+private:
+    using Key = std::pair<SourceId, uint>;
+    struct Entry
+    {
+        QImage image;
+        uint lod;
+        std::list<Key>::iterator lru;
+    };
+    struct Visibility
+    {
+        Indices tiles;
+        std::set<uint> lods;
+    };
+
+    mutable QMutex _mutex;
+    std::map<Key, Entry> _entries;
+    std::list<Key> _lru; // most recently used first
+    std::map<SourceId, Visibility> _visibility;
+
+    size_t _maxSize = 0;
+    size_t _size = 0;
+    size_t _hits = 0;
+    size_t _misses = 0;
+    size_t _evictions = 0;
+
+    bool _isVisible(const Key& key) const;
+    uint _getLodDistance(const Key& key, const Entry& entry) const;
+    void _evict(const Key* keep);
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "TileGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+TileGrid::TileGrid(std::vector<QRect> tiles)
+    : _tiles(std::move(tiles))
+{
+    for (const auto& tile : _tiles)
+    {
+        _bounds |= tile;
+        _cellSize = _cellSize.expandedTo(tile.size());
+    }
+    if (_bounds.isEmpty())
+        return;
+
+    _columns = std::ceil(_bounds.width() / double(_cellSize.width()));
+    _rows = std::ceil(_bounds.height() / double(_cellSize.height()));
+    _cells.resize(_columns * _rows);
+
+    for (uint i = 0; i < _tiles.size(); ++i)
+    {
+        if (_tiles[i].isEmpty())
+            continue;
+
+        const auto range = _getCellRange(_tiles[i]);
+        for (int y = range.top(); y <= range.bottom(); ++y)
+            for (int x = range.left(); x <= range.right(); ++x)
+                _cells[y * _columns + x].push_back(i);
+    }
+}
+
+const std::vector<QRect>& TileGrid::getTiles() const
+{
+    return _tiles;
+}
+
+Indices TileGrid::computeVisibleSet(const QRectF& area) const
+{
+    Indices visibleSet;
+    const auto visibleArea = area.intersected(_bounds);
+    if (visibleArea.isEmpty())
+        return visibleSet;
+
+    const auto range = _getCellRange(visibleArea);
+    for (int y = range.top(); y <= range.bottom(); ++y)
+    {
+        for (int x = range.left(); x <= range.right(); ++x)
+        {
+            // Tiles spanning several cells are tested more than once
+            for (auto i : _cells[y * _columns + x])
+            {
+                if (visibleArea.intersects(_tiles[i]))
+                    visibleSet.insert(i);
+            }
+        }
+    }
+    return visibleSet;
+}
+
+QRect TileGrid::_getCellRange(const QRectF& area) const
+{
+    const auto x = (area.left() - _bounds.left()) / _cellSize.width();
+    const auto y = (area.top() - _bounds.top()) / _cellSize.height();
+    const auto r = (area.right() - _bounds.left()) / _cellSize.width();
+    const auto b = (area.bottom() - _bounds.top()) / _cellSize.height();
+
+    // Exclusive right and bottom edges
+    const int left = std::max(int(std::floor(x)), 0);
+    const int top = std::max(int(std::floor(y)), 0);
+    const int right = std::min(int(std::ceil(r)) - 1, _columns - 1);
+    const int bottom = std::min(int(std::ceil(b)) - 1, _rows - 1);
+    return QRect(QPoint(left, top), QPoint(right, bottom));
+}
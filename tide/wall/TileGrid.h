@@ -1,6 +1,6 @@
 /*********************************************************************/
-/* Copyright (c) 2015-2017, EPFL/Blue Brain Project                  */
-/*                          Raphael Dumusc <raphael.dumusc@epfl.ch>  */
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
 /* All rights reserved.                                              */
 /*                                                                   */
 /* Redistribution and use in source and binary forms, with or        */
@@ -37,58 +37,48 @@
 /* or implied, of Ecole polytechnique federale de Lausanne.          */
 /*********************************************************************/
 
-#ifndef BASICSYNCHRONIZER_H
-#define BASICSYNCHRONIZER_H
 
-#include "ContentSynchronizer.h"
+#ifndef TILEGRID_H
+#define TILEGRID_H
+
+#include "types.h"
+
+#include <QRect>
+
+#include <vector>
 
 /**
- * A basic synchronizer used for static content types.
+ * Uniform grid index of tile rectangles for fast visible set queries.
+ *
+ * The tiles are binned in cells the size of the largest tile, so that looking
+ * up the tiles intersecting an area only visits the cells it covers. Building
+ * the index is linear in the number of tiles, it should be kept for as long as
+ * the layout of the tiles does not change.
  */
-class BasicSynchronizer : public ContentSynchronizer
+class TileGrid
 {
-    Q_OBJECT
-    Q_DISABLE_COPY(BasicSynchronizer)
-
 public:
-    /** Constructor */
-    BasicSynchronizer(std::shared_ptr<DataSource> source);
-
-    /** @copydoc ContentSynchronizer::update */
-    void update(const ContentWindow& window,
-                const QRectF& visibleArea) override;
-
-    /** @copydoc ContentSynchronizer::updateTiles */
-    void updateTiles() override;
+    /**
+     * Build the index.
+     * @param tiles the rectangles of the tiles, indexed by their position.
+     */
+    explicit TileGrid(std::vector<QRect> tiles);
 
-    /** @copydoc ContentSynchronizer::canSwapTiles */
-    bool canSwapTiles() const override;
+    /** @return the rectangles of the indexed tiles. */
+    const std::vector<QRect>& getTiles() const;
 
-    /** @copydoc ContentSynchronizer::swapTiles */
-    void swapTiles() override;
-
-    /** @copydoc ContentSynchronizer::getTilesArea */
-    QSize getTilesArea() const override;
-
-    /** @copydoc ContentSynchronizer::getStatistics */
-    QString getStatistics() const override;
-
-    /** @copydoc ContentSynchronizer::onSwapReady */
-    void onSwapReady(TilePtr tile) override;
-
-    /** @copydoc ContentSynchronizer::getZoomContextTile */
-    TilePtr getZoomContextTile() const override;
+    /** @return the indices of the tiles which intersect the given area. */
+    Indices computeVisibleSet(const QRectF& area) const;
 
 private:
-    std::shared_ptr<DataSource> _dataSource;
-    bool _tileAdded = false;
-    bool _addTile = false;
-
-    /** @copydoc ContentSynchronizer::getDataSource */
-    const DataSource& getDataSource() const final;
-
-    /** Create this content's unique tile. */
-    void _createTile();
+    std::vector<QRect> _tiles;
+    QRect _bounds;
+    QSize _cellSize;
+    int _columns = 0;
+    int _rows = 0;
+    std::vector<std::vector<uint>> _cells;
+
+    QRect _getCellRange(const QRectF& area) const;
 };
 
 #endif
@@ -0,0 +1,210 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#include "TileLoader.h"
+
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace
+{
+template <typename Request>
+bool _isExpired(const Request& request)
+{
+    return std::all_of(request.tiles.begin(), request.tiles.end(),
+                       [](const TileLoader::TileUpdateInfo& info) {
+                           return info.first.expired();
+                       });
+}
+
+template <typename Request>
+bool _isBefore(const Request& a, const Request& b)
+{
+    if (a.priority.dynamic != b.priority.dynamic)
+        return a.priority.dynamic;
+    if (a.priority.visible != b.priority.visible)
+        return a.priority.visible;
+    // Low resolution tiles are faster to load and cover a larger area
+    if (a.priority.lod != b.priority.lod)
+        return a.priority.lod > b.priority.lod;
+    return a.sequence < b.sequence;
+}
+}
+
+TileLoader::TileLoader(LoadFunc load, const int maxThreads,
+                       const size_t maxLoadsPerSource)
+    : _load{std::move(load)}
+    , _maxLoadsPerSource{std::max(maxLoadsPerSource, size_t(1))}
+{
+    _threadPool.setMaxThreadCount(std::max(maxThreads, 1));
+}
+
+TileLoader::~TileLoader()
+{
+    {
+        const QMutexLocker lock(&_mutex);
+        _stopping = true;
+        _queue.clear();
+    }
+    _threadPool.waitForDone();
+}
+
+void TileLoader::request(DataSourcePtr source, const uint tileId,
+                         TileUpdateList tiles, const Priority& priority)
+{
+    const QMutexLocker lock(&_mutex);
+    if (_stopping)
+        return;
+
+    const auto key = Key{source.get(), tileId};
+    auto it = _queue.find(key);
+    if (it != _queue.end())
+    {
+        auto& request = it->second;
+        request.tiles.insert(request.tiles.end(), tiles.begin(), tiles.end());
+        request.priority.dynamic |= priority.dynamic;
+        request.priority.visible |= priority.visible;
+        ++_stats.merged;
+    }
+    else
+    {
+        Request request;
+        request.source = std::move(source);
+        request.tiles = std::move(tiles);
+        request.priority = priority;
+        request.sequence = _sequence++;
+        request.queueTime = FrameTracer::clock::now();
+        _queue.emplace(key, std::move(request));
+    }
+    _dispatch();
+}
+
+void TileLoader::cancelExpired()
+{
+    const QMutexLocker lock(&_mutex);
+    auto it = _queue.begin();
+    while (it != _queue.end())
+    {
+        if (_isExpired(it->second))
+        {
+            it = _queue.erase(it);
+            ++_stats.cancelled;
+        }
+        else
+            ++it;
+    }
+}
+
+TileLoader::Statistics TileLoader::takeStatistics()
+{
+    const QMutexLocker lock(&_mutex);
+    auto stats = _stats;
+    stats.queued = _queue.size();
+    stats.running = _runningCount;
+    if (stats.started > 0)
+        stats.averageWaitMs = _totalWaitMs / stats.started;
+
+    _stats = Statistics();
+    _totalWaitMs = 0.0;
+    return stats;
+}
+
+void TileLoader::_dispatch()
+{
+    const auto maxThreads = size_t(_threadPool.maxThreadCount());
+    while (!_stopping && _runningCount < maxThreads)
+    {
+        // The bound applies only if another source has a request to start
+        auto next = _queue.end();
+        auto nextBusy = _queue.end();
+        auto it = _queue.begin();
+        while (it != _queue.end())
+        {
+            if (_isExpired(it->second))
+            {
+                it = _queue.erase(it);
+                ++_stats.cancelled;
+                continue;
+            }
+            const auto running = _running.find(it->first.first);
+            const bool sourceIsBusy = running != _running.end() &&
+                                      running->second >= _maxLoadsPerSource;
+            auto& best = sourceIsBusy ? nextBusy : next;
+            if (best == _queue.end() || _isBefore(it->second, best->second))
+                best = it;
+            ++it;
+        }
+        if (next == _queue.end())
+            next = nextBusy;
+        if (next == _queue.end())
+            return;
+
+        const auto key = next->first;
+        const auto request = std::move(next->second);
+        _queue.erase(next);
+
+        const auto now = FrameTracer::clock::now();
+        FrameTracer::instance().record(TraceStage::tileWait, request.queueTime,
+                                       now);
+        const auto waitMs =
+            std::chrono::duration<double, std::milli>(now - request.queueTime)
+                .count();
+        _totalWaitMs += waitMs;
+        _stats.maxWaitMs = std::max(_stats.maxWaitMs, waitMs);
+        ++_stats.started;
+
+        ++_running[key.first];
+        ++_runningCount;
+        QtConcurrent::run(&_threadPool,
+                          [this, key, request] { _run(key, request); });
+    }
+}
+
+void TileLoader::_run(const Key key, Request request)
+{
+    _load(*request.source, key.second, request.tiles);
+
+    const QMutexLocker lock(&_mutex);
+    if (--_running[key.first] == 0)
+        _running.erase(key.first);
+    --_runningCount;
+    _dispatch();
+}
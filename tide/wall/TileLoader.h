@@ -0,0 +1,155 @@
+/*********************************************************************/
+/* Copyright (c) 2017, EPFL/Blue Brain Project                       */
+/*                     Raphael Dumusc <raphael.dumusc@epfl.ch>       */
+/* All rights reserved.                                              */
+/*                                                                   */
+/* Redistribution and use in source and binary forms, with or        */
+/* without modification, are permitted provided that the following   */
+/* conditions are met:                                               */
+/*                                                                   */
+/*   1. Redistributions of source code must retain the above         */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer.                                                  */
+/*                                                                   */
+/*   2. Redistributions in binary form must reproduce the above      */
+/*      copyright notice, this list of conditions and the following  */
+/*      disclaimer in the documentation and/or other materials       */
+/*      provided with the distribution.                              */
+/*                                                                   */
+/*    THIS  SOFTWARE IS PROVIDED  BY THE  UNIVERSITY OF  TEXAS AT    */
+/*    AUSTIN  ``AS IS''  AND ANY  EXPRESS OR  IMPLIED WARRANTIES,    */
+/*    INCLUDING, BUT  NOT LIMITED  TO, THE IMPLIED  WARRANTIES OF    */
+/*    MERCHANTABILITY  AND FITNESS FOR  A PARTICULAR  PURPOSE ARE    */
+/*    DISCLAIMED.  IN  NO EVENT SHALL THE UNIVERSITY  OF TEXAS AT    */
+/*    AUSTIN OR CONTRIBUTORS BE  LIABLE FOR ANY DIRECT, INDIRECT,    */
+/*    INCIDENTAL,  SPECIAL, EXEMPLARY,  OR  CONSEQUENTIAL DAMAGES    */
+/*    (INCLUDING, BUT  NOT LIMITED TO,  PROCUREMENT OF SUBSTITUTE    */
+/*    GOODS  OR  SERVICES; LOSS  OF  USE,  DATA,  OR PROFITS;  OR    */
+/*    BUSINESS INTERRUPTION) HOWEVER CAUSED  AND ON ANY THEORY OF    */
+/*    LIABILITY, WHETHER  IN CONTRACT, STRICT  LIABILITY, OR TORT    */
+/*    (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY OUT    */
+/*    OF  THE  USE OF  THIS  SOFTWARE,  EVEN  IF ADVISED  OF  THE    */
+/*    POSSIBILITY OF SUCH DAMAGE.                                    */
+/*                                                                   */
+/* The views and conclusions contained in the software and           */
+/* documentation are those of the authors and should not be          */
+/* interpreted as representing official policies, either expressed   */
+/* or implied, of Ecole polytechnique federale de Lausanne.          */
+/*********************************************************************/
+
+
+#ifndef TILELOADER_H
+#define TILELOADER_H
+
+#include "FrameTracer.h"
+#include "types.h"
+
+#include <QMutex>
+#include <QThreadPool>
+
+#include <functional>
+#include <map>
+
+/**
+ * Load tile images on a dedicated thread pool.
+ *
+ * Requests for the same tile of a data source are merged as long as they have
+ * not started, and requests whose tiles have all been destroyed (because they
+ * left the visible set) are cancelled. Queued requests are started in order of
+ * priority. While other data sources have queued requests, the number of
+ * concurrent loads per data source is bounded so that a large static content
+ * can not starve the movies and streams; a data source alone in the queue can
+ * use all the threads.
+ *
+ * The time spent by each request in the queue is recorded by the FrameTracer.
+ *
+ * This class is threadsafe.
+ */
+class TileLoader
+{
+public:
+    using TileUpdateInfo = std::pair<TileWeakPtr, deflect::View>;
+    using TileUpdateList = std::vector<TileUpdateInfo>;
+    using DataSourcePtr = std::shared_ptr<DataSource>;
+
+    /** Function called on a worker thread to load the image of a tile. */
+    using LoadFunc = std::function<void(const DataSource& source, uint tileId,
+                                        const TileUpdateList& tiles)>;
+
+    /** Priority of a request, dynamic then visible then low-res first. */
+    struct Priority
+    {
+        bool dynamic = false; /**< Movie or stream frame, blocks the swap. */
+        bool visible = false; /**< Tile in the visible set of its source. */
+        uint lod = 0;         /**< Level of detail of the tile. */
+    };
+
+    /** Statistics collected since the last call to takeStatistics(). */
+    struct Statistics
+    {
+        size_t queued = 0;    /**< Requests currently waiting. */
+        size_t running = 0;   /**< Requests currently loading. */
+        size_t started = 0;   /**< Requests started. */
+        size_t merged = 0;    /**< Requests merged with a queued one. */
+        size_t cancelled = 0; /**< Requests cancelled before starting. */
+        double averageWaitMs = 0.0; /**< Average time spent in the queue. */
+        double maxWaitMs = 0.0;     /**< Maximum time spent in the queue. */
+    };
+
+    /**
+     * Constructor.
+     * @param load the function to load a tile image
+     * @param maxThreads the number of threads of the pool
+     * @param maxLoadsPerSource the number of concurrent loads per data source
+     */
+    TileLoader(LoadFunc load, int maxThreads, size_t maxLoadsPerSource);
+
+    /** Destructor, cancels the queued requests and waits for running ones. */
+    ~TileLoader();
+
+    /**
+     * Request the loading of a tile image.
+     * @param source the data source of the tile
+     * @param tileId the identifier of the tile in the source
+     * @param tiles the tiles to update with the image and their views
+     * @param priority of the request
+     */
+    void request(DataSourcePtr source, uint tileId, TileUpdateList tiles,
+                 const Priority& priority);
+
+    /** Cancel the queued requests whose tiles have all been destroyed. */
+    void cancelExpired();
+
+    /** @return the statistics and reset the counters. */
+    Statistics takeStatistics();
+
+private:
+    using Key = std::pair<const DataSource*, uint>;
+    struct Request
+    {
+        DataSourcePtr source;
+        TileUpdateList tiles;
+        Priority priority;
+        uint64_t sequence;
+        FrameTracer::clock::time_point queueTime;
+    };
+
+    LoadFunc _load;
+    const size_t _maxLoadsPerSource;
+    QThreadPool _threadPool;
+
+    mutable QMutex _mutex;
+    std::map<Key, Request> _queue;
+    std::map<const DataSource*, size_t> _running;
+    size_t _runningCount = 0;
+    bool _stopping = false;
+    uint64_t _sequence = 0;
+
+    Statistics _stats;
+    double _totalWaitMs = 0.0;
+
+    void _dispatch();
+    void _run(Key key, Request request);
+};
+
+#endif
@@ -41,6 +41,8 @@
 
 #include "DataSource.h"
 #include "Tile.h"
+#include "ZoomHelper.h"
+#include "textureUtils.h"
 
 TiledSynchronizer::TiledSynchronizer(const TileSwapPolicy policy)
     : _policy(policy)
@@ -62,7 +64,18 @@ void TiledSynchronizer::onSwapReady(TilePtr tile)
 void TiledSynchronizer::updateTiles()
 {
     const auto& source = getDataSource();
-    Indices visibleSet = source.computeVisibleSet(_visibleTilesArea, _lod);
+    Indices visibleSet;
+    if (_visibleTilesRects.empty())
+        visibleSet = source.computeVisibleSet(_visibleTilesArea, _lod);
+    else
+    {
+        // Only request the tiles which are not hidden by other windows
+        for (const auto& rect : _visibleTilesRects)
+        {
+            const auto tiles = source.computeVisibleSet(rect, _lod);
+            visibleSet.insert(tiles.begin(), tiles.end());
+        }
+    }
     visibleSet = set_difference(visibleSet, _ignoreSet);
 
     const Indices addedTiles = set_difference(visibleSet, _visibleSet);
@@ -111,8 +124,13 @@ void TiledSynchronizer::swapTiles()
         emit removeTile(i);
     _removeLaterSet.clear();
 
+    // Tiles report the mipmaps skipped when rendering their previous frame
+    _skippedMipmapTexels = 0;
     for (auto& tile : _tilesReadyToSwap)
+    {
+        _skippedMipmapTexels += tile->takeSkippedMipmapTexels();
         tile->swapImage();
+    }
     _tilesReadyToSwap.clear();
     _tilesReadySet.clear();
     _syncSet.clear();
@@ -120,6 +138,51 @@ void TiledSynchronizer::swapTiles()
     _syncSwapPending = false;
 }
 
+Indices TiledSynchronizer::getVisibleTiles() const
+{
+    Indices tiles = _visibleSet;
+    tiles.insert(_ignoreSet.begin(), _ignoreSet.end());
+    return tiles;
+}
+
+QString TiledSynchronizer::getMipmapStatistics() const
+{
+    if (_skippedMipmapTexels == 0)
+        return QString();
+
+    const auto time = textureUtils::estimateMipmapTime(_skippedMipmapTexels);
+    if (time < 0)
+    {
+        const auto megaTexels = _skippedMipmapTexels / 1e6;
+        return QString(", mipmaps skipped: %1 MP").arg(megaTexels, 0, 'f', 1);
+    }
+    return QString(", mipmaps skipped: -%1 ms GPU").arg(time / 1e6, 0, 'f', 2);
+}
+
+bool TiledSynchronizer::updateVisibleTilesArea(const ContentWindow& window,
+                                               const QRegion& visibleArea,
+                                               const QSize& tilesSurface)
+{
+    const ZoomHelper helper{window};
+
+    const auto area =
+        helper.toTilesArea(visibleArea.boundingRect(), tilesSurface);
+
+    std::vector<QRectF> rects;
+    if (visibleArea.rectCount() > 1)
+    {
+        for (const auto& rect : visibleArea.rects())
+            rects.push_back(helper.toTilesArea(rect, tilesSurface));
+    }
+
+    if (area == _visibleTilesArea && rects == _visibleTilesRects)
+        return false;
+
+    _visibleTilesArea = area;
+    _visibleTilesRects = std::move(rects);
+    return true;
+}
+
 void TiledSynchronizer::_removeTile(const size_t tileIndex)
 {
     if (_policy == SwapTilesSynchronously && _syncSwapPending)
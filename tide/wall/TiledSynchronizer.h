@@ -81,13 +81,37 @@ public:
      */
     void swapTiles() override;
 
+    /** @copydoc ContentSynchronizer::getVisibleTiles */
+    Indices getVisibleTiles() const override;
+
 protected:
+    /**
+     * @return statistics about the mipmaps skipped in the last swapTiles(),
+     *         formatted for appending to getStatistics().
+     */
+    QString getMipmapStatistics() const;
+
+    /**
+     * Map the visible parts of a window to the tiles area.
+     *
+     * @param window the window displaying the content.
+     * @param visibleArea the visible parts of the window (window coordinates).
+     * @param tilesSurface the total area covered by the tiles.
+     * @return true if the visible tiles area changed.
+     */
+    bool updateVisibleTilesArea(const ContentWindow& window,
+                                const QRegion& visibleArea,
+                                const QSize& tilesSurface);
+
     /** @name Parameters for updateTile. */
     //@{
     uint _lod = 0; /**< LOD used to obtain the list of visible tiles from the
                         data source. */
     QRectF _visibleTilesArea; /**< Area used to obtain the list of visible tiles
                                    from the data source. */
+    std::vector<QRectF> _visibleTilesRects; /**< Exact visible parts of
+                                                 _visibleTilesArea, if it is
+                                                 partially occluded. */
     Indices _ignoreSet; /**< Tiles to be ignored; must be managed manually. */
     bool _updateExistingTiles = false; /**< Update texture and coordinates of
                                             tiles which are already visible. */
@@ -104,6 +128,8 @@ private:
     Indices _syncSet;
     Indices _removeLaterSet;
 
+    size_t _skippedMipmapTexels = 0;
+
     void _removeTile(size_t tileIndex);
 };
 
@@ -42,84 +42,214 @@
 #include "scene/ContentWindow.h"
 #include "scene/DisplayGroup.h"
 
-VisibilityHelper::VisibilityHelper(const DisplayGroup& displayGroup,
-                                   const QRect& visibleArea)
-    : _displayGroup(displayGroup)
-    , _visibleArea(visibleArea)
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Window title, borders and side controls are drawn around the windows
+// (see style.js)
+const qreal decorationsMargin = 400.0;
+
+// Size of the cells of the grid used to find the occluders of a window
+const int occluderCellSize = 1024;
+
+// Visible areas are rounded outwards and occluders inwards, so that no visible
+// pixel is ever considered hidden.
+QRect _outerRect(const QRectF& rect)
 {
+    return rect.toAlignedRect();
 }
 
-QRectF _cutOverlap(const QRectF& window, const QRectF& other)
+QRect _innerRect(const QRectF& rect)
 {
-    if (other.contains(window))
-        return QRectF();
+    const int left = std::ceil(rect.left());
+    const int top = std::ceil(rect.top());
+    const int right = std::floor(rect.right());
+    const int bottom = std::floor(rect.bottom());
+    return QRect(QPoint(left, top), QSize(right - left, bottom - top));
+}
 
-    const QRectF overlap = window.intersected(other);
-    if (overlap.isEmpty())
-        return window;
+QRectF _globalToWindowCoordinates(const QRectF& area, const QRectF& window)
+{
+    return area.translated(-window.x(), -window.y());
+}
 
-    // Full horizontal cut
-    if (overlap.width() >= window.width())
+QPoint _windowOrigin(const QRectF& window)
+{
+    return QPoint(std::floor(window.x()), std::floor(window.y()));
+}
+
+/**
+ * Occluding rectangles indexed by the cells of a regular grid, so that each
+ * window is only cut by the occluders near it.
+ */
+class OccluderGrid
+{
+public:
+    explicit OccluderGrid(const QRect& area)
+        : _area(area)
+        , _columns(_getCellCount(area.width()))
+        , _cells(size_t(_columns * _getCellCount(area.height())))
+    {
+    }
+
+    void add(const QRect& rect)
     {
-        QRectF area(window);
-        if (overlap.top() <= window.top())
-            area.setTop(overlap.bottom());
-        else if (overlap.bottom() >= window.bottom())
-            area.setBottom(overlap.top());
-        return area;
+        const auto index = _rects.size();
+        _rects.push_back(rect);
+        _forEachCell(rect, [this, index](const size_t cell) {
+            _cells[cell].push_back(index);
+        });
     }
 
-    // Full vertical cut
-    if (overlap.height() >= window.height())
+    QRegion getOverlapping(const QRect& rect) const
     {
-        QRectF area(window);
-        if (overlap.left() <= window.left())
-            area.setLeft(overlap.right());
-        else if (overlap.right() >= window.right())
-            area.setRight(overlap.left());
-        return area;
+        std::set<size_t> indices;
+        _forEachCell(rect, [this, &indices](const size_t cell) {
+            indices.insert(_cells[cell].begin(), _cells[cell].end());
+        });
+
+        QRegion region;
+        for (const auto index : indices)
+        {
+            if (_rects[index].intersects(rect))
+                region += _rects[index] & rect;
+        }
+        return region;
     }
 
-    return window;
+private:
+    const QRect _area;
+    const int _columns;
+    std::vector<std::vector<size_t>> _cells;
+    std::vector<QRect> _rects;
+
+    static int _getCellCount(const int size)
+    {
+        return std::max(1, (size + occluderCellSize - 1) / occluderCellSize);
+    }
+
+    template <typename Func>
+    void _forEachCell(const QRect& rect, Func func) const
+    {
+        const auto r = rect & _area;
+        if (r.isEmpty())
+            return;
+
+        const auto x0 = (r.left() - _area.left()) / occluderCellSize;
+        const auto x1 = (r.right() - _area.left()) / occluderCellSize;
+        const auto y0 = (r.top() - _area.top()) / occluderCellSize;
+        const auto y1 = (r.bottom() - _area.top()) / occluderCellSize;
+        for (auto y = y0; y <= y1; ++y)
+            for (auto x = x0; x <= x1; ++x)
+                func(size_t(y * _columns + x));
+    }
+};
 }
 
-QRectF _globalToWindowCoordinates(const QRectF& area, const QRectF& window)
+VisibilityHelper::VisibilityHelper(const DisplayGroup& displayGroup,
+                                   const QRect& visibleArea)
+    : _displayGroup(displayGroup)
+    , _visibleArea(visibleArea)
 {
-    return area.translated(-window.x(), -window.y());
+    _computeVisibleRegions();
 }
 
 QRectF VisibilityHelper::getVisibleArea(const ContentWindow& window) const
 {
     const QRectF& windowCoords = window.getDisplayCoordinates();
 
-    QRectF area = windowCoords.intersected(_visibleArea);
+    const auto region = _getGlobalVisibleRegion(window);
+    const auto area = windowCoords.intersected(_visibleArea)
+                          .intersected(QRectF(region.boundingRect()));
     if (area.isEmpty())
         return QRectF();
 
-    if (window.isFullscreen())
-        return _globalToWindowCoordinates(area, windowCoords);
-    else if (_displayGroup.hasFullscreenWindows())
-        return QRectF();
+    return _globalToWindowCoordinates(area, windowCoords);
+}
 
-    if (window.isFocused())
-        return _globalToWindowCoordinates(area, windowCoords);
+QRegion VisibilityHelper::getVisibleRegion(const ContentWindow& window) const
+{
+    const auto origin = _windowOrigin(window.getDisplayCoordinates());
+    return _getGlobalVisibleRegion(window).translated(-origin);
+}
+
+bool VisibilityHelper::isInVisibleArea(const ContentWindow& window) const
+{
+    const auto& m = decorationsMargin;
+    const auto area = window.getCoordinates() | window.getDisplayCoordinates();
+    return area.adjusted(-m, -m, m, m).intersects(_visibleArea);
+}
+
+void VisibilityHelper::_computeVisibleRegions()
+{
+    const auto& windows = _displayGroup.getContentWindows();
 
-    bool isAbove = false;
-    for (auto win : _displayGroup.getContentWindows())
+    // Fullscreen windows hide everything else, including focused windows
+    if (_displayGroup.hasFullscreenWindows())
     {
-        if (win->getID() == window.getID() && !window.isPanel())
+        for (const auto& window : windows)
         {
-            isAbove = true;
-            continue;
+            if (window->isFullscreen())
+                _visibleRegions[window->getID()] =
+                    _getGlobalVisibleRegion(*window);
         }
-        if (win->isHidden())
+        return;
+    }
+
+    // Focused windows are never cut, but cut all the other windows
+    QRegion focused;
+    OccluderGrid above(_visibleArea);
+    for (const auto& window : windows)
+    {
+        if (!window->isFocused())
+            continue;
+        _visibleRegions[window->getID()] = _getGlobalVisibleRegion(*window);
+        if (window->isHidden())
+            continue;
+        const auto rect = _innerRect(window->getDisplayCoordinates());
+        focused += rect;
+        above.add(rect & _visibleArea);
+    }
+    focused &= _visibleArea;
+
+    // Walk the windows from the top down, collecting the occluders in a grid.
+    // Each window is then only cut by the region of the occluders that
+    // overlap it instead of by the region of all the windows above it.
+    for (auto it = windows.rbegin(); it != windows.rend(); ++it)
+    {
+        const auto& window = **it;
+        if (window.isFocused())
             continue;
-        if (isAbove || win->isFocused())
-            area = _cutOverlap(area, win->getDisplayCoordinates());
 
-        if (area.isEmpty())
-            return QRectF();
+        const auto& coords = window.getDisplayCoordinates();
+        const auto rect = _outerRect(coords.intersected(_visibleArea));
+        const auto area = QRegion(rect);
+
+        // Panels are only cut by focused windows, but they do hide the windows
+        // below them.
+        const auto occluders =
+            window.isPanel() ? focused : above.getOverlapping(rect);
+        _visibleRegions[window.getID()] = area.subtracted(occluders);
+
+        if (!window.isHidden() && !area.isEmpty())
+            above.add(_innerRect(coords) & _visibleArea);
     }
+}
 
-    return _globalToWindowCoordinates(area, windowCoords);
+QRegion VisibilityHelper::_getGlobalVisibleRegion(
+    const ContentWindow& window) const
+{
+    const auto it = _visibleRegions.find(window.getID());
+    if (it != _visibleRegions.end())
+        return it->second;
+
+    if (_displayGroup.hasFullscreenWindows() && !window.isFullscreen())
+        return QRegion();
+
+    // Windows which are not part of the group (i.e. the background) or which
+    // are not affected by occlusion.
+    const auto& coords = window.getDisplayCoordinates();
+    return QRegion(_outerRect(coords.intersected(_visibleArea)));
 }
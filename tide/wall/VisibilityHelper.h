@@ -42,8 +42,17 @@
 
 #include "types.h"
 
+#include <QRegion>
+#include <QUuid>
+
+#include <map>
+
 /**
  * Helper to determine the visible parts of windows on the wall.
+ *
+ * The occlusion of all the windows is computed once on construction, the
+ * helper is thus a snapshot of the DisplayGroup which must not be reused after
+ * the group is modified.
  */
 class VisibilityHelper
 {
@@ -51,11 +60,34 @@ public:
     VisibilityHelper(const DisplayGroup& displayGroup,
                      const QRect& visibleArea);
 
+    /**
+     * @return the bounding rectangle of the visible parts of the window, in
+     *         window coordinates. Only used by the unit tests, the renderer
+     *         uses getVisibleRegion().
+     */
     QRectF getVisibleArea(const ContentWindow& window) const;
 
+    /**
+     * @return the exact visible parts of the window, in window coordinates.
+     *         This region can be L-shaped or have holes when the window is
+     *         partially covered by smaller windows.
+     */
+    QRegion getVisibleRegion(const ContentWindow& window) const;
+
+    /**
+     * @return true if the window, its decorations or the transition between
+     *         its standard and focused / fullscreen coordinates may be drawn
+     *         in the visible area.
+     */
+    bool isInVisibleArea(const ContentWindow& window) const;
+
 private:
     const DisplayGroup& _displayGroup;
-    const QRect& _visibleArea;
+    const QRect _visibleArea;
+    std::map<QUuid, QRegion> _visibleRegions; // in global coordinates
+
+    void _computeVisibleRegions();
+    QRegion _getGlobalVisibleRegion(const ContentWindow& window) const;
 };
 
 #endif
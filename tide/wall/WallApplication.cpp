@@ -39,9 +39,12 @@
 
 #include "WallApplication.h"
 
+#include "CachedDataSource.h"
 #include "DataProvider.h"
+#include "DiskTileCache.h"
 #include "QmlTypeRegistration.h"
 #include "RenderController.h"
+#include "TileCache.h"
 #include "WallConfiguration.h"
 #include "WallWindow.h"
 #include "log.h"
@@ -55,6 +58,11 @@
 #include <QQuickRenderControl>
 #include <QThreadPool>
 
+namespace
+{
+const int TRACE_STATISTICS_INTERVAL_MS = 5000;
+}
+
 WallApplication::WallApplication(int& argc_, char** argv_,
                                  const QString& config,
                                  MPIChannelPtr worldChannel,
@@ -72,12 +80,26 @@ WallApplication::WallApplication(int& argc_, char** argv_,
     const int maxThreads = std::max(QThread::idealThreadCount() / prCount, 2);
     QThreadPool::globalInstance()->setMaxThreadCount(maxThreads);
 
+    const auto cacheSize = size_t(_config->getTileCacheSize()) * 1024 * 1024;
+    CachedDataSource::getTileCache().setMaxSize(cacheSize);
+
+    const auto diskCacheSize =
+        qint64(_config->getDiskTileCacheSize()) * 1024 * 1024;
+    DiskTileCache::setSettings({_config->getDiskTileCacheDir(), diskCacheSize});
+
     _initWallWindows();
     _initMPIConnection(worldChannel);
 }
 
 WallApplication::~WallApplication()
 {
+    // The MasterFromWallChannel stops at the quit message of the first
+    // process, the statistics of all processes must be sent before it
+    _traceStatisticsTimer.stop();
+    QMetaObject::invokeMethod(_toMasterChannel.get(), "sendTraceStatistics",
+                              Qt::BlockingQueuedConnection);
+    _wallChannel->globalBarrier();
+
     if (_wallChannel->getRank() == 0)
     {
         // Make sure the send quit happens after any pending sendRequestFrame.
@@ -139,8 +161,9 @@ void WallApplication::_initMPIConnection(MPIChannelPtr worldChannel)
             _renderController.get(),
             &RenderController::updateRequestScreenshot);
 
-    connect(_fromMasterChannel.get(), SIGNAL(received(DisplayGroupPtr)),
-            _renderController.get(), SLOT(updateDisplayGroup(DisplayGroupPtr)));
+    connect(_fromMasterChannel.get(), SIGNAL(received(DisplayGroupPatchPtr)),
+            _renderController.get(),
+            SLOT(updateDisplayGroup(DisplayGroupPatchPtr)));
 
     connect(_fromMasterChannel.get(), SIGNAL(received(OptionsPtr)),
             _renderController.get(), SLOT(updateOptions(OptionsPtr)));
@@ -171,8 +194,18 @@ void WallApplication::_initMPIConnection(MPIChannelPtr worldChannel)
         connect(_provider.get(), &DataProvider::closePixelStream,
                 _toMasterChannel.get(),
                 &WallToMasterChannel::sendPixelStreamClose);
+        // All processes receive the same updates, one request is enough
+        connect(_renderController.get(),
+                &RenderController::requestDisplayGroupSnapshot,
+                _toMasterChannel.get(),
+                &WallToMasterChannel::sendRequestDisplayGroup);
     }
 
+    // The master keeps the last statistics received from each node
+    connect(&_traceStatisticsTimer, &QTimer::timeout, _toMasterChannel.get(),
+            &WallToMasterChannel::sendTraceStatistics);
+    _traceStatisticsTimer.start(TRACE_STATISTICS_INTERVAL_MS);
+
     connect(&_mpiReceiveThread, &QThread::started, _fromMasterChannel.get(),
             &WallFromMasterChannel::processMessages);
 
@@ -44,6 +44,7 @@
 
 #include <QGuiApplication>
 #include <QThread>
+#include <QTimer>
 
 class RenderController;
 class WallFromMasterChannel;
@@ -88,6 +89,8 @@ private:
     QThread _mpiSendThread;
     QThread _mpiReceiveThread;
 
+    QTimer _traceStatisticsTimer;
+
     void _initWallWindows();
     WallWindow* _makeWindow(uint screen);
     void _initMPIConnection(MPIChannelPtr worldChannel);
@@ -39,6 +39,7 @@
 
 #include "WallConfiguration.h"
 
+#include <QStandardPaths>
 #include <QtXmlPatterns>
 #include <stdexcept>
 
@@ -92,6 +93,29 @@ void WallConfiguration::_loadWallSettings()
             "Could not determine the number of wall processes on that host");
     _processCountForHost = value;
 
+    // read tile cache size per process (optional)
+    query.setQuery("string(/configuration/setup/@tileCacheSize)");
+    if (getInt(query, value) && value > 0)
+        _tileCacheSize = value;
+
+    // read texture upload ring size per window (optional)
+    query.setQuery("string(/configuration/setup/@pboRingSize)");
+    if (getInt(query, value) && value > 0)
+        _pboRingSize = value;
+
+    // read persistent tile cache settings (optional)
+    query.setQuery("string(/configuration/tiles/@directory)");
+    if (getString(query, queryResult) && !queryResult.isEmpty())
+        _diskTileCacheDir = queryResult;
+    else
+        _diskTileCacheDir = QStandardPaths::writableLocation(
+                                QStandardPaths::GenericCacheLocation) +
+                            "/tide/tiles";
+
+    query.setQuery("string(/configuration/tiles/@maxSize)");
+    if (getInt(query, value) && value >= 0)
+        _diskTileCacheSize = value;
+
     // read stereo mode for the process (legacy)
     query.setQuery(QString("string(//process[%1]/@stereo)").arg(xpathIndex));
     if (getString(query, queryResult))
@@ -185,3 +209,23 @@ int WallConfiguration::getProcessCountForHost() const
 {
     return _processCountForHost;
 }
+
+int WallConfiguration::getTileCacheSize() const
+{
+    return _tileCacheSize;
+}
+
+int WallConfiguration::getPboRingSize() const
+{
+    return _pboRingSize;
+}
+
+const QString& WallConfiguration::getDiskTileCacheDir() const
+{
+    return _diskTileCacheDir;
+}
+
+int WallConfiguration::getDiskTileCacheSize() const
+{
+    return _diskTileCacheSize;
+}
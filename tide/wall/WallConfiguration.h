@@ -90,12 +90,31 @@ public:
     /** @return the number of wall processes running on the same host. */
     int getProcessCountForHost() const;
 
+    /** @return the maximum size of the tile cache of the process in MB. */
+    int getTileCacheSize() const;
+
+    /**
+     * @return the size of the texture upload ring of each window in MB, 0 to
+     *         size it from the screen resolution.
+     */
+    int getPboRingSize() const;
+
+    /** @return the folder of the persistent cache of image tiles. */
+    const QString& getDiskTileCacheDir() const;
+
+    /** @return the maximum size of the disk tile cache in MB, 0 if disabled. */
+    int getDiskTileCacheSize() const;
+
 private:
     const int _processIndex;
     QString _host;
     std::vector<ScreenConfiguration> _screens;
 
     int _processCountForHost = 0;
+    int _tileCacheSize = 1024;
+    int _pboRingSize = 0;
+    QString _diskTileCacheDir;
+    int _diskTileCacheSize = 8192;
 
     deflect::View _stereoMode = deflect::View::mono;
     QString _display;
@@ -41,7 +41,9 @@
 
 #include "DataProvider.h"
 #include "DisplayGroupRenderer.h"
+#include "FrameTracer.h"
 #include "InactivityTimer.h"
+#include "PboRing.h"
 #include "SwapSynchronizer.h"
 #include "TestPattern.h"
 #include "WallConfiguration.h"
@@ -58,9 +60,29 @@
 #include <QQuickRenderControl>
 #include <QThread>
 
+#include <algorithm>
+
 namespace
 {
 const QUrl QML_ROOT_COMPONENT("qrc:/qml/wall/Background.qml");
+const size_t PBO_RING_BLOCK_SIZE = 1024 * 1024;
+// Room for the RGBA frames of a few full-screen movies or streams in flight
+const size_t PBO_RING_SCREEN_FRAMES = 4;
+const qint64 UPLOAD_STATISTICS_INTERVAL_MS = 5000;
+
+uint _getPboRingBlockCount(const WallConfiguration& config,
+                           const QSize& screenSize)
+{
+    auto ringSize = size_t(config.getPboRingSize()) * 1024 * 1024;
+    if (ringSize == 0)
+    {
+        const auto frameSize = size_t(screenSize.width()) * screenSize.height();
+        ringSize = PBO_RING_SCREEN_FRAMES * frameSize * 4;
+    }
+    const auto blockCount = (ringSize + PBO_RING_BLOCK_SIZE - 1) /
+                            PBO_RING_BLOCK_SIZE;
+    return std::max(uint(blockCount), 1u);
+}
 }
 
 WallWindow::WallWindow(const WallConfiguration& config, const uint windowIndex,
@@ -79,6 +101,9 @@ WallWindow::WallWindow(const WallConfiguration& config, const uint windowIndex,
     const auto& screen = config.getScreens().at(windowIndex);
     const auto screenSize = config.getScreenRect(screen.globalIndex).size();
 
+    _pboRing = std::make_shared<PboRing>(
+        _getPboRingBlockCount(config, screenSize), PBO_RING_BLOCK_SIZE);
+
     if (auto qscreen = screens::find(screen.display))
         setScreen(qscreen);
     else if (!screen.display.isEmpty())
@@ -169,10 +194,20 @@ void WallWindow::_startQuick(const WallConfiguration& config,
     connect(_quickRenderer.get(), &deflect::qt::QuickRenderer::afterRender,
             [this, globalIndex] {
                 if (_synchronizer)
+                {
+                    const FrameTracer::Scope trace(TraceStage::swapBarrier);
                     _synchronizer->globalBarrier(*this);
+                }
+                {
+                    const FrameTracer::Scope trace(TraceStage::swapBuffers);
+                    _quickRenderer->context()->swapBuffers(this);
+                    _quickRenderer->context()->functions()->glFlush();
+                }
+
+                _pboRing->init(); // no-op after the first frame
+                _pboRing->recycle();
+                _logUploadStatistics();
 
-                _quickRenderer->context()->swapBuffers(this);
-                _quickRenderer->context()->functions()->glFlush();
                 QMetaObject::invokeMethod(_displayGroupRenderer.get(),
                                           "updateRenderedFrames",
                                           Qt::QueuedConnection);
@@ -187,12 +222,34 @@ void WallWindow::_startQuick(const WallConfiguration& config,
             [this] {
                 if (_synchronizer)
                     _synchronizer->exitBarrier(*this);
+                _pboRing->release();
             });
 
     _testPattern.reset(new TestPattern(config, _rootItem));
     _testPattern->setPosition(-screenRect.topLeft());
 }
 
+void WallWindow::_logUploadStatistics()
+{
+    if (!_uploadStatisticsTimer.isValid())
+        _uploadStatisticsTimer.start();
+
+    if (_uploadStatisticsTimer.elapsed() < UPLOAD_STATISTICS_INTERVAL_MS)
+        return;
+
+    if (_pboRing->getUploadedBytes() > 0)
+    {
+        put_flog(LOG_DEBUG,
+                 "%s: uploaded %.1f MB in %.1f ms (%lu planes from PBO ring)",
+                 _quickRendererThread->objectName().toLocal8Bit().constData(),
+                 _pboRing->getUploadedBytes() / 1e6,
+                 _pboRing->getUploadTime() / 1e6,
+                 (unsigned long)_pboRing->getStagedCount());
+    }
+    _pboRing->resetCounters();
+    _uploadStatisticsTimer.restart();
+}
+
 void WallWindow::render(const bool grab)
 {
     _grabImage = grab;
@@ -239,3 +296,8 @@ QQuickItem* WallWindow::rootObject() const
 {
     return _rootItem;
 }
+
+std::shared_ptr<PboRing> WallWindow::getPboRing() const
+{
+    return _pboRing;
+}
@@ -42,6 +42,7 @@
 
 #include "types.h"
 
+#include <QElapsedTimer>
 #include <QQuickWindow>
 
 class QQuickRenderControl;
@@ -106,6 +107,9 @@ public:
     /** @return the root object of the QML scene. */
     QQuickItem* rootObject() const;
 
+    /** @return the ring of buffers used to stage texture uploads. */
+    std::shared_ptr<PboRing> getPboRing() const;
+
 signals:
     /** Emitted after syncAndRender() has been called with grab set to true. */
     void imageGrabbed(QImage image, QPoint index);
@@ -114,6 +118,7 @@ private:
     void exposeEvent(QExposeEvent* exposeEvent) final;
 
     void _startQuick(const WallConfiguration& config, const uint windowIndex);
+    void _logUploadStatistics();
 
     DataProvider& _provider;
     std::unique_ptr<QQuickRenderControl> _renderControl;
@@ -128,6 +133,9 @@ private:
     QQuickItem* _rootItem = nullptr; // child qobject of contentItem()
     std::unique_ptr<DisplayGroupRenderer> _displayGroupRenderer;
     std::unique_ptr<TestPattern> _testPattern;
+
+    std::shared_ptr<PboRing> _pboRing;
+    QElapsedTimer _uploadStatisticsTimer;
 };
 
 #endif
@@ -39,11 +39,14 @@
 
 #include "WallFromMasterChannel.h"
 
+#include "FrameTracer.h"
 #include "InactivityTimer.h"
 #include "ScreenLock.h"
+#include "log.h"
 #include "network/MPIChannel.h"
+#include "network/frameCodec.h"
 #include "scene/ContentWindow.h"
-#include "scene/DisplayGroup.h"
+#include "scene/DisplayGroupPatch.h"
 #include "scene/Markers.h"
 #include "scene/Options.h"
 #include "serialization/utils.h"
@@ -52,6 +55,9 @@
 
 #include <QApplication>
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace
 {
 const int RANK0 = 0;
@@ -75,8 +81,13 @@ void WallFromMasterChannel::receiveMessage()
     switch (mh.type)
     {
     case MPIMessageType::DISPLAYGROUP:
-        emit received(receiveQObjectBroadcast<DisplayGroupPtr>(mh.size));
+    {
+        auto patch = std::make_shared<DisplayGroupPatch>(
+            receiveBroadcast<DisplayGroupPatch>(mh.size));
+        patch->moveToThread(QApplication::instance()->thread());
+        emit received(patch);
         break;
+    }
     case MPIMessageType::OPTIONS:
         emit received(receiveQObjectBroadcast<OptionsPtr>(mh.size));
         break;
@@ -90,15 +101,12 @@ void WallFromMasterChannel::receiveMessage()
         emit received(receiveQObjectBroadcast<InactivityTimerPtr>(mh.size));
         break;
     case MPIMessageType::PIXELSTREAM:
-#if BOOST_VERSION >= 106000
-        emit received(receiveBroadcast<deflect::FramePtr>(mh.size));
-#else
-        // WAR missing support for std::shared_ptr
-        // The copy of the Frame object is not too expensive because its
-        // Segments are QByteArray (implicitly shared).
-        emit received(std::make_shared<deflect::Frame>(
-            receiveBroadcast<deflect::Frame>(mh.size)));
-#endif
+        if (auto frame = receiveFrameBroadcast(mh.size))
+            emit received(frame);
+        break;
+    case MPIMessageType::PIXELSTREAM_PARTIAL:
+        if (auto frame = receiveFrame(mh.size, mh.type))
+            emit received(frame);
         break;
     case MPIMessageType::IMAGE:
         emit receivedScreenshotRequest();
@@ -126,6 +134,63 @@ T WallFromMasterChannel::receiveBroadcast(const size_t messageSize)
     return serialization::get<T>(_buffer);
 }
 
+deflect::FramePtr WallFromMasterChannel::receiveFrameBroadcast(
+    const size_t messageSize)
+{
+    const FrameTracer::Scope trace(TraceStage::mpiReceive);
+    _buffer.setSize(messageSize);
+    _mpiChannel->receiveBroadcast(_buffer.data(), messageSize, RANK0);
+    auto frame = decodeFrame(messageSize);
+    if (frame)
+    {
+        _mpiChannel->receiveBroadcast(frameCodec::getPayloadTarget(*frame),
+                                      RANK0);
+        return frame;
+    }
+
+    // The payload must still be received for the next broadcasts to match
+    const auto payloadSize =
+        frameCodec::getPayloadSize(_buffer.data(), messageSize);
+    _buffer.setSize(payloadSize);
+    _mpiChannel->receiveBroadcast(_buffer.data(), payloadSize, RANK0);
+    return frame;
+}
+
+deflect::FramePtr WallFromMasterChannel::receiveFrame(
+    const size_t messageSize, const MPIMessageType type)
+{
+    const FrameTracer::Scope trace(TraceStage::mpiReceive);
+    _buffer.setSize(messageSize);
+    _mpiChannel->receive(_buffer.data(), messageSize, RANK0, int(type));
+    auto frame = decodeFrame(messageSize);
+    if (frame)
+    {
+        _mpiChannel->receive(frameCodec::getPayloadTarget(*frame), RANK0,
+                             int(type));
+        return frame;
+    }
+
+    // Discard the payload, which would otherwise be taken for the next frame
+    const auto probe = _mpiChannel->probe(RANK0, int(type));
+    const auto payloadSize = size_t(std::max(probe.size, 0));
+    _buffer.setSize(payloadSize);
+    _mpiChannel->receive(_buffer.data(), payloadSize, RANK0, int(type));
+    return frame;
+}
+
+deflect::FramePtr WallFromMasterChannel::decodeFrame(const size_t messageSize)
+{
+    try
+    {
+        return frameCodec::decode(_buffer.data(), messageSize);
+    }
+    catch (const std::runtime_error& e)
+    {
+        put_flog(LOG_ERROR, "dropping pixel stream frame: %s", e.what());
+        return deflect::FramePtr();
+    }
+}
+
 template <typename T>
 T WallFromMasterChannel::receiveQObjectBroadcast(const size_t messageSize)
 {
@@ -40,6 +40,7 @@
 #ifndef WALLFROMMASTERCHANNEL_H
 #define WALLFROMMASTERCHANNEL_H
 
+#include "network/MPIHeader.h"
 #include "network/ReceiveBuffer.h"
 #include "types.h"
 
@@ -75,11 +76,11 @@ public slots:
 
 signals:
     /**
-     * Emitted when a displayGroup was recieved
+     * Emitted when a DisplayGroup update was received
      * @see receiveMessage()
-     * @param displayGroup The DisplayGroup that was received
+     * @param patch The DisplayGroupPatch that was received
      */
-    void received(DisplayGroupPtr displayGroup);
+    void received(DisplayGroupPatchPtr patch);
 
     /**
      * Emitted when new Options were recieved
@@ -136,6 +137,9 @@ private:
     T receiveBroadcast(const size_t messageSize);
     template <typename T>
     T receiveQObjectBroadcast(const size_t messageSize);
+    deflect::FramePtr receiveFrameBroadcast(size_t messageSize);
+    deflect::FramePtr receiveFrame(size_t messageSize, MPIMessageType type);
+    deflect::FramePtr decodeFrame(size_t messageSize);
 };
 
 #endif
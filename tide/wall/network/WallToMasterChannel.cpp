@@ -66,6 +66,21 @@ void WallToMasterChannel::sendPixelStreamClose(const QString uri)
     _mpiChannel->send(MPIMessageType::PIXELSTREAM_CLOSE, data, 0);
 }
 
+void WallToMasterChannel::sendRequestDisplayGroup()
+{
+    _mpiChannel->send(MPIMessageType::REQUEST_DISPLAYGROUP, "", 0);
+}
+
+void WallToMasterChannel::sendTraceStatistics()
+{
+    const auto statistics = FrameTracer::instance().getStatistics();
+    if (statistics.isEmpty())
+        return;
+
+    const auto data = serialization::toBinary(statistics);
+    _mpiChannel->send(MPIMessageType::TRACE_STATISTICS, data, 0);
+}
+
 void WallToMasterChannel::sendQuit()
 {
     _mpiChannel->send(MPIMessageType::QUIT, "", 0);
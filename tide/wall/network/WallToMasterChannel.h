@@ -41,6 +41,7 @@
 #ifndef WALLTOMASTERCHANNEL_H
 #define WALLTOMASTERCHANNEL_H
 
+#include "FrameTracer.h"
 #include "types.h"
 
 #include <QObject>
@@ -70,6 +71,12 @@ public slots:
      */
     void sendPixelStreamClose(QString uri);
 
+    /**
+     * Send a request to the master application to resend the complete
+     * DisplayGroup.
+     */
+    void sendRequestDisplayGroup();
+
     /**
      * Send a screenshot to the master application
      * @param image the rendered image
@@ -77,6 +84,12 @@ public slots:
      */
     void sendScreenshot(QImage image, QPoint index);
 
+    /**
+     * Send the recent latency statistics of the frame tracer of this process,
+     * unless it has not recorded any.
+     */
+    void sendTraceStatistics();
+
     /**
      * Send quit message to the master application to stop the receiver.
      */
@@ -39,6 +39,7 @@
 
 #include "WallToWallChannel.h"
 
+#include "FrameSync.h"
 #include "log.h"
 #include "network/MPIChannel.h"
 #include "serialization/chrono.h"
@@ -97,6 +98,13 @@ bool WallToWallChannel::checkVersion(const uint64_t version) const
     return true;
 }
 
+void WallToWallChannel::synchronize(FrameSync& frameSync) const
+{
+    frameSync.resolve([this](const std::vector<int64_t>& values) {
+        return _mpiChannel->globalMin(values);
+    });
+}
+
 int WallToWallChannel::electLeader(const bool isCandidate)
 {
     const int status = isCandidate ? (1 << getRank()) : 0;
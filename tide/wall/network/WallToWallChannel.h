@@ -87,6 +87,12 @@ public:
     /** Check that all processes have the same version of an object. */
     bool checkVersion(uint64_t version) const;
 
+    /**
+     * Resolve all the entries of a FrameSync with a single collective.
+     * @param frameSync the entries to resolve
+     */
+    void synchronize(FrameSync& frameSync) const;
+
     /**
      * Elect a leader amongst wall processes.
      * @param isCandidate Is this process a candidate.
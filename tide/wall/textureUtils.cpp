@@ -39,31 +39,65 @@
 
 #include "textureUtils.h"
 
+#include "FrameTracer.h"
 #include "data/Image.h"
 
 #include <QOpenGLBuffer>
 #include <QOpenGLContext>
 #include <QOpenGLFunctions>
+#include <QOpenGLTimerQuery>
 #include <QQuickWindow>
 #include <QSGTexture>
 
+#include <atomic>
 #include <cstring> // std::memcpy
 
+namespace
+{
+// Bilinear filtering of the base level remains acceptable down to this scale
+const qreal lazyMipmapScaleThreshold = 0.5;
+
+// Smaller textures give unreliable timer query results
+const size_t minCalibrationTexels = 512 * 512;
+
+std::atomic_flag calibrationDone = ATOMIC_FLAG_INIT;
+std::atomic<double> mipmapTimePerTexel{-1.0}; // ns
+}
+
 namespace textureUtils
 {
+void copyPixels(const Image& image, const uint srcTextureIdx, uint8_t* dest)
+{
+    const auto src = image.getData(srcTextureIdx);
+    const auto size = image.getDataSize(srcTextureIdx);
+    const auto rows = image.getTextureSize(srcTextureIdx).height();
+    const size_t lineSize = image.getLineSize(srcTextureIdx);
+    if (rows <= 0 || lineSize * rows == size)
+    {
+        std::memcpy(dest, src, size);
+        return;
+    }
+
+    const size_t rowSize = size / rows;
+    for (int row = 0; row < rows; ++row)
+        std::memcpy(dest + row * rowSize, src + row * lineSize, rowSize);
+}
+
 void upload(const Image& image, const uint srcTextureIdx, QOpenGLBuffer& pbo)
 {
+    const FrameTracer::Scope trace(TraceStage::upload);
     pbo.bind();
     const auto size = image.getDataSize(srcTextureIdx);
     if (size_t(pbo.size()) != size)
         pbo.allocate(size);
     auto pboData = pbo.map(QOpenGLBuffer::WriteOnly);
-    std::memcpy(pboData, image.getData(srcTextureIdx), size);
+    copyPixels(image, srcTextureIdx, static_cast<uint8_t*>(pboData));
     pbo.unmap();
     pbo.release();
 }
 
-void copy(QOpenGLBuffer& pbo, QSGTexture& texture, const uint glTexFormat)
+void copy(QOpenGLBuffer& pbo, QSGTexture& texture, const uint glTexFormat,
+          const size_t offset)
 {
     auto gl = QOpenGLContext::currentContext()->functions();
     const auto textureSize = texture.textureSize();
@@ -78,9 +112,61 @@ void copy(QOpenGLBuffer& pbo, QSGTexture& texture, const uint glTexFormat)
     texture.bind();
     pbo.bind();
     gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureSize.width(),
-                        textureSize.height(), glTexFormat, GL_UNSIGNED_BYTE, 0);
+                        textureSize.height(), glTexFormat, GL_UNSIGNED_BYTE,
+                        reinterpret_cast<const void*>(offset));
     pbo.release();
+}
+
+void generateMipmaps(QSGTexture& texture)
+{
+    auto gl = QOpenGLContext::currentContext()->functions();
+    texture.bind();
+
+    const auto size = texture.textureSize();
+    const size_t texels = size.width() * size.height();
+    if (texels < minCalibrationTexels || calibrationDone.test_and_set())
+    {
+        gl->glGenerateMipmap(GL_TEXTURE_2D);
+        return;
+    }
+
+    QOpenGLTimerQuery query;
+    if (!query.create())
+    {
+        gl->glGenerateMipmap(GL_TEXTURE_2D);
+        return;
+    }
+    query.begin();
     gl->glGenerateMipmap(GL_TEXTURE_2D);
+    query.end();
+    // Stalls the pipeline once per process
+    mipmapTimePerTexel = double(query.waitForResult()) / texels;
+}
+
+qint64 estimateMipmapTime(const size_t texels)
+{
+    const double timePerTexel = mipmapTimePerTexel;
+    return timePerTexel < 0.0 ? -1 : qint64(timePerTexel * texels);
+}
+
+MipmapPolicy getMipmapPolicy(const TextureType type)
+{
+    return type == TextureType::Static ? MipmapPolicy::always
+                                       : MipmapPolicy::lazy;
+}
+
+bool needMipmaps(const MipmapPolicy policy, const qreal scale)
+{
+    switch (policy)
+    {
+    case MipmapPolicy::never:
+        return false;
+    case MipmapPolicy::lazy:
+        return scale < lazyMipmapScaleThreshold;
+    case MipmapPolicy::always:
+    default:
+        return true;
+    }
 }
 
 std::unique_ptr<QSGTexture> createTexture(const QSize& size,
@@ -78,6 +78,19 @@ std::unique_ptr<QSGTexture> createTextureRgba(const QSize& size,
  */
 std::unique_ptr<QOpenGLBuffer> createPbo(bool dynamic);
 
+/**
+ * Copy the pixels of an image texture plane into a tightly packed buffer.
+ *
+ * Images whose line size is larger than their rows (regions of a larger
+ * buffer) are copied row by row. This function does not use OpenGL, so it
+ * can stage images into a mapped buffer from any thread.
+ *
+ * @param image the source image.
+ * @param srcTextureIdx the texture plane of the source image.
+ * @param dest the destination, of at least image.getDataSize(srcTextureIdx).
+ */
+void copyPixels(const Image& image, uint srcTextureIdx, uint8_t* dest);
+
 /**
  * Upload an image to a PBO.
  *
@@ -92,8 +105,40 @@ void upload(const Image& image, const uint srcTextureIdx, QOpenGLBuffer& pbo);
  *
  * @param pbo the source PBO.
  * @param texture the target texture, must be of the same size as the PBO.
+ * @param glTextFormat the GL pixel format of the PBO data.
+ * @param offset the offset of the pixel data in the PBO, in bytes.
+ */
+void copy(QOpenGLBuffer& pbo, QSGTexture& texture, uint glTextFormat,
+          size_t offset = 0);
+
+/**
+ * Generate the mipmaps of a texture.
+ *
+ * The GPU time of the first large enough generation is measured with a timer
+ * query to calibrate estimateMipmapTime().
+ * @param texture the texture, whose level 0 has been updated.
+ */
+void generateMipmaps(QSGTexture& texture);
+
+/**
+ * Estimate the GPU time needed to generate mipmaps.
+ *
+ * @param texels the number of texels of the base level(s).
+ * @return the estimated time in ns, or -1 if not calibrated yet.
+ */
+qint64 estimateMipmapTime(size_t texels);
+
+/** @return the default mipmap policy for the given type of texture. */
+MipmapPolicy getMipmapPolicy(TextureType type);
+
+/**
+ * Check if a texture needs mipmaps.
+ *
+ * @param policy the mipmap policy of the texture.
+ * @param scale the ratio between the displayed size and the texture size.
+ * @return true if mipmaps should be generated.
  */
-void copy(QOpenGLBuffer& pbo, QSGTexture& texture, uint glTextFormat);
+bool needMipmaps(MipmapPolicy policy, qreal scale);
 }
 
 #endif